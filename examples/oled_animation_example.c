@@ -0,0 +1,76 @@
+/**
+ * @file    oled_animation_example.c
+ * @author  Miaow
+ * @date    2019/08/12
+ * @note    This program plays "bad.mwa" on the SD card twice and prints
+ *          playback statistics as a benchmark:
+ *              1. As fast as possible, to measure the maximum sustained fps.
+ *              2. At the frame rate in the file, to check it can be held.
+ *          Make the file by tools/oled_animconv.c.
+ */
+
+#include "stm32f4xx.h"
+#include "utils.h"
+#include "ff.h"
+#include "oled.h"
+#include "oled_animation.h"
+
+#define STOP_IF_ERROR() if(result)\
+                        {\
+                          printf("Line%d: Error%d\r\n", __LINE__, (uint32_t)result);\
+                          while (1);\
+                        }
+
+OLED_HandleTypedef OledHandle;
+OLED_AnimationTypedef Animation;
+
+/**
+ * @brief Print sustained fps and compressed bytes per frame.
+ */
+void PrintStatistics(const char *title)
+{
+  OLED_AnimationStatisticsTypedef statistics;
+  OLED_GetAnimationStatistics(&Animation, &statistics);
+  if (statistics.frames == 0 || statistics.elapsedMs == 0)
+    return;
+  printf("%s: %d frames in %dms, %d.%02d fps, %d bytes per frame, %d late frames\r\n",
+         title, statistics.frames, statistics.elapsedMs,
+         statistics.frames * 1000 / statistics.elapsedMs,
+         statistics.frames * 100000 / statistics.elapsedMs % 100,
+         statistics.bytes / statistics.frames, statistics.lateFrames);
+}
+
+int main()
+{
+  uint8_t result = 0;
+  FATFS fs;
+  
+  UTILS_InitDelay();
+  UTILS_InitUart(115200);
+  OLED_Init(&OledHandle);
+  
+  result = f_mount(&fs, "0", 1);
+  STOP_IF_ERROR();
+  result = OLED_OpenAnimation(&Animation, "bad.mwa");
+  STOP_IF_ERROR();
+  printf("%d frames at %d fps\r\n", Animation.frameCount, Animation.fps);
+  
+  //Decode and flush as fast as possible.
+  result = OLED_StartAnimation(&Animation, OLED_ANIMATION_FPS_UNLIMITED, 0);
+  STOP_IF_ERROR();
+  while (!OLED_UpdateAnimation(&Animation));
+  PrintStatistics("Unlimited");
+  
+  //Hold the frame rate in the file.
+  result = OLED_StartAnimation(&Animation, 0, 0);
+  STOP_IF_ERROR();
+  while (!OLED_UpdateAnimation(&Animation));
+  PrintStatistics("Paced");
+  
+  OLED_CloseAnimation(&Animation);
+  f_mount(0, "", 0);
+  while (1)
+  {
+  
+  }
+}
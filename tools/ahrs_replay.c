@@ -0,0 +1,195 @@
+/**
+ * @file    ahrs_replay.c
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2019/08/30
+ * @brief
+ *          Host tool replaying a recorded IMU log through the attitude
+ *          filters of user/ahrs.c.
+ * @note
+ *          Build on PC:
+ *              gcc -O2 -DAHRS_HOST -I../user -o ahrs_replay ahrs_replay.c ../user/ahrs.c -lm
+ *
+ *          Usage:
+ *              ahrs_replay [options] [log.txt]
+ *              -m              Madgwick filter, Mahony by default.
+ *              -p kp           Proportional gain of Mahony filter.
+ *              -i ki           Integral gain of Mahony filter.
+ *              -b beta         Gain of Madgwick filter.
+ *              -n              Ignore the magnetometer columns.
+ *              -r              The last 3 columns are reference pitch, roll and yaw.
+ *              -s              Print the summary only.
+ *
+ *          One sample per line, separated by spaces or commas:
+ *              time(s) gx gy gz(dps) ax ay az [mx my mz] [pitch roll yaw(deg)]
+ *          Lines that do not start with a number are ignored. On the board,
+ *          print MPU6050_ReadFifo samples in this format, adding the DMP
+ *          output as reference when comparing against it. For MPU9250 print
+ *          the compass remapped onto the gyroscope axes, see
+ *          MPU9250_UpdateFusion.
+ *
+ *          ahrs_replay_log.txt is a short 9-axis log with a known attitude,
+ *          check a change of user/ahrs.c against it with:
+ *              ahrs_replay -r -s ahrs_replay_log.txt | diff - ahrs_replay_expected.txt
+ *          With -r, the RMS and maximum error against the reference are
+ *          reported, the first second is excluded while the filter converges.
+ *
+ *          The source code repository is available on GitHub:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "ahrs.h"
+
+#define MAX_COLUMNS     13
+#define SETTLE_TIME     1.0 //!< Seconds excluded from the error statistics.
+
+/**
+ * @brief Print usage and exit.
+ */
+static void Usage(void)
+{
+    fprintf(stderr, "usage: ahrs_replay [-m] [-p kp] [-i ki] [-b beta] [-n] [-r] [-s] [log.txt]\n");
+    exit(1);
+}
+
+/**
+ * @brief Split a line into numbers.
+ * @return Number of columns, 0 if the line does not start with a number.
+ */
+static int ParseLine(char *line, double *values)
+{
+    int count = 0;
+    char *end;
+    while (count < MAX_COLUMNS)
+    {
+        while (*line == ' ' || *line == '\t' || *line == ',')
+            line++;
+        values[count] = strtod(line, &end);
+        if (end == line)
+            break;
+        line = end;
+        count++;
+    }
+    return count;
+}
+
+/**
+ * @brief Difference of two angles wrapped to -180~180 degrees.
+ */
+static double AngleError(double a, double b)
+{
+    double e = fmod(a - b, 360.0);
+    if (e > 180.0)
+        e -= 360.0;
+    else if (e < -180.0)
+        e += 360.0;
+    return e;
+}
+
+int main(int argc, char *argv[])
+{
+    FILE *file = stdin;
+    char line[512];
+    double values[MAX_COLUMNS], previous = 0, first = 0, squareSum[3] = {0}, maxError[3] = {0}, error;
+    float gyro[3], accel[3], mag[3], angles[3], dt;
+    float kp = AHRS_MAHONY_KP, ki = AHRS_MAHONY_KI, beta = AHRS_MADGWICK_BETA;
+    int i, columns, useMag = 1, reference = 0, summaryOnly = 0, hasMag;
+    unsigned long samples = 0, compared = 0;
+    AHRS_AlgorithmTypeDef algorithm = AHRS_MAHONY;
+    AHRS_InfoTypeDef ahrs;
+
+    for (i = 1; i < argc && argv[i][0] == '-' && argv[i][1] != '\0'; i++)
+    {
+        if (strcmp(argv[i], "-m") == 0)
+            algorithm = AHRS_MADGWICK;
+        else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc)
+            kp = (float)atof(argv[++i]);
+        else if (strcmp(argv[i], "-i") == 0 && i + 1 < argc)
+            ki = (float)atof(argv[++i]);
+        else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc)
+            beta = (float)atof(argv[++i]);
+        else if (strcmp(argv[i], "-n") == 0)
+            useMag = 0;
+        else if (strcmp(argv[i], "-r") == 0)
+            reference = 1;
+        else if (strcmp(argv[i], "-s") == 0)
+            summaryOnly = 1;
+        else
+            Usage();
+    }
+    if (i + 1 < argc)
+        Usage();
+    if (i < argc && (file = fopen(argv[i], "r")) == NULL)
+    {
+        perror(argv[i]);
+        return 1;
+    }
+    AHRS_Init(&ahrs, algorithm);
+    AHRS_SetParameters(&ahrs, kp, ki, beta);
+    if (!summaryOnly)
+        printf("    time(s)   pitch(deg)    roll(deg)     yaw(deg)\n");
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        columns = ParseLine(line, values);
+        if (reference)
+            columns -= 3;
+        if (columns != 7 && columns != 10)
+            continue;
+        hasMag = useMag && columns == 10;
+        for (i = 0; i < 3; i++)
+        {
+            gyro[i] = (float)values[1 + i];
+            accel[i] = (float)values[4 + i];
+            mag[i] = (float)values[7 + i];
+        }
+        if (samples == 0)
+            first = previous = values[0];
+        //The first sample only sets the time origin.
+        dt = (float)(values[0] - previous);
+        previous = values[0];
+        if (samples > 0 && dt > 0)
+            AHRS_Update(&ahrs, gyro, accel, hasMag ? mag : NULL, dt);
+        AHRS_GetEuler(&ahrs, &angles[0], &angles[1], &angles[2]);
+        if (!summaryOnly)
+            printf("%11.4f %12.3f %12.3f %12.3f\n", values[0] - first, angles[0], angles[1], angles[2]);
+        if (reference && values[0] - first >= SETTLE_TIME)
+        {
+            for (i = 0; i < 3; i++)
+            {
+                error = fabs(AngleError(angles[i], values[columns + i]));
+                squareSum[i] += error * error;
+                if (error > maxError[i])
+                    maxError[i] = error;
+            }
+            compared++;
+        }
+        samples++;
+    }
+    if (file != stdin)
+        fclose(file);
+    if (samples < 2)
+    {
+        fprintf(stderr, "no samples found\n");
+        return 1;
+    }
+    printf("\n%s filter, %lu samples over %.3f s (%.1f Hz)\n", algorithm == AHRS_MADGWICK ? "Madgwick" : "Mahony",
+           samples, previous - first, (samples - 1) / (previous - first));
+    printf("Final pitch %.3f, roll %.3f, yaw %.3f deg\n", angles[0], angles[1], angles[2]);
+    if (reference && compared > 0)
+    {
+        printf("Error against reference over %lu samples:\n", compared);
+        printf("  pitch  RMS %.3f  max %.3f deg\n", sqrt(squareSum[0] / compared), maxError[0]);
+        printf("  roll   RMS %.3f  max %.3f deg\n", sqrt(squareSum[1] / compared), maxError[1]);
+        printf("  yaw    RMS %.3f  max %.3f deg\n", sqrt(squareSum[2] / compared), maxError[2]);
+    }
+    return 0;
+}
@@ -0,0 +1,166 @@
+/**
+ * @file    flashkv_tool.c
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2019/09/02
+ * @brief
+ *          Host tool reading and editing an image of the calibration store
+ *          of user/flashkv.c.
+ * @note
+ *          Build on PC:
+ *              gcc -O2 -DFLASHKV_HOST -I../user -o flashkv_tool flashkv_tool.c ../user/flashkv.c
+ *
+ *          Usage:
+ *              flashkv_tool image.bin dump
+ *              flashkv_tool image.bin get key version length
+ *              flashkv_tool image.bin set key version hex
+ *              flashkv_tool image.bin delete key
+ *              flashkv_tool image.bin format
+ *
+ *          Numbers may be decimal or 0x-prefixed hex, values are hex bytes.
+ *          Read the sector off the board with the debugger, e.g. save
+ *          0x08060000 0x20000 in ST-Link Utility, and program it back the
+ *          same way.
+ *
+ *          The source code repository is available on GitHub:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "flashkv.h"
+
+/**
+ * @brief Print usage and exit.
+ */
+static void Usage(void)
+{
+    fprintf(stderr, "usage: flashkv_tool image.bin dump|get key version length|set key version hex|delete key|format\n");
+    exit(1);
+}
+
+/**
+ * @brief Print a value as hex bytes.
+ */
+static void PrintHex(const uint8_t *value, int length)
+{
+    int i;
+    for (i = 0; i < length; i++)
+        printf("%02x", value[i]);
+    printf("\n");
+}
+
+/**
+ * @brief Parse hex bytes.
+ * @return Number of bytes, -1 on a bad string.
+ */
+static int ParseHex(const char *text, uint8_t *value, int maxLength)
+{
+    int length = 0;
+    unsigned int byte;
+    if (strlen(text) % 2 != 0)
+        return -1;
+    while (*text != '\0')
+    {
+        if (length == maxLength || sscanf(text, "%2x", &byte) != 1)
+            return -1;
+        value[length++] = (uint8_t)byte;
+        text += 2;
+    }
+    return length;
+}
+
+/**
+ * @brief Print every record of an image, including torn and deleted ones.
+ */
+static int Dump(const char *path)
+{
+    FILE *file = fopen(path, "rb");
+    uint8_t *image;
+    long size;
+    uint32_t offset = 4, header, check;
+    uint16_t length;
+    if (file == NULL)
+    {
+        perror(path);
+        return 1;
+    }
+    image = malloc(FLASHKV_SIZE);
+    memset(image, 0xFF, FLASHKV_SIZE);
+    size = (long)fread(image, 1, FLASHKV_SIZE, file);
+    fclose(file);
+    printf("magic %02x%02x%02x%02x, %ld bytes\n", image[3], image[2], image[1], image[0], size);
+    printf("offset   key    version length crc\n");
+    while (offset + 8 <= FLASHKV_SIZE)
+    {
+        memcpy(&header, image + offset, 4);
+        memcpy(&check, image + offset + 4, 4);
+        if (header == 0xFFFFFFFF)
+            break;
+        length = (uint16_t)(header >> 16);
+        if (length > FLASHKV_MAX_LENGTH || offset + 8 + ((length + 3) & ~3U) > FLASHKV_SIZE)
+        {
+            printf("%06x damaged\n", (unsigned int)offset);
+            break;
+        }
+        printf("%06x   0x%04x %7u %6u 0x%04x ", (unsigned int)offset, header & 0xFFFF,
+               check & 0xFFFF, length, check >> 16);
+        if (check == 0xFFFFFFFF)
+            printf("torn\n");
+        else if (length == 0)
+            printf("deleted\n");
+        else
+            PrintHex(image + offset + 8, length);
+        offset += 8 + ((length + 3) & ~3U);
+    }
+    printf("%u bytes free, crc is checked by get\n", (unsigned int)(FLASHKV_SIZE - offset));
+    free(image);
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    uint8_t value[FLASHKV_MAX_LENGTH];
+    int length;
+    if (argc < 3)
+        Usage();
+    FLASHKV_HostFile = argv[1];
+    if (strcmp(argv[2], "dump") == 0 && argc == 3)
+        return Dump(argv[1]);
+    if (strcmp(argv[2], "get") == 0 && argc == 6)
+    {
+        length = (int)strtoul(argv[5], NULL, 0);
+        if (length <= 0 || length > FLASHKV_MAX_LENGTH)
+            Usage();
+        if (FLASHKV_Read((uint16_t)strtoul(argv[3], NULL, 0), (uint16_t)strtoul(argv[4], NULL, 0), value, (uint16_t)length))
+        {
+            fprintf(stderr, "not found\n");
+            return 1;
+        }
+        PrintHex(value, length);
+        return 0;
+    }
+    if (strcmp(argv[2], "set") == 0 && argc == 6)
+    {
+        if ((length = ParseHex(argv[5], value, FLASHKV_MAX_LENGTH)) <= 0)
+            Usage();
+        if (FLASHKV_Write((uint16_t)strtoul(argv[3], NULL, 0), (uint16_t)strtoul(argv[4], NULL, 0), value, (uint16_t)length))
+        {
+            fprintf(stderr, "write failed\n");
+            return 1;
+        }
+        return 0;
+    }
+    if (strcmp(argv[2], "delete") == 0 && argc == 4)
+        return FLASHKV_Delete((uint16_t)strtoul(argv[3], NULL, 0));
+    if (strcmp(argv[2], "format") == 0 && argc == 3)
+        return FLASHKV_Format();
+    Usage();
+    return 1;
+}
@@ -0,0 +1,111 @@
+/**
+ * @file    host_stm32.h
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2019/08/14
+ * @brief
+ *          The part of stm32f4xx.h and utils.h used by the software IIC
+ *          of user/bsp_iic.c and the OLED driver, for the host builds of
+ *          tools/oled_emu.c.
+ * @note
+ *          Included instead of stm32f4xx.h when IIC_HOST or OLED_HOST is
+ *          defined. GPIO registers are plain RAM: a write only changes the
+ *          register, the emulator reads ODR/MODER back and drives IDR each
+ *          time the driver reads the cycle counter, which the software IIC
+ *          does between every two edges. Two writes to BSRR would overwrite
+ *          each other before that, so with IIC_HOST bsp_iic.c sets and
+ *          clears the pins in ODR instead.
+ *          Interrupts do not exist on PC, __disable_irq does nothing.
+ *
+ *          The source code repository is available on GitHub:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#ifndef __HOST_STM32_H
+#define __HOST_STM32_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define __IO                volatile
+#define __CLZ(x)            ((uint8_t)__builtin_clz(x))
+
+typedef enum {DISABLE = 0, ENABLE = !DISABLE} FunctionalState;
+
+typedef struct
+{
+  __IO uint32_t MODER;
+  __IO uint32_t OTYPER;
+  __IO uint32_t OSPEEDR;
+  __IO uint32_t PUPDR;
+  __IO uint32_t IDR;
+  __IO uint32_t ODR;
+  __IO uint16_t BSRRL;
+  __IO uint16_t BSRRH;
+  __IO uint32_t LCKR;
+  __IO uint32_t AFR[2];
+} GPIO_TypeDef;
+
+#define HOST_GPIO_PORTS     5
+extern GPIO_TypeDef HOST_Gpio[HOST_GPIO_PORTS];
+#define GPIOA               (&HOST_Gpio[0])
+#define GPIOB               (&HOST_Gpio[1])
+#define GPIOC               (&HOST_Gpio[2])
+#define GPIOD               (&HOST_Gpio[3])
+#define GPIOE               (&HOST_Gpio[4])
+
+#define GPIO_Pin_0          ((uint16_t)0x0001)
+#define GPIO_Pin_1          ((uint16_t)0x0002)
+#define GPIO_Pin_2          ((uint16_t)0x0004)
+#define GPIO_Pin_3          ((uint16_t)0x0008)
+#define GPIO_Pin_4          ((uint16_t)0x0010)
+#define GPIO_Pin_5          ((uint16_t)0x0020)
+#define GPIO_Pin_6          ((uint16_t)0x0040)
+#define GPIO_Pin_7          ((uint16_t)0x0080)
+#define GPIO_Pin_8          ((uint16_t)0x0100)
+#define GPIO_Pin_9          ((uint16_t)0x0200)
+#define GPIO_Pin_10         ((uint16_t)0x0400)
+#define GPIO_Pin_11         ((uint16_t)0x0800)
+#define GPIO_Pin_12         ((uint16_t)0x1000)
+#define GPIO_Pin_13         ((uint16_t)0x2000)
+#define GPIO_Pin_14         ((uint16_t)0x4000)
+#define GPIO_Pin_15         ((uint16_t)0x8000)
+
+typedef enum {GPIO_Mode_IN = 0x00, GPIO_Mode_OUT = 0x01, GPIO_Mode_AF = 0x02, GPIO_Mode_AN = 0x03} GPIOMode_TypeDef;
+typedef enum {GPIO_OType_PP = 0x00, GPIO_OType_OD = 0x01} GPIOOType_TypeDef;
+typedef enum {GPIO_Low_Speed = 0x00, GPIO_Medium_Speed = 0x01, GPIO_Fast_Speed = 0x02, GPIO_High_Speed = 0x03} GPIOSpeed_TypeDef;
+typedef enum {GPIO_PuPd_NOPULL = 0x00, GPIO_PuPd_UP = 0x01, GPIO_PuPd_DOWN = 0x02} GPIOPuPd_TypeDef;
+
+typedef struct
+{
+  uint32_t GPIO_Pin;
+  GPIOMode_TypeDef GPIO_Mode;
+  GPIOSpeed_TypeDef GPIO_Speed;
+  GPIOOType_TypeDef GPIO_OType;
+  GPIOPuPd_TypeDef GPIO_PuPd;
+} GPIO_InitTypeDef;
+
+void GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_InitStruct);
+#define RCC_AHB1PeriphClockCmd(periph, state)   ((void)(state)) //!< Clocks are always on, periph is not evaluated.
+
+#define __disable_irq()
+#define __enable_irq()
+#define __get_PRIMASK()  0
+#define __set_PRIMASK(x) ((void)(x))
+#define __get_IPSR()     0
+
+extern uint32_t SystemCoreClock;
+
+//utils.h
+void UTILS_InitCycleCounter(void);
+uint32_t UTILS_GetCycleCount(void);
+void UTILS_DelayUs(uint32_t us);
+void UTILS_DelayMs(uint32_t ms);
+
+#endif
@@ -0,0 +1,221 @@
+/**
+ * @file    iic_tracedec.c
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2019/08/26
+ * @brief
+ *          Host tool decoding the IIC trace printed by IIC_TRACE_Dump in
+ *          user/bsp_iic.c into a timeline and per-device totals.
+ * @note
+ *          Build on PC:
+ *              gcc -O2 -o iic_tracedec iic_tracedec.c
+ *
+ *          Usage:
+ *              iic_tracedec [-s] [capture.txt]
+ *              -s              Print the per-device totals only.
+ *
+ *          Save what the serial port receives to a file, or pipe it in.
+ *          Other text around the dump is ignored. Each dump found is
+ *          decoded on its own.
+ *
+ *          The source code repository is available on GitHub:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define FLAG_READ       0x01 //!< Read transfer.
+#define FLAG_NACK       0x02 //!< Not acknowledged or bus error.
+#define FLAG_NOREG      0x04 //!< Transfer without a register address.
+#define MAX_DEVICES     64
+
+/**
+ * @brief Totals of one device, a device being an address on a bus.
+ */
+typedef struct
+{
+    unsigned bus;
+    unsigned addr;
+    unsigned long transfers;
+    unsigned long reads;
+    unsigned long bytes;
+    unsigned long nacks;
+    double totalUs;
+    double maxUs;
+} Device;
+
+static int summaryOnly = 0;
+static Device devices[MAX_DEVICES];
+static int deviceCount;
+static double busUs[256];//Transfer time of each bus in a dump.
+
+/**
+ * @brief Print usage and exit.
+ */
+static void Usage(void)
+{
+    fprintf(stderr, "usage: iic_tracedec [-s] [capture.txt]\n");
+    exit(1);
+}
+
+/**
+ * @brief Find the totals of a device, adding it if it is new.
+ * @return NULL if there are too many devices.
+ */
+static Device *FindDevice(unsigned bus, unsigned addr)
+{
+    int i;
+    for (i = 0; i < deviceCount; i++)
+        if (devices[i].bus == bus && devices[i].addr == addr)
+            return &devices[i];
+    if (deviceCount == MAX_DEVICES)
+        return NULL;
+    memset(&devices[deviceCount], 0, sizeof(Device));
+    devices[deviceCount].bus = bus;
+    devices[deviceCount].addr = addr;
+    return &devices[deviceCount++];
+}
+
+/**
+ * @brief Print the totals of one dump.
+ */
+static void PrintTotals(double spanUs)
+{
+    int i;
+    printf("\n bus  addr  transfers  reads  writes   bytes  nacks   total(us)   avg(us)   max(us)\n");
+    for (i = 0; i < deviceCount; i++)
+    {
+        Device *device = &devices[i];
+        printf("%4u  0x%02X  %9lu  %5lu  %6lu  %6lu  %5lu  %10.1f  %8.1f  %8.1f\n",
+               device->bus, device->addr, device->transfers, device->reads, device->transfers - device->reads,
+               device->bytes, device->nacks, device->totalUs, device->totalUs / device->transfers, device->maxUs);
+    }
+    if (spanUs <= 0)
+        return;
+    printf("\n");
+    for (i = 0; i < 256; i++)
+        if (busUs[i] > 0)
+            printf("Bus %d busy %.1f us of %.1f us (%.1f%%)\n", i, busUs[i], spanUs, busUs[i] * 100.0 / spanUs);
+}
+
+/**
+ * @brief Decode the records of one dump up to its end line.
+ * @return 0 on success, 1 if the input ended early.
+ */
+static int DecodeDump(FILE *file, unsigned long clock, unsigned long count, unsigned long dropped, int index)
+{
+    char line[256];
+    unsigned long timestamp, duration, previous = 0;
+    unsigned bus, addr, reg, len, flags;
+    uint64_t time, first = 0, last = 0, end = 0, previousEnd = 0;
+    double cyclesPerUs = clock / 1e6, durationUs;
+    unsigned long records = 0;
+    Device *device;
+
+    deviceCount = 0;
+    memset(busUs, 0, sizeof(busUs));
+    printf("Dump %d: %lu records, %lu overwritten, core clock %lu Hz\n", index, count, dropped, clock);
+    if (!summaryOnly)
+        printf("\n   time(us)    gap(us)    dur(us)  bus  addr  op   reg   len  result\n");
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        if (strncmp(line, "IICTRACE END", 12) == 0)
+        {
+            if (records != count)
+                fprintf(stderr, "dump %d: %lu records expected, %lu found\n", index, count, records);
+            PrintTotals(records ? (end - first) / cyclesPerUs : 0);
+            printf("\n");
+            return 0;
+        }
+        if (sscanf(line, "%lx %lx %x %x %x %x %x", &timestamp, &duration, &bus, &addr, &reg, &len, &flags) != 7)
+            continue;
+        //The cycle counter wraps around every 2^32 cycles, records are in time order.
+        time = records ? last + (uint32_t)(timestamp - previous) : timestamp;
+        if (records == 0)
+            first = time;
+        previous = timestamp;
+        last = time;
+        durationUs = duration / cyclesPerUs;
+        busUs[bus & 0xFF] += durationUs;
+        if (!summaryOnly)
+        {
+            //Gap is the idle time since the previous transfer ended.
+            printf("%11.2f ", (time - first) / cyclesPerUs);
+            if (records == 0)
+                printf("%10s ", "-");
+            else if (time >= previousEnd)
+                printf("%10.2f ", (time - previousEnd) / cyclesPerUs);
+            else
+                printf("%10.2f ", -((previousEnd - time) / cyclesPerUs));
+            printf("%10.2f  %3u  0x%02X  %-2s ", durationUs, bus, addr, flags & FLAG_READ ? "R" : "W");
+            if (flags & FLAG_NOREG)
+                printf("   -");
+            else
+                printf("0x%02X", reg);
+            printf("  %4u  %s\n", len, flags & FLAG_NACK ? "NACK" : "ACK");
+        }
+        previousEnd = time + duration;
+        if (previousEnd > end)
+            end = previousEnd;
+        device = FindDevice(bus, addr);
+        if (device != NULL)
+        {
+            device->transfers++;
+            device->reads += (flags & FLAG_READ) != 0;
+            device->bytes += len;
+            device->nacks += (flags & FLAG_NACK) != 0;
+            device->totalUs += durationUs;
+            if (durationUs > device->maxUs)
+                device->maxUs = durationUs;
+        }
+        records++;
+    }
+    fprintf(stderr, "dump %d: input ended before IICTRACE END\n", index);
+    return 1;
+}
+
+int main(int argc, char *argv[])
+{
+    FILE *file = stdin;
+    char line[256];
+    unsigned long clock, count, dropped;
+    int i, dumps = 0;
+
+    for (i = 1; i < argc && argv[i][0] == '-' && argv[i][1] != '\0'; i++)
+    {
+        if (strcmp(argv[i], "-s") == 0)
+            summaryOnly = 1;
+        else
+            Usage();
+    }
+    if (i + 1 < argc)
+        Usage();
+    if (i < argc && (file = fopen(argv[i], "r")) == NULL)
+    {
+        perror(argv[i]);
+        return 1;
+    }
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        if (sscanf(line, "IICTRACE %lx %lx %lx", &clock, &count, &dropped) != 3 || clock == 0)
+            continue;
+        if (DecodeDump(file, clock, count, dropped, ++dumps))
+            break;
+    }
+    if (file != stdin)
+        fclose(file);
+    if (dumps == 0)
+    {
+        fprintf(stderr, "no IICTRACE dump found\n");
+        return 1;
+    }
+    return 0;
+}
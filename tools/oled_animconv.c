@@ -0,0 +1,246 @@
+/**
+ * @file    oled_animconv.c
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2019/08/12
+ * @brief
+ *          Host tool converting an image sequence to the animation file
+ *          format played by user/oled/oled_animation.c.
+ * @note
+ *          Build on PC:
+ *              gcc -O2 -o oled_animconv oled_animconv.c
+ *
+ *          Usage:
+ *              oled_animconv [options] output.mwa frame0.pgm frame1.pgm ...
+ *              -r fps          Frame rate stored in the file, 1~254, 25 by default.
+ *              -t threshold    Pixels brighter than threshold are lit, 128 by default.
+ *              -i              Invert pixels.
+ *
+ *          Frames must be 128x64 PBM or PGM images (P1, P2, P4 or P5).
+ *          Other formats can be converted first, e.g.
+ *              ffmpeg -i video.mp4 -vf scale=128:64 -r 25 frame%04d.pgm
+ *
+ *          The source code repository is available on GitHub:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define WIDTH           128
+#define HEIGHT          64
+#define FRAME_SIZE      (WIDTH * HEIGHT / 8)
+#define MAX_COUNT       64
+#define MIN_SKIP        3 //!< Shorter unchanged runs are cheaper to send as literals.
+#define MIN_RUN         3 //!< Shorter repeats are cheaper to send as literals.
+
+static int threshold = 128;
+static int invert = 0;
+
+/**
+ * @brief Print usage and exit.
+ */
+static void Usage(void)
+{
+    fprintf(stderr, "usage: oled_animconv [-r fps] [-t threshold] [-i] output.mwa frame0.pgm frame1.pgm ...\n");
+    exit(1);
+}
+
+/**
+ * @brief Read the next number of a PNM header, skipping comments.
+ */
+static int ReadNumber(FILE *file)
+{
+    int c, value = 0;
+    do
+    {
+        c = fgetc(file);
+        if(c == '#')
+            while(c != '\n' && c != EOF)
+                c = fgetc(file);
+    }while(c == ' ' || c == '\t' || c == '\r' || c == '\n');
+    if(c < '0' || c > '9')
+        return -1;
+    for(; c >= '0' && c <= '9'; c = fgetc(file))
+        value = value * 10 + c - '0';
+    return value;
+}
+
+/**
+ * @brief Load an image into the frame buffer layout: 8 pages of 128 columns, LSB on top.
+ */
+static void LoadFrame(const char *path, uint8_t frame[FRAME_SIZE])
+{
+    FILE *file = fopen(path, "rb");
+    int type, width, height, maxValue = 1, x, y, lit, value = 0;
+    if(file == NULL || fgetc(file) != 'P')
+    {
+        fprintf(stderr, "%s: not a PBM or PGM image\n", path);
+        exit(1);
+    }
+    type = fgetc(file) - '0';
+    width = ReadNumber(file);
+    height = ReadNumber(file);
+    if(type == 2 || type == 5)
+        maxValue = ReadNumber(file);
+    if((type != 1 && type != 2 && type != 4 && type != 5) || width != WIDTH || height != HEIGHT || maxValue <= 0 || maxValue > 255)
+    {
+        fprintf(stderr, "%s: must be a %dx%d PBM or 8-bit PGM image\n", path, WIDTH, HEIGHT);
+        exit(1);
+    }
+    memset(frame, 0, FRAME_SIZE);
+    for(y = 0; y < HEIGHT; y++)
+    {
+        for(x = 0; x < WIDTH; x++)
+        {
+            if(type == 4)
+            {
+                if((x & 7) == 0)
+                    value = fgetc(file);
+                lit = !((value >> (7 - (x & 7))) & 1);//PBM: 1 is black
+            }
+            else if(type == 1)
+            {
+                lit = ReadNumber(file) == 0;
+            }
+            else
+            {
+                value = type == 5 ? fgetc(file) : ReadNumber(file);
+                lit = value * 255 / maxValue >= threshold;
+            }
+            if(value == EOF)
+            {
+                fprintf(stderr, "%s: truncated image\n", path);
+                exit(1);
+            }
+            if(lit != invert)
+                frame[(y >> 3) * WIDTH + x] |= 1 << (y & 7);
+        }
+    }
+    fclose(file);
+}
+
+/**
+ * @brief Encode the differences between two frames.
+ * @return Bytes written.
+ */
+static size_t EncodeFrame(FILE *file, const uint8_t previous[FRAME_SIZE], const uint8_t frame[FRAME_SIZE])
+{
+    size_t bytes = 0;
+    int position = 0, end, skip, count, run, i;
+    while(position < FRAME_SIZE)
+    {
+        //Unchanged bytes.
+        for(skip = 0; position + skip < FRAME_SIZE && frame[position + skip] == previous[position + skip]; skip++);
+        if(position + skip == FRAME_SIZE)
+            break;
+        if(skip)
+        {
+            position += skip;
+            for(; skip >= MAX_COUNT; skip -= count)
+            {
+                count = skip / MAX_COUNT > 63 ? 63 : skip / MAX_COUNT;
+                fputc(0xC0 | (count - 1), file);
+                bytes++;
+                count *= MAX_COUNT;
+            }
+            if(skip)
+            {
+                fputc(skip - 1, file);
+                bytes++;
+            }
+        }
+        //Changed bytes, until an unchanged run long enough to be worth a skip.
+        for(end = position; end < FRAME_SIZE; end++)
+        {
+            for(skip = 0; end + skip < FRAME_SIZE && skip < MIN_SKIP && frame[end + skip] == previous[end + skip]; skip++);
+            if(skip == MIN_SKIP || end + skip == FRAME_SIZE)
+                break;
+        }
+        while(position < end)
+        {
+            for(run = 1; position + run < end && run < MAX_COUNT && frame[position + run] == frame[position]; run++);
+            if(run >= MIN_RUN)
+            {
+                fputc(0x80 | (run - 1), file);
+                fputc(frame[position], file);
+                bytes += 2;
+                position += run;
+                continue;
+            }
+            //Literal bytes, until a repeat long enough to be worth a run.
+            for(count = 0; position + count < end && count < MAX_COUNT; count++)
+            {
+                for(run = 1; position + count + run < end && run < MIN_RUN && frame[position + count + run] == frame[position + count]; run++);
+                if(run == MIN_RUN)
+                    break;
+            }
+            fputc(0x40 | (count - 1), file);
+            for(i = 0; i < count; i++)
+                fputc(frame[position + i], file);
+            bytes += 1 + count;
+            position += count;
+        }
+    }
+    fputc(0xFF, file);
+    return bytes + 1;
+}
+
+int main(int argc, char *argv[])
+{
+    static uint8_t previous[FRAME_SIZE], frame[FRAME_SIZE];
+    FILE *output;
+    int fps = 25, i, frameCount;
+    size_t bytes, totalBytes = 0, maxBytes = 0;
+
+    for(i = 1; i < argc && argv[i][0] == '-'; i++)
+    {
+        if(strcmp(argv[i], "-i") == 0)
+            invert = 1;
+        else if(i + 1 >= argc)
+            Usage();
+        else if(strcmp(argv[i], "-r") == 0)
+            fps = atoi(argv[++i]);
+        else if(strcmp(argv[i], "-t") == 0)
+            threshold = atoi(argv[++i]);
+        else
+            Usage();
+    }
+    frameCount = argc - i - 1;
+    if(frameCount < 1 || frameCount > 0xFFFF || fps < 1 || fps > 254)
+        Usage();
+
+    output = fopen(argv[i], "wb");
+    if(output == NULL)
+    {
+        perror(argv[i]);
+        return 1;
+    }
+    fwrite("MWA1", 1, 4, output);
+    fputc(frameCount & 0xFF, output);
+    fputc(frameCount >> 8, output);
+    fputc(fps, output);
+    fputc(0, output);
+    memset(previous, 0, FRAME_SIZE);//The first frame is encoded against a blank screen.
+    for(i++; i < argc; i++)
+    {
+        LoadFrame(argv[i], frame);
+        bytes = EncodeFrame(output, previous, frame);
+        totalBytes += bytes;
+        if(bytes > maxBytes)
+            maxBytes = bytes;
+        memcpy(previous, frame, FRAME_SIZE);
+    }
+    fclose(output);
+    printf("%d frames, %lu bytes, %.1f bytes per frame, %lu bytes max, %.1f KiB/s at %d fps\n",
+           frameCount, (unsigned long)totalBytes, (double)totalBytes / frameCount, (unsigned long)maxBytes,
+           (double)totalBytes / frameCount * fps / 1024, fps);
+    return 0;
+}
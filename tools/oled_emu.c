@@ -0,0 +1,708 @@
+/**
+ * @file    oled_emu.c
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2019/08/14
+ * @brief
+ *          Host harness running user/oled/oled.c against an emulated
+ *          SSD1306, for pixel-exact regression tests and bus-cost
+ *          benchmarks without a panel.
+ * @note
+ *          Build on PC:
+ *              gcc -O2 -DIIC_HOST -DOLED_HOST -I. -I../user -I../user/oled -o oled_emu oled_emu.c ../user/oled/oled.c ../user/bsp_iic.c
+ *
+ *          Usage:
+ *              oled_emu [-p prefix] [-w baseline.txt] [-c baseline.txt]
+ *              -p prefix       Dump the panel after every step to prefix_NN_step.pgm.
+ *              -w file         Write the counts and frame hashes as a new baseline.
+ *              -c file         Compare with a baseline, fail if a step costs more
+ *                              transactions, bytes or clocks, or if a frame differs.
+ *
+ *          The driver is built with the software IIC of bsp_iic.c on the GPIO
+ *          model of host_stm32.h. Every time the bit-bang code reads the cycle
+ *          counter the emulator samples SCL and SDA, decodes START, STOP,
+ *          bytes and acknowledges, and feeds the bytes sent to 0x78 into an
+ *          SSD1306 command parser with its own 128x64 GDDRAM. Nothing of the
+ *          driver's frame buffer is read to build the panel image.
+ *
+ *          A fixed scenario of driver calls is run, one OLED_Flush after
+ *          each step. Per step the transactions, bytes, SCL clocks and bus
+ *          time decoded from the pins are printed. Bus time is the cycle
+ *          count from START to the end of STOP at SystemCoreClock, i.e. what
+ *          the bit-bang code spends on the bus at OLED_I2C_SPEED.
+ *          The run fails (exit code 1) when
+ *              1. the decoded counts differ from OLED_GetStatistics,
+ *              2. the panel differs from OLED_GetPixel after a flush,
+ *              3. the bus has a NACK, a collision or an unknown command,
+ *              4. -c is given and a step regressed.
+ *          Run it with -c tools/oled_emu_baseline.txt to check a change of
+ *          the driver, and write a new baseline with -w when a change is
+ *          meant to alter the traffic.
+ *
+ *          The source code repository is available on GitHub:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "oled.h"
+
+#define PANEL_WIDTH     128
+#define PANEL_HEIGHT    64
+#define PANEL_PAGES     (PANEL_HEIGHT / 8)
+#define MAX_STEPS       32
+
+GPIO_TypeDef HOST_Gpio[HOST_GPIO_PORTS];
+uint32_t SystemCoreClock = 168000000;
+
+extern uint8_t OLED_Picture1[];//oled_bmp.h, linked from oled.c
+
+/**
+ * @brief Bus decoder state.
+ */
+static struct
+{
+    uint32_t cycles;//Virtual cycle counter, one cycle per read of the counter
+    uint8_t scl, sda;//Line levels at the last sample
+    uint8_t slaveLow;//Slave pulls SDA low
+    uint8_t active;//Between START and STOP
+    uint8_t addressed;//The first byte was the OLED address
+    uint8_t bits, shift, inAck, ackClocked, first;
+    uint32_t startCycle;
+    //Counts since the last reset
+    uint32_t transactions, bytes, clocks, busCycles;
+    //Errors, never reset
+    uint32_t nacks, collisions, unknownCommands;
+} bus;
+
+/**
+ * @brief SSD1306 state.
+ */
+static struct
+{
+    uint8_t gddram[PANEL_PAGES][PANEL_WIDTH];
+    uint8_t column, page;
+    uint8_t mode;//0-horizontal; 1-vertical; 2-page addressing
+    uint8_t columnBegin, columnEnd, pageBegin, pageEnd;
+    uint8_t startLine, offset;
+    uint8_t segmentRemap, comReverse, inverse, entireOn, displayOn, chargePump;
+    uint8_t scrolling;
+    //Control byte state of the current transaction
+    uint8_t expectControl, continuation, dataMode;
+    uint8_t command[8], commandLength, commandNeed;
+} oled;
+
+/**
+ * @brief Parameter bytes following a command.
+ */
+static uint8_t SSD1306_ParameterCount(uint8_t command)
+{
+    switch (command)
+    {
+    case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+    case 0xD5: case 0xD8: case 0xD9: case 0xDA: case 0xDB:
+        return 1;
+    case 0x21: case 0x22: case 0xA3:
+        return 2;
+    case 0x29: case 0x2A:
+        return 5;
+    case 0x26: case 0x27:
+        return 6;
+    default:
+        return 0;
+    }
+}
+
+/**
+ * @brief Execute a complete command.
+ */
+static void SSD1306_Command(const uint8_t *command)
+{
+    uint8_t c = command[0];
+    if (c <= 0x0F)
+        oled.column = (oled.column & 0xF0) | c;
+    else if (c <= 0x1F)
+        oled.column = (uint8_t)((oled.column & 0x0F) | ((c & 0x07) << 4));
+    else if (c >= 0x40 && c <= 0x7F)
+        oled.startLine = c & 0x3F;
+    else if (c >= 0xB0 && c <= 0xB7)
+        oled.page = c & 0x07;
+    else
+    {
+        switch (c)
+        {
+        case 0x20: oled.mode = command[1] & 0x03; break;
+        case 0x21:
+            oled.columnBegin = oled.column = command[1] & 0x7F;
+            oled.columnEnd = command[2] & 0x7F;
+            break;
+        case 0x22:
+            oled.pageBegin = oled.page = command[1] & 0x07;
+            oled.pageEnd = command[2] & 0x07;
+            break;
+        case 0x26: case 0x27: case 0x29: case 0x2A: case 0xA3:
+        case 0x81: case 0xA8: case 0xD5: case 0xD8: case 0xD9: case 0xDA: case 0xDB: case 0xE3:
+            break;//Timing, scroll setup and analog settings do not change the image model
+        case 0x2E: oled.scrolling = 0; break;
+        case 0x2F: oled.scrolling = 1; break;
+        case 0x8D: oled.chargePump = (command[1] & 0x04) != 0; break;
+        case 0xA0: case 0xA1: oled.segmentRemap = c & 1; break;
+        case 0xA4: case 0xA5: oled.entireOn = c & 1; break;
+        case 0xA6: case 0xA7: oled.inverse = c & 1; break;
+        case 0xAE: case 0xAF: oled.displayOn = c & 1; break;
+        case 0xC0: case 0xC8: oled.comReverse = (c & 0x08) != 0; break;
+        case 0xD3: oled.offset = command[1] & 0x3F; break;
+        default:
+            bus.unknownCommands++;
+            fprintf(stderr, "unknown command 0x%02x\n", c);
+        }
+    }
+}
+
+/**
+ * @brief Write one byte of GDDRAM and advance the address.
+ */
+static void SSD1306_Data(uint8_t data)
+{
+    oled.gddram[oled.page][oled.column] = data;
+    if (oled.mode == 2)
+    {
+        oled.column = (oled.column + 1) & 0x7F;
+        return;
+    }
+    if (oled.mode == 0)
+    {
+        if (oled.column++ < oled.columnEnd)
+            return;
+        oled.column = oled.columnBegin;
+        oled.page = oled.page >= oled.pageEnd ? oled.pageBegin : oled.page + 1;
+        return;
+    }
+    if (oled.page++ < oled.pageEnd)
+        return;
+    oled.page = oled.pageBegin;
+    oled.column = oled.column >= oled.columnEnd ? oled.columnBegin : oled.column + 1;
+}
+
+/**
+ * @brief Feed one byte after the address: control byte, command or data.
+ */
+static void SSD1306_Byte(uint8_t byte)
+{
+    if (oled.expectControl)
+    {
+        oled.continuation = (byte & 0x80) != 0;
+        oled.dataMode = (byte & 0x40) != 0;
+        oled.expectControl = 0;
+        return;
+    }
+    if (oled.dataMode)
+        SSD1306_Data(byte);
+    else
+    {
+        if (oled.commandLength == 0)
+            oled.commandNeed = 1 + SSD1306_ParameterCount(byte);
+        oled.command[oled.commandLength++] = byte;
+        if (oled.commandLength == oled.commandNeed)
+        {
+            SSD1306_Command(oled.command);
+            oled.commandLength = 0;
+        }
+    }
+    if (oled.continuation)
+        oled.expectControl = 1;
+}
+
+/**
+ * @brief Power-on state of the controller.
+ */
+static void SSD1306_Reset(void)
+{
+    memset(&oled, 0, sizeof(oled));
+    oled.mode = 2;
+    oled.columnEnd = PANEL_WIDTH - 1;
+    oled.pageEnd = PANEL_PAGES - 1;
+    for (int page = 0; page < PANEL_PAGES; page++)
+        for (int x = 0; x < PANEL_WIDTH; x++)
+            oled.gddram[page][x] = (uint8_t)rand();//GDDRAM is undefined after power on
+}
+
+/**
+ * @brief A pixel as seen on the glass, (0, 0) at the top left.
+ * @note A1 and C8 are how the module is mounted, they give the upright image.
+ */
+static uint8_t SSD1306_Pixel(int x, int y)
+{
+    int row, column;
+    if (!oled.displayOn)
+        return 0;
+    if (oled.entireOn)
+        return 1;
+    column = oled.segmentRemap ? x : PANEL_WIDTH - 1 - x;
+    row = oled.comReverse ? y : PANEL_HEIGHT - 1 - y;
+    row = (row + oled.startLine + oled.offset) & (PANEL_HEIGHT - 1);
+    return ((oled.gddram[row >> 3][column] >> (row & 7)) & 1) ^ oled.inverse;
+}
+
+/**
+ * @brief Called on every falling edge of SCL.
+ */
+static void BUS_SclFall(void)
+{
+    if (!bus.active)
+        return;
+    if (bus.inAck)
+    {
+        if (!bus.ackClocked)
+            return;
+        bus.slaveLow = 0;//Release SDA after the ninth clock
+        bus.inAck = bus.ackClocked = 0;
+        bus.bits = 0;
+        return;
+    }
+    if (bus.bits < 8)
+        return;
+    bus.bytes++;
+    if (bus.first)
+    {
+        bus.first = 0;
+        bus.addressed = bus.shift == OLED_IIC_ADDRESS;
+        if (!bus.addressed)
+            bus.nacks++;
+    }
+    else if (bus.addressed)
+        SSD1306_Byte(bus.shift);
+    bus.slaveLow = bus.addressed;
+    bus.inAck = 1;
+}
+
+/**
+ * @brief Called on every rising edge of SCL, with the SDA level.
+ */
+static void BUS_SclRise(uint8_t sda)
+{
+    if (!bus.active)
+        return;
+    bus.clocks++;
+    if (bus.inAck)
+    {
+        bus.ackClocked = 1;
+        return;
+    }
+    bus.shift = (uint8_t)((bus.shift << 1) | sda);
+    bus.bits++;
+}
+
+/**
+ * @brief Called when SDA changes while SCL is high.
+ */
+static void BUS_SdaChange(uint8_t sda)
+{
+    if (!sda)
+    {
+        bus.active = 1;//START, also repeated START
+        bus.first = 1;
+        bus.bits = 0;
+        bus.inAck = bus.ackClocked = 0;
+        bus.startCycle = bus.cycles;
+        bus.transactions++;
+        bus.clocks++;//Counted like the driver: one clock for START, one for STOP
+        oled.expectControl = 1;
+        oled.continuation = 0;
+        return;
+    }
+    if (!bus.active)
+        return;
+    bus.active = 0;//STOP, its rising SCL edge was already counted
+    bus.slaveLow = 0;
+    bus.busCycles += bus.cycles - bus.startCycle;
+}
+
+/**
+ * @brief Level of a pin: output data when the master drives it, else pulled up.
+ */
+static uint8_t BUS_MasterLevel(GPIO_TypeDef *port, uint16_t pin)
+{
+    uint32_t index = 31 - __builtin_clz(pin);
+    if (((port->MODER >> (index << 1)) & 3) != GPIO_Mode_OUT)
+        return 1;
+    return (port->ODR & pin) != 0;
+}
+
+/**
+ * @brief Process the edges since the last sample.
+ * @note All changes between two samples are taken in bus order: SCL
+ *       falling first, then SDA, then SCL rising. bsp_iic.c never changes
+ *       SDA while SCL is high without a delay in between, so the order
+ *       only matters for the changes right after a falling edge.
+ */
+static void BUS_Sync(void)
+{
+    uint8_t scl, sda, master;
+    scl = BUS_MasterLevel(OLED_SCL_PORT, OLED_SCL_PIN);
+    if (bus.scl && !scl)
+    {
+        bus.scl = 0;
+        BUS_SclFall();
+    }
+    master = BUS_MasterLevel(OLED_SDA_PORT, OLED_SDA_PIN);
+    if (master && bus.slaveLow && ((OLED_SDA_PORT->MODER >> ((31 - __builtin_clz(OLED_SDA_PIN)) << 1)) & 3) == GPIO_Mode_OUT)
+        bus.collisions++;//Push-pull high against the acknowledge
+    sda = master && !bus.slaveLow;
+    if (sda != bus.sda)
+    {
+        bus.sda = sda;
+        if (bus.scl)
+            BUS_SdaChange(sda);
+    }
+    if (!bus.scl && scl)
+    {
+        bus.scl = 1;
+        BUS_SclRise(sda);
+    }
+    OLED_SCL_PORT->IDR = (OLED_SCL_PORT->IDR & ~(uint32_t)OLED_SCL_PIN) | (scl ? OLED_SCL_PIN : 0);
+    OLED_SDA_PORT->IDR = (OLED_SDA_PORT->IDR & ~(uint32_t)OLED_SDA_PIN) | (sda ? OLED_SDA_PIN : 0);
+}
+
+void GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_InitStruct)
+{
+    uint32_t index;
+    for (index = 0; index < 16; index++)
+    {
+        if (GPIO_InitStruct->GPIO_Pin & (1U << index))
+            GPIOx->MODER = (GPIOx->MODER & ~(3U << (index << 1))) | ((uint32_t)GPIO_InitStruct->GPIO_Mode << (index << 1));
+    }
+}
+
+void UTILS_InitCycleCounter(void)
+{
+}
+
+uint32_t UTILS_GetCycleCount(void)
+{
+    bus.cycles++;
+    BUS_Sync();
+    return bus.cycles;
+}
+
+void UTILS_DelayUs(uint32_t us)
+{
+    bus.cycles += us * (SystemCoreClock / 1000000);
+}
+
+void UTILS_DelayMs(uint32_t ms)
+{
+    UTILS_DelayUs(ms * 1000);
+}
+
+/**
+ * @brief Result of one step.
+ */
+typedef struct
+{
+    char name[32];
+    uint32_t transactions, bytes, clocks, busTimeUs;
+    uint32_t hash;
+} StepTypedef;
+
+static StepTypedef steps[MAX_STEPS];
+static int stepCount = 0;
+static int failures = 0;
+static const char *dumpPrefix = NULL;
+static OLED_HandleTypedef handle;
+
+/**
+ * @brief FNV-1a of the panel image.
+ */
+static uint32_t PanelHash(void)
+{
+    uint32_t hash = 2166136261U;
+    int x, y;
+    for (y = 0; y < PANEL_HEIGHT; y++)
+        for (x = 0; x < PANEL_WIDTH; x++)
+            hash = (hash ^ SSD1306_Pixel(x, y)) * 16777619U;
+    return hash;
+}
+
+/**
+ * @brief Write the panel image as a binary PGM.
+ */
+static void DumpFrame(const char *name)
+{
+    char path[256];
+    FILE *file;
+    int x, y;
+    snprintf(path, sizeof(path), "%s_%02d_%s.pgm", dumpPrefix, stepCount, name);
+    if ((file = fopen(path, "wb")) == NULL)
+    {
+        perror(path);
+        failures++;
+        return;
+    }
+    fprintf(file, "P5\n%d %d\n255\n", PANEL_WIDTH, PANEL_HEIGHT);
+    for (y = 0; y < PANEL_HEIGHT; y++)
+        for (x = 0; x < PANEL_WIDTH; x++)
+            fputc(SSD1306_Pixel(x, y) ? 255 : 0, file);
+    fclose(file);
+}
+
+/**
+ * @brief Start measuring a step.
+ */
+static void BeginStep(void)
+{
+    OLED_ResetStatistics();
+    bus.transactions = bus.bytes = bus.clocks = bus.busCycles = 0;
+}
+
+/**
+ * @brief Flush, check the panel and the counts, and record the step.
+ */
+static void EndStep(const char *name)
+{
+    OLED_StatisticsTypedef statistics;
+    StepTypedef *step = &steps[stepCount];
+    int x, y, wrong = 0;
+    if (OLED_Flush())
+    {
+        fprintf(stderr, "%s: OLED_Flush failed\n", name);
+        failures++;
+    }
+    OLED_GetStatistics(&statistics);
+    snprintf(step->name, sizeof(step->name), "%s", name);
+    step->transactions = bus.transactions;
+    step->bytes = bus.bytes;
+    step->clocks = bus.clocks;
+    step->busTimeUs = (uint32_t)((uint64_t)bus.busCycles * 1000000 / SystemCoreClock);
+    step->hash = PanelHash();
+    if (statistics.transactions != bus.transactions || statistics.bytes != bus.bytes || statistics.clocks != bus.clocks)
+    {
+        fprintf(stderr, "%s: driver counted %u/%u/%u, bus carried %u/%u/%u\n", name,
+                statistics.transactions, statistics.bytes, statistics.clocks, bus.transactions, bus.bytes, bus.clocks);
+        failures++;
+    }
+    if (oled.displayOn && !oled.scrolling)
+    {
+        for (y = 0; y < PANEL_HEIGHT; y++)
+            for (x = 0; x < PANEL_WIDTH; x++)
+                wrong += SSD1306_Pixel(x, y) != OLED_GetPixel(x, y);
+        if (wrong)
+        {
+            fprintf(stderr, "%s: %d pixels differ from the frame buffer\n", name, wrong);
+            failures++;
+        }
+    }
+    printf("%-12s %6u %6u %7u %8u  %08x\n", name, step->transactions, step->bytes, step->clocks, step->busTimeUs, step->hash);
+    if (dumpPrefix != NULL)
+        DumpFrame(name);
+    stepCount++;
+}
+
+/**
+ * @brief The scenario, one step per kind of driver call.
+ */
+static void RunScenario(void)
+{
+    static const uint8_t arrow[] = {0x18, 0x18, 0x18, 0x18, 0xFF, 0x7E, 0x3C, 0x18};
+    int i;
+    BeginStep();
+    OLED_Init(&handle);
+    EndStep("init");
+
+    BeginStep();
+    OLED_Clear(&handle);
+    EndStep("clear");
+
+    BeginStep();
+    handle.stringX = 0;
+    handle.stringY = 0;
+    OLED_DisplayFormat(&handle, "Speed %d rpm", 1234);
+    EndStep("format");
+
+    BeginStep();
+    handle.stringX = 0;
+    handle.stringY = 0;
+    handle.stringClear = ENABLE;
+    OLED_DisplayFormat(&handle, "Speed %d rpm", 987);
+    handle.stringClear = DISABLE;
+    EndStep("update");
+
+    BeginStep();
+    for (i = 0; i < 8; i++)
+    {
+        handle.stringX = 0;
+        handle.stringY = (uint8_t)i;
+        OLED_DisplayFormat(&handle, "ch%d %5d %3d%%", i, i * 1111, i * 12);
+    }
+    EndStep("dashboard");
+
+    BeginStep();
+    OLED_Clear(&handle);
+    EndStep("clear2");
+
+    BeginStep();
+    for (i = 0; i < 12; i++)
+    {
+        OLED_DisplayLog(&handle, "log line %d\r\n", i);
+        handle.stringContinuous = ENABLE;
+    }
+    EndStep("log");
+
+    BeginStep();
+    OLED_DisplayLog(&handle, "one more\r\n");
+    EndStep("log1");
+    handle.stringContinuous = DISABLE;
+
+    BeginStep();
+    OLED_DisplayPicture(0, 0, 128, 64, OLED_Picture1);
+    EndStep("picture");
+
+    BeginStep();
+    OLED_Clear(&handle);
+    OLED_DisplayText(0, 0, &OLED_Font8x16, "Hello, OLED", OLED_White);
+    OLED_DisplayText(4, 20, &OLED_Font6x8, "6x8 font", OLED_White);
+    EndStep("text");
+
+    BeginStep();
+    OLED_DrawLine(0, 63, 127, 32, OLED_White);
+    OLED_DrawRectangle(90, 2, 30, 20, OLED_White);
+    OLED_FillRectangle(92, 4, 10, 8, OLED_Invert);
+    OLED_DrawCircle(40, 45, 12, OLED_White);
+    OLED_FillCircle(70, 45, 6, OLED_White);
+    OLED_DrawBitmap(110, 40, 8, 8, arrow, OLED_White);
+    OLED_DrawPixel(127, 63, OLED_White);
+    EndStep("draw");
+
+    BeginStep();
+    OLED_DrawPixel(65, 30, OLED_Invert);
+    EndStep("pixel");
+
+    BeginStep();
+    OLED_StartScroll(0, 1, OLED_ScrollLeft, OLED_Scroll2Frames);
+    EndStep("scroll");
+
+    BeginStep();
+    OLED_StopScroll();
+    EndStep("scrollstop");
+
+    BeginStep();
+    OLED_TurnOff();
+    EndStep("off");
+
+    BeginStep();
+    OLED_TurnOn();
+    EndStep("on");
+
+    BeginStep();
+    EndStep("idle");
+}
+
+/**
+ * @brief Write the results as a baseline.
+ */
+static int WriteBaseline(const char *path)
+{
+    FILE *file = fopen(path, "w");
+    int i;
+    if (file == NULL)
+    {
+        perror(path);
+        return 1;
+    }
+    fprintf(file, "# step transactions bytes clocks busTimeUs hash, written by tools/oled_emu -w\n");
+    for (i = 0; i < stepCount; i++)
+        fprintf(file, "%s %u %u %u %u %08x\n", steps[i].name, steps[i].transactions, steps[i].bytes,
+                steps[i].clocks, steps[i].busTimeUs, steps[i].hash);
+    fclose(file);
+    return 0;
+}
+
+/**
+ * @brief Compare the results with a baseline.
+ * @return Number of regressions.
+ * @note Bus time follows the clocks and is not compared on its own.
+ */
+static int CheckBaseline(const char *path)
+{
+    FILE *file = fopen(path, "r");
+    char line[256], name[32];
+    unsigned int transactions, bytes, clocks, busTimeUs, hash;
+    int i, found, regressions = 0;
+    if (file == NULL)
+    {
+        perror(path);
+        return 1;
+    }
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        if (line[0] == '#' || sscanf(line, "%31s %u %u %u %u %x", name, &transactions, &bytes, &clocks, &busTimeUs, &hash) != 6)
+            continue;
+        for (i = 0, found = 0; i < stepCount && !found; i++)
+        {
+            if (strcmp(steps[i].name, name) != 0)
+                continue;
+            found = 1;
+            if (steps[i].transactions > transactions || steps[i].bytes > bytes || steps[i].clocks > clocks)
+            {
+                fprintf(stderr, "%s: costs %u/%u/%u, baseline %u/%u/%u\n", name, steps[i].transactions,
+                        steps[i].bytes, steps[i].clocks, transactions, bytes, clocks);
+                regressions++;
+            }
+            if (steps[i].hash != hash)
+            {
+                fprintf(stderr, "%s: frame %08x, baseline %08x\n", name, steps[i].hash, hash);
+                regressions++;
+            }
+        }
+        if (!found)
+        {
+            fprintf(stderr, "%s: step missing\n", name);
+            regressions++;
+        }
+    }
+    fclose(file);
+    return regressions;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *writePath = NULL, *checkPath = NULL;
+    int i;
+    for (i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-p") == 0 && i + 1 < argc)
+            dumpPrefix = argv[++i];
+        else if (strcmp(argv[i], "-w") == 0 && i + 1 < argc)
+            writePath = argv[++i];
+        else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc)
+            checkPath = argv[++i];
+        else
+        {
+            fprintf(stderr, "usage: oled_emu [-p prefix] [-w baseline.txt] [-c baseline.txt]\n");
+            return 1;
+        }
+    }
+    srand(1);
+    SSD1306_Reset();
+    bus.scl = bus.sda = 1;
+    printf("step         trans  bytes  clocks   bus us  frame\n");
+    RunScenario();
+    if (bus.nacks || bus.collisions || bus.unknownCommands)
+    {
+        fprintf(stderr, "bus errors: %u nack, %u collision, %u unknown command\n", bus.nacks, bus.collisions, bus.unknownCommands);
+        failures++;
+    }
+    if (writePath != NULL && WriteBaseline(writePath))
+        failures++;
+    if (checkPath != NULL)
+        failures += CheckBaseline(checkPath);
+    if (failures)
+        fprintf(stderr, "FAILED: %d\n", failures);
+    return failures ? 1 : 0;
+}
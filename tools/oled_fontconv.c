@@ -0,0 +1,371 @@
+/**
+ * @file    oled_fontconv.c
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2019/08/10
+ * @brief
+ *          Host tool converting BDF bitmap fonts to the font file format
+ *          read by user/oled/oled_fontfile.c.
+ * @note
+ *          Build on PC:
+ *              gcc -O2 -o oled_fontconv oled_fontconv.c
+ *          On systems without iconv, add -DOLED_FONTCONV_NO_ICONV and
+ *          convert fonts that are already in the wanted encoding only.
+ *
+ *          Usage:
+ *              oled_fontconv [options] input.bdf output.mwf
+ *              -s 8|16         Glyph height in pixels, 16 by default.
+ *              -w width        Maximum glyph width, 1~16, 16 by default.
+ *              -f              Fixed width, use the font bounding box width.
+ *              -e GBK|UTF8     Encoding of strings passed to OLED_DisplayText,
+ *                              must match OLED_TEXT_ENCODING. GBK by default.
+ *              -r first-last   Only keep codes in the range (hexadecimal, in
+ *                              the output encoding), may be given several times.
+ *
+ *          TrueType and OpenType fonts have to be rendered to BDF first,
+ *          e.g. otf2bdf -p 12 -r 72 font.ttf -o font.bdf
+ *
+ *          Then copy output.mwf to the SD card and open it by OLED_OpenFontFile.
+ *
+ *          The source code repository is available on GitHub:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#ifndef OLED_FONTCONV_NO_ICONV
+#include <iconv.h>
+#endif
+
+#define MAX_WIDTH       16
+#define MAX_RANGES      64
+#define LINE_SIZE       1024
+
+/**
+ * @brief A converted glyph.
+ */
+typedef struct
+{
+    uint32_t code;
+    uint8_t width;
+    uint8_t columns[MAX_WIDTH * 2];
+}Glyph;
+
+/**
+ * @brief A range of codes to keep.
+ */
+typedef struct
+{
+    uint32_t first;
+    uint32_t last;
+}CodeRange;
+
+static int height = 16;
+static int maxWidth = MAX_WIDTH;
+static int fixedWidth = 0;
+static int encodeGbk = 1;
+static CodeRange keepRanges[MAX_RANGES];
+static int keepRangeCount = 0;
+
+static Glyph *glyphs = NULL;
+static size_t glyphCount = 0;
+static size_t glyphCapacity = 0;
+
+/**
+ * @brief Print usage and exit.
+ */
+static void Usage(void)
+{
+    fprintf(stderr, "usage: oled_fontconv [-s 8|16] [-w width] [-f] [-e GBK|UTF8] [-r first-last]... input.bdf output.mwf\n");
+    exit(1);
+}
+
+/**
+ * @brief Convert a Unicode code point to a GBK code, (lead << 8 | trail) for double-byte characters.
+ * @return 0 if the character has no GBK code.
+ */
+static uint32_t UnicodeToGbk(uint32_t code)
+{
+#ifndef OLED_FONTCONV_NO_ICONV
+    static iconv_t converter = (iconv_t)-1;
+    uint8_t input[4], output[4];
+    char *in = (char *)input, *out = (char *)output;
+    size_t inLength = 4, outLength = 4;
+    if(code < 0x80)
+        return code;
+    if(converter == (iconv_t)-1)
+    {
+        converter = iconv_open("GBK", "UTF-32LE");
+        if(converter == (iconv_t)-1)
+        {
+            perror("iconv_open");
+            exit(1);
+        }
+    }
+    input[0] = code;
+    input[1] = code >> 8;
+    input[2] = code >> 16;
+    input[3] = code >> 24;
+    iconv(converter, NULL, NULL, NULL, NULL);
+    if(iconv(converter, &in, &inLength, &out, &outLength) == (size_t)-1)
+        return 0;
+    if(4 - outLength == 2)
+        return ((uint32_t)output[0] << 8) | output[1];
+    return 0;
+#else
+    return code < 0x80 ? code : 0;
+#endif
+}
+
+/**
+ * @brief Check whether the code should be kept.
+ */
+static int KeepCode(uint32_t code)
+{
+    int i;
+    if(keepRangeCount == 0)
+        return 1;
+    for(i = 0; i < keepRangeCount; i++)
+    {
+        if(code >= keepRanges[i].first && code <= keepRanges[i].last)
+            return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Append a glyph to the list.
+ */
+static Glyph *NewGlyph(void)
+{
+    if(glyphCount == glyphCapacity)
+    {
+        glyphCapacity = glyphCapacity ? glyphCapacity * 2 : 256;
+        glyphs = realloc(glyphs, glyphCapacity * sizeof(Glyph));
+        if(glyphs == NULL)
+        {
+            perror("realloc");
+            exit(1);
+        }
+    }
+    memset(&glyphs[glyphCount], 0, sizeof(Glyph));
+    return &glyphs[glyphCount++];
+}
+
+/**
+ * @brief Parse the BDF file and render its glyphs.
+ */
+static void ParseBdf(FILE *file)
+{
+    char line[LINE_SIZE];
+    int boxWidth = 0, boxHeight = 0, boxX = 0, boxY = 0;
+    int ascent = -1, descent = -1, gb2312 = 0;
+    int encoding = -1, deviceWidth = 0, width = 0, rows = 0, x = 0, y = 0;
+    int row = -1, top, baseline, column, cellRow, i;
+    unsigned long bits;
+    uint32_t code;
+    Glyph *glyph = NULL;
+
+    while(fgets(line, sizeof(line), file) != NULL)
+    {
+        if(row >= 0 && strncmp(line, "ENDCHAR", 7) != 0)
+        {
+            //One row of the glyph bitmap in hexadecimal, MSB is the leftmost pixel.
+            if(glyph != NULL)
+            {
+                bits = strtoul(line, NULL, 16);
+                top = (height - ascent - descent) / 2;
+                baseline = top + ascent;
+                cellRow = baseline - (y + rows) + row;
+                for(i = 0; i < width && cellRow >= 0 && cellRow < height; i++)
+                {
+                    column = x + i;
+                    if(column < 0 || column >= glyph->width)
+                        continue;
+                    if(bits & (1ul << (((width + 7) & ~7) - 1 - i)))
+                        glyph->columns[(cellRow >> 3) * glyph->width + column] |= 1 << (cellRow & 7);
+                }
+            }
+            row++;
+            continue;
+        }
+        if(sscanf(line, "FONTBOUNDINGBOX %d %d %d %d", &boxWidth, &boxHeight, &boxX, &boxY) == 4)
+            continue;
+        if(sscanf(line, "FONT_ASCENT %d", &ascent) == 1 || sscanf(line, "FONT_DESCENT %d", &descent) == 1)
+            continue;
+        if(strncmp(line, "CHARSET_REGISTRY", 16) == 0)
+        {
+            gb2312 = strstr(line, "GB2312") != NULL;
+            continue;
+        }
+        if(strncmp(line, "STARTCHAR", 9) == 0)
+        {
+            encoding = -1;
+            deviceWidth = boxWidth;
+            width = rows = x = y = 0;
+            continue;
+        }
+        if(sscanf(line, "ENCODING %d", &encoding) == 1 || sscanf(line, "DWIDTH %d", &deviceWidth) == 1)
+            continue;
+        if(sscanf(line, "BBX %d %d %d %d", &width, &rows, &x, &y) == 4)
+            continue;
+        if(strncmp(line, "BITMAP", 6) == 0)
+        {
+            if(ascent < 0)
+                ascent = boxHeight + boxY;
+            if(descent < 0)
+                descent = -boxY;
+            row = 0;
+            glyph = NULL;
+            if(encoding < 0)
+                continue;
+            if(gb2312)
+                code = encoding < 0x80 ? (uint32_t)encoding : ((uint32_t)encoding | 0x8080);
+            else if(encodeGbk)
+                code = UnicodeToGbk(encoding);
+            else
+                code = encoding;
+            if((code == 0 && encoding != 0) || !KeepCode(code))
+                continue;
+            glyph = NewGlyph();
+            glyph->code = code;
+            i = fixedWidth ? boxWidth : (deviceWidth > x + width ? deviceWidth : x + width);
+            glyph->width = i < 1 ? 1 : (i > maxWidth ? maxWidth : i);
+            continue;
+        }
+        if(strncmp(line, "ENDCHAR", 7) == 0)
+        {
+            row = -1;
+            glyph = NULL;
+        }
+    }
+}
+
+/**
+ * @brief Compare glyphs by code for qsort.
+ */
+static int CompareGlyphs(const void *a, const void *b)
+{
+    uint32_t codeA = ((const Glyph *)a)->code, codeB = ((const Glyph *)b)->code;
+    return codeA < codeB ? -1 : codeA > codeB;
+}
+
+/**
+ * @brief Write a 32-bit number in little-endian.
+ */
+static void PutUint32(FILE *file, uint32_t value)
+{
+    fputc(value & 0xFF, file);
+    fputc((value >> 8) & 0xFF, file);
+    fputc((value >> 16) & 0xFF, file);
+    fputc((value >> 24) & 0xFF, file);
+}
+
+/**
+ * @brief Write the font file.
+ */
+static void WriteFontFile(FILE *file)
+{
+    size_t i, j, unique = 0, rangeCount = 0;
+    uint8_t slotWidth = 1, page;
+
+    qsort(glyphs, glyphCount, sizeof(Glyph), CompareGlyphs);
+    for(i = 0; i < glyphCount; i++)//Drop duplicated codes, keep the first one.
+    {
+        if(unique && glyphs[unique - 1].code == glyphs[i].code)
+            continue;
+        glyphs[unique++] = glyphs[i];
+    }
+    glyphCount = unique;
+    for(i = 0; i < glyphCount; i++)
+    {
+        if(glyphs[i].width > slotWidth)
+            slotWidth = glyphs[i].width;
+        if(i == 0 || glyphs[i].code != glyphs[i - 1].code + 1)
+            rangeCount++;
+    }
+    if(rangeCount > 0xFFFF)
+    {
+        fprintf(stderr, "too many code ranges\n");
+        exit(1);
+    }
+
+    fwrite("MWF1", 1, 4, file);
+    fputc(height, file);
+    fputc(slotWidth, file);
+    fputc(rangeCount & 0xFF, file);
+    fputc(rangeCount >> 8, file);
+    PutUint32(file, glyphCount);
+    PutUint32(file, 16 + rangeCount * 12);
+    for(i = 0; i < glyphCount; i = j)
+    {
+        for(j = i + 1; j < glyphCount && glyphs[j].code == glyphs[j - 1].code + 1; j++);
+        PutUint32(file, glyphs[i].code);
+        PutUint32(file, j - i);
+        PutUint32(file, i);
+    }
+    for(i = 0; i < glyphCount; i++)
+    {
+        fputc(glyphs[i].width, file);
+        for(page = 0; page < height / 8; page++)
+        {
+            fwrite(glyphs[i].columns + page * glyphs[i].width, 1, glyphs[i].width, file);
+            for(j = glyphs[i].width; j < slotWidth; j++)
+                fputc(0, file);
+        }
+    }
+    printf("%lu glyphs, %lu ranges, %d x %d slots\n", (unsigned long)glyphCount, (unsigned long)rangeCount, slotWidth, height);
+}
+
+int main(int argc, char *argv[])
+{
+    FILE *input, *output;
+    int i;
+
+    for(i = 1; i < argc && argv[i][0] == '-'; i++)
+    {
+        if(strcmp(argv[i], "-f") == 0)
+            fixedWidth = 1;
+        else if(i + 1 >= argc)
+            Usage();
+        else if(strcmp(argv[i], "-s") == 0)
+            height = atoi(argv[++i]);
+        else if(strcmp(argv[i], "-w") == 0)
+            maxWidth = atoi(argv[++i]);
+        else if(strcmp(argv[i], "-e") == 0)
+            encodeGbk = strcmp(argv[++i], "UTF8") != 0;
+        else if(strcmp(argv[i], "-r") == 0 && keepRangeCount < MAX_RANGES
+                && sscanf(argv[++i], "%x-%x", &keepRanges[keepRangeCount].first, &keepRanges[keepRangeCount].last) == 2)
+            keepRangeCount++;
+        else
+            Usage();
+    }
+    if(argc - i != 2 || (height != 8 && height != 16) || maxWidth < 1 || maxWidth > MAX_WIDTH)
+        Usage();
+
+    input = fopen(argv[i], "r");
+    if(input == NULL)
+    {
+        perror(argv[i]);
+        return 1;
+    }
+    ParseBdf(input);
+    fclose(input);
+
+    output = fopen(argv[i + 1], "wb");
+    if(output == NULL)
+    {
+        perror(argv[i + 1]);
+        return 1;
+    }
+    WriteFontFile(output);
+    fclose(output);
+    return 0;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file    ahrs.h
+ * @author  Miaow
+ * @version 0.2.0
+ * @date    2019/08/30
+ * @brief
+ *          This file provides attitude fusion algorithms of AHRS (Attitude and Heading Reference System):
+ *              1. Mahony complementary filter
+ *              2. Madgwick gradient descent filter
+ *              3. Gyroscope and accelerometer, with optional magnetometer
+ *              4. Quaternion, rotation matrix and Euler angle output
+ *              5. Fast single precision quaternion to Euler angle conversion
+ * @note
+ *          Minimum version of source file:
+ *              0.2.0
+ *          Usage:
+ *              static AHRS_InfoTypeDef ahrs;
+ *              AHRS_Init(&ahrs, AHRS_MAHONY);
+ *              AHRS_Update(&ahrs, gyro, accel, NULL, 0.001f);
+ *              AHRS_GetEuler(&ahrs, &pitch, &roll, &yaw);
+ *          Euler angles follow the same convention as the DMP output of mpu6050.c.
+ *          Define AHRS_HOST to build ahrs.c on PC without CMSIS-DSP, see tools/ahrs_replay.c.
+ *
+ *          The source code repository is available on GitHub:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#ifndef __AHRS_H
+#define __AHRS_H
+#include "stdint.h"
+
+/**
+ * @defgroup AHRS
+ * @brief Attitude fusion modules
+ * @{
+ */
+
+/**
+ * @defgroup AHRS_config
+ * @{
+ */
+
+#define AHRS_MAHONY_KP                0.5f //!< Default proportional gain of Mahony filter.
+#define AHRS_MAHONY_KI                0.0f //!< Default integral gain of Mahony filter, non-zero to estimate gyroscope bias.
+#define AHRS_MADGWICK_BETA            0.1f //!< Default gain of Madgwick filter, about sqrt(3/4) times the gyroscope noise in rad/s.
+
+/**
+ * @}
+ */
+
+typedef enum {
+  AHRS_MAHONY = 0,
+  AHRS_MADGWICK
+}AHRS_AlgorithmTypeDef;
+
+typedef struct {
+  AHRS_AlgorithmTypeDef algorithm; //!< Fusion algorithm.
+  float q[4]; //!< Orientation quaternion w, x, y, z, rotates the earth frame into the body frame.
+  float kp, ki; //!< Mahony gains.
+  float beta; //!< Madgwick gain.
+  float integral[3]; //!< Mahony integral feedback in rad/s.
+}AHRS_InfoTypeDef;
+
+void AHRS_Init(AHRS_InfoTypeDef* ahrsInfo, AHRS_AlgorithmTypeDef algorithm);
+void AHRS_SetParameters(AHRS_InfoTypeDef* ahrsInfo, float kp, float ki, float beta);
+void AHRS_Update(AHRS_InfoTypeDef* ahrsInfo, const float gyro[3], const float accel[3], const float mag[3], float dt);
+void AHRS_GetQuaternion(const AHRS_InfoTypeDef* ahrsInfo, float q[4]);
+void AHRS_GetEuler(const AHRS_InfoTypeDef* ahrsInfo, float* pitch, float* roll, float* yaw);
+void AHRS_QuaternionToEuler(const float q[4], float* pitch, float* roll, float* yaw);
+void AHRS_QuaternionToMatrix(const float q[4], float r[9]);
+
+/**
+ * @}
+ */
+
+#endif
@@ -1,7 +1,7 @@
 /**
  * @file    bmp280.c
  * @author  Miaow
- * @version 0.1.0
+ * @version 0.2.0
  * @date    2019/07/07
  * @brief   
  *          This file provides bsp functions to manage the following 
@@ -9,9 +9,10 @@
  *              1. Communicate using I2C
  *              2. Initialization and Configuration
  *              3. Measure and read out temperature and pressure
+ *              4. Stream timestamped samples in normal mode with integer compensation
  * @note     
  *          Minimum version of header file:
- *              0.1.0
+ *              0.2.0
  *          
  *          Pin connection(defined in iic.h):
  *               
@@ -31,6 +32,7 @@
  */
 #include "bmp280.h"
 #include "bsp_iic.h"
+#include "bsp_iic_sched.h"
 
 //Chip IDs for samples and mass production parts.
 #define BMP280_CHIP_ID1                 0x56
@@ -203,9 +205,11 @@ struct
   int32_t t_fine;
 }BMP280_CalibrationParameters;
 
+static IIC_SCHED_DeviceTypedef bmp280Device = IIC_SCHED_DEVICE(BMP280_DEVICE_ADDR, 2, 1); //!< Streaming reads queue behind the IMU.
+
 /**
  * @brief Perform a software reset.
- * @return Result of execution, see @ref DRV8825_return_status .
+ * @return Result of execution, see @ref BMP280_return_status .
  */
 static inline uint8_t BMP280_SoftReset()
 {
@@ -222,7 +226,7 @@ static inline uint8_t BMP280_SoftReset()
 /**
  * @brief This function is used to read the calibration parameters used
  * for calculating the compensated data.
- * @return Result of execution, see @ref DRV8825_return_status .
+ * @return Result of execution, see @ref BMP280_return_status .
  */
 static uint8_t BM280_GetCalibrationParameters()
 {
@@ -255,7 +259,7 @@ static uint8_t BM280_GetCalibrationParameters()
  * @param mode Power mode.
  * @param coefficient The coefficient of the pressure IIR filter.
  * @time time Standby time.
- * @return Result of execution, see @ref DRV8825_return_status .
+ * @return Result of execution, see @ref BMP280_return_status .
  */
 static inline uint8_t BMP280_SetSettings(
   BMP280_OverSampling temperature,
@@ -269,8 +273,11 @@ static inline uint8_t BMP280_SetSettings(
   uint8_t data1 = ((uint8_t)temperature << 5) | ((uint8_t)pressure << 2) | (uint8_t)mode;
   uint8_t data2 = ((uint8_t)time << 5) | ((uint8_t)coefficient << 2);
 
-  result1 = IIC_WriteRegByte(BMP280_DEVICE_ADDR, BMP280_CTRL_MEAS_ADDR, data1);
+  //Writes to the config register in normal mode may be ignored, so go to sleep mode first.
+  result1 = IIC_WriteRegByte(BMP280_DEVICE_ADDR, BMP280_CTRL_MEAS_ADDR, data1 & ~(uint8_t)BMP280_NORMAL_MODE);
   result2 = IIC_WriteRegByte(BMP280_DEVICE_ADDR, BMP280_CONFIG_ADDR, data2);
+  if (result1 == BMP280_OK && result2 == BMP280_OK && mode != BMP280_SLEEP_MODE)
+    result1 = IIC_WriteRegByte(BMP280_DEVICE_ADDR, BMP280_CTRL_MEAS_ADDR, data1);
   if (result1 == BMP280_OK && result2 == BMP280_OK)
     return BMP280_OK;
   return BMP280_ERROR;
@@ -278,55 +285,81 @@ static inline uint8_t BMP280_SetSettings(
 
 /**
  * @brief This function is used to get the compensated temperature from
- * uncompensated temperature.
+ * uncompensated temperature, and updates t_fine for pressure compensation.
  * @param uncompensatedTemperature Raw temperature values from the sensor.
- * @return Compensated temperature.
+ * @return Compensated temperature in 0.01 degrees Celsius, e.g. 5123 for 51.23.
+ * @note 32-bit integer formula from the datasheet.
  */
-static float BMP280_GetCompensatedTemperature(int32_t uncompensatedTemperature)
+static int32_t BMP280_GetCompensatedTemperature(int32_t uncompensatedTemperature)
 {
-  float var1, var2;
-
-  var1 = (((float)uncompensatedTemperature) / 16384.0f - ((float)BMP280_CalibrationParameters.dig_t1) / 1024.0f) *
-    ((float)BMP280_CalibrationParameters.dig_t2);
-  var2 =
-    ((((float)uncompensatedTemperature) / 131072.0f - ((float)BMP280_CalibrationParameters.dig_t1) / 8192.0f) *
-    (((float)uncompensatedTemperature) / 131072.0f - ((float)BMP280_CalibrationParameters.dig_t1) / 8192.0f)) *
-      ((float)BMP280_CalibrationParameters.dig_t3);
-  return ((var1 + var2) / 5120.0f);
+  int32_t var1, var2;
+
+  var1 = ((((uncompensatedTemperature >> 3) - ((int32_t)BMP280_CalibrationParameters.dig_t1 << 1))) *
+    ((int32_t)BMP280_CalibrationParameters.dig_t2)) >> 11;
+  var2 = (((((uncompensatedTemperature >> 4) - ((int32_t)BMP280_CalibrationParameters.dig_t1)) *
+    ((uncompensatedTemperature >> 4) - ((int32_t)BMP280_CalibrationParameters.dig_t1))) >> 12) *
+    ((int32_t)BMP280_CalibrationParameters.dig_t3)) >> 14;
+  BMP280_CalibrationParameters.t_fine = var1 + var2;
+  return (BMP280_CalibrationParameters.t_fine * 5 + 128) >> 8;
 }
 
 /**
  * @brief This function is used to get the compensated pressure from
- * uncompensated pressure. This API uses floating precision.
+ * uncompensated pressure.
  * @param uncompensatedPressure Raw pressure values from the sensor.
- * @return Compensated pressure.
+ * @return Compensated pressure in Pa as unsigned Q24.8, e.g. 24674867 for 24674867 / 256 = 96386.2 Pa.
+ * @note 64-bit integer formula from the datasheet.
+ * Call @ref BMP280_GetCompensatedTemperature first to update t_fine.
  */
-static float BMP280_GetCompensatedPressure(int32_t uncompensatedPressure)
+static uint32_t BMP280_GetCompensatedPressure(int32_t uncompensatedPressure)
 {
-  float var1, var2;
-
-  var1 = ((float)BMP280_CalibrationParameters.t_fine / 2.0f) - 64000.0f;
-  var2 = var1 * var1 * ((float)BMP280_CalibrationParameters.dig_p6) / 32768.0f;
-  var2 = var2 + var1 * ((float)BMP280_CalibrationParameters.dig_p5) * 2.0f;
-  var2 = (var2 / 4.0f) + (((float)BMP280_CalibrationParameters.dig_p4) * 65536.0f);
-  var1 =
-    (((float)BMP280_CalibrationParameters.dig_p3) * var1 * var1 / 524288.0f + ((float)BMP280_CalibrationParameters.dig_p2) * var1) /
-    524288.0f;
-  var1 = (1.0f + var1 / 32768.0f) * ((float)BMP280_CalibrationParameters.dig_p1);
-  uncompensatedPressure = (uint32_t)(1048576.0f - (float)uncompensatedPressure);
-  if (var1 < 0 || var1 > 0)
-  {
-    uncompensatedPressure = (uint32_t)((uncompensatedPressure - (var2 / 4096.0f)) * 6250.0f / var1);
-    var1 = ((float)BMP280_CalibrationParameters.dig_p9) * uncompensatedPressure * uncompensatedPressure / 2147483648.0f;
-    var2 = uncompensatedPressure * ((float)BMP280_CalibrationParameters.dig_p8) / 32768.0f;
-    return uncompensatedPressure + (var1 + var2 + ((float)BMP280_CalibrationParameters.dig_p7)) / 16.0f;
-  }
-  return 0.0f;
+  int64_t var1, var2, p;
+
+  var1 = ((int64_t)BMP280_CalibrationParameters.t_fine) - 128000;
+  var2 = var1 * var1 * (int64_t)BMP280_CalibrationParameters.dig_p6;
+  var2 = var2 + ((var1 * (int64_t)BMP280_CalibrationParameters.dig_p5) << 17);
+  var2 = var2 + (((int64_t)BMP280_CalibrationParameters.dig_p4) << 35);
+  var1 = ((var1 * var1 * (int64_t)BMP280_CalibrationParameters.dig_p3) >> 8) +
+    ((var1 * (int64_t)BMP280_CalibrationParameters.dig_p2) << 12);
+  var1 = (((((int64_t)1) << 47) + var1)) * ((int64_t)BMP280_CalibrationParameters.dig_p1) >> 33;
+  if (var1 == 0)
+    return 0;//Avoid exception caused by division by zero.
+  p = 1048576 - uncompensatedPressure;
+  p = (((p << 31) - var2) * 3125) / var1;
+  var1 = (((int64_t)BMP280_CalibrationParameters.dig_p9) * (p >> 13) * (p >> 13)) >> 25;
+  var2 = (((int64_t)BMP280_CalibrationParameters.dig_p8) * p) >> 19;
+  p = ((p + var1 + var2) >> 8) + (((int64_t)BMP280_CalibrationParameters.dig_p7) << 4);
+  return (uint32_t)p;
+}
+
+/**
+ * @brief Convert a burst read of 0xF7..0xFC to compensated values.
+ * @param data 6 bytes read from BMP280_PRES_MSB_ADDR.
+ * @param pressure Compensated pressure in Pa as unsigned Q24.8.
+ * @param temperature Compensated temperature in 0.01 degrees Celsius.
+ */
+static void BMP280_Compensate(const uint8_t *data, uint32_t *pressure, int32_t *temperature)
+{
+  int32_t rawPressure = (int32_t)((((uint32_t)(data[0])) << 12) | (((uint32_t)(data[1])) << 4) | ((uint32_t)data[2] >> 4));
+  int32_t rawTemperature = (int32_t)((((uint32_t)(data[3])) << 12) | (((uint32_t)(data[4])) << 4) | ((uint32_t)data[5] >> 4));
+  *temperature = BMP280_GetCompensatedTemperature(rawTemperature);
+  *pressure = BMP280_GetCompensatedPressure(rawPressure);
+}
+
+/**
+ * @brief Maximum time of one measurement in microseconds.
+ * @note See the datasheet, chapter 3.8.1.
+ */
+static uint32_t BMP280_GetMeasurementTimeUs()
+{
+  uint32_t temperature = BMP280_TEMPERATURE_OVER_SAMPLING ? 1 << (BMP280_TEMPERATURE_OVER_SAMPLING - 1) : 0;
+  uint32_t pressure = BMP280_PRESSURE_OVER_SAMPLING ? 1 << (BMP280_PRESSURE_OVER_SAMPLING - 1) : 0;
+  return 1250 + 2300 * temperature + (pressure ? 2300 * pressure + 575 : 0);
 }
 
 /**
  * @brief Initialize the BMP280 with the settings in the header file.
- * @return Result of execution, see @ref DRV8825_return_status .
+ * @return Result of execution, see @ref BMP280_return_status .
  */
 uint8_t BMP280_Init()
 {
@@ -335,6 +368,7 @@ uint8_t BMP280_Init()
   uint8_t result;
   __IO uint32_t i;
   IIC_Init();
+  UTILS_InitCycleCounter();
   while (tryCount--)
   {
     chipId = IIC_ReadRegByte(BMP280_DEVICE_ADDR, BMP280_CHIP_ID_ADDR);
@@ -350,7 +384,7 @@ uint8_t BMP280_Init()
           BMP280IIR_FILTER,
           BMP280_STANDBY_TIME);
       if (result == BMP280_OK)
-        break;
+        return BMP280_OK;
     }
 
     //10ms
@@ -364,25 +398,28 @@ uint8_t BMP280_Init()
 
 /**
  * @brief Start a measurement and wait for completion.
- * @return Result of execution, see @ref DRV8825_return_status .
+ * @return Result of execution, see @ref BMP280_return_status .
  * @note This function can only be called in forced mode.
- * @warning The program may be blocked if the BMP280 never 
- * set the flag of completion or the communication failed.
+ * Gives up after twice the maximum measurement time if the BMP280 never
+ * clears the flag of measuring or the communication failed.
  */
 uint8_t BMP280_PerformMeasurement()
 {
-  uint8_t result;
+  uint8_t result, status;
+  uint32_t start, timeout = BMP280_GetMeasurementTimeUs() * 2 * (SystemCoreClock / 1000000);
   uint8_t data = ((uint8_t)BMP280_TEMPERATURE_OVER_SAMPLING << 5) | 
   ((uint8_t)BMP280_PRESSURE_OVER_SAMPLING << 2) | 
   (uint8_t)BMP280_MODE;
   
   result = IIC_WriteRegByte(BMP280_DEVICE_ADDR, BMP280_CTRL_MEAS_ADDR, data);
-
-  if (result == BMP280_OK)
+  if (result != BMP280_OK)
+    return BMP280_ERROR;
+  start = UTILS_GetCycleCount();
+  do
   {
-    while (IIC_ReadRegByte(BMP280_DEVICE_ADDR, BMP280_STATUS_ADDR) & 0x08);
-    return BMP280_OK;
-  }
+    if (IIC_ReadRegBytes(BMP280_DEVICE_ADDR, BMP280_STATUS_ADDR, 1, &status) == BMP280_OK && !(status & 0x08))
+      return BMP280_OK;
+  } while (UTILS_GetCycleCount() - start < timeout);
   return BMP280_ERROR;
 }
 
@@ -398,63 +435,120 @@ float BMP280_GetTemperature()
 {
   uint8_t result;
   uint8_t temperature[3] = { 0 };
-  float tmp;
+  int32_t tmp;
 
   result = IIC_ReadRegBytes(BMP280_DEVICE_ADDR, BMP280_TEMP_MSB_ADDR, 3, temperature);
   if (result == BMP280_OK)
   {
     tmp = (int32_t)((((int32_t)(temperature[0])) << 12) | (((int32_t)(temperature[1])) << 4) | (((int32_t)(temperature[2])) >> 4));
-    return BMP280_GetCompensatedTemperature(tmp);
+    return BMP280_GetCompensatedTemperature(tmp) / 100.0f;
   }
   return 999.9f;
 }
 
 /**
- * @brief Get pressure in hPa.
+ * @brief Get pressure in Pa.
  * @return Pressure.
  * @note This function reads out the data of pressure measured last time.
  * To get the realtime pressure, the chip needs to be set to the force mode 
  * to start and complete a measurement(see @ref BMP280_PerformMeasurement) 
  * before the data is read when the continuous measuring is off.
+ * Temperature is read in the same burst for compensation.
  */
 float BMP280_GetPressure()
 {
-  uint8_t result;
-  uint8_t pressure[3] = { 0 };
-  float tmp;
+  float pressure, temperature;
 
-  result = IIC_ReadRegBytes(BMP280_DEVICE_ADDR, BMP280_PRES_MSB_ADDR, 3, pressure);
-  if (result == BMP280_OK)
-  {
-    tmp = (int32_t)((((int32_t)(pressure[0])) << 12) | (((int32_t)(pressure[1])) << 4) | (((int32_t)(pressure[2])) >> 4));
-    return BMP280_GetCompensatedPressure(tmp);
-  }
+  if (BMP280_GetTemperatureAndPressure(&pressure, &temperature) == BMP280_OK)
+    return pressure;
   return 0.0f;
 }
 
 /**
- * @brief Get pressure in hPa and temperature in Celsius degree.
- * @param pressure This pointer outputs pressure in hPa.
+ * @brief Get pressure in Pa and temperature in Celsius degree.
+ * @param pressure This pointer outputs pressure in Pa.
  * @param temperature This pointer outputs temperature in Celsius degree.
- * @return Result of execution, see @ref DRV8825_return_status .
+ * @return Result of execution, see @ref BMP280_return_status .
  * @note This function reads out the data of pressure and temperature measured last time.
  * Which means the chip needs to be set to the force mode to perform and complete a measurement 
  * before the data is read when the continuous measuring is off.
+ * The outputs are not changed on error.
  */
 uint8_t BMP280_GetTemperatureAndPressure(float* pressure, float* temperature)
 {
   uint8_t result;
   int32_t tmpTemperature;
-  int32_t tmpPressure;
+  uint32_t tmpPressure;
   uint8_t temp[6] = { 0 };
 
   result = IIC_ReadRegBytes(BMP280_DEVICE_ADDR, BMP280_PRES_MSB_ADDR, 6, temp);
   if (result == BMP280_OK)
   {
-    tmpPressure = (int32_t)((((uint32_t)(temp[0])) << 12) | (((uint32_t)(temp[1])) << 4) | ((uint32_t)temp[2] >> 4));
-    tmpTemperature = (int32_t)((((int32_t)(temp[3])) << 12) | (((int32_t)(temp[4])) << 4) | (((int32_t)(temp[5])) >> 4));
+    BMP280_Compensate(temp, &tmpPressure, &tmpTemperature);
+    *pressure = tmpPressure / 256.0f;
+    *temperature = tmpTemperature / 100.0f;
   }
-  *pressure = BMP280_GetCompensatedPressure(tmpPressure);
-  *temperature = BMP280_GetCompensatedTemperature(tmpTemperature);
   return result;
 }
+
+/**
+ * @brief Put the BMP280 in normal mode, it measures every @ref BMP280_GetSamplePeriodUs
+ * with the oversampling, filter and standby time in the header file.
+ * @return Result of execution, see @ref BMP280_return_status .
+ * @note Read the results with @ref BMP280_ReadSample , no need to start each measurement.
+ */
+uint8_t BMP280_StartStreaming()
+{
+  IIC_SCHED_Init();
+  return BMP280_SetSettings(BMP280_TEMPERATURE_OVER_SAMPLING,
+    BMP280_PRESSURE_OVER_SAMPLING,
+    BMP280_NORMAL_MODE,
+    BMP280IIR_FILTER,
+    BMP280_STANDBY_TIME);
+}
+
+/**
+ * @brief Put the BMP280 back to sleep mode.
+ * @return Result of execution, see @ref BMP280_return_status .
+ */
+uint8_t BMP280_StopStreaming()
+{
+  uint8_t data = ((uint8_t)BMP280_TEMPERATURE_OVER_SAMPLING << 5) | 
+  ((uint8_t)BMP280_PRESSURE_OVER_SAMPLING << 2) | 
+  (uint8_t)BMP280_SLEEP_MODE;
+  return IIC_WriteRegByte(BMP280_DEVICE_ADDR, BMP280_CTRL_MEAS_ADDR, data);
+}
+
+/**
+ * @brief Time between two measurements in normal mode in microseconds.
+ * @return Maximum measurement time plus standby time.
+ * @note Reading faster than this returns the same measurement again.
+ */
+uint32_t BMP280_GetSamplePeriodUs()
+{
+  static const uint32_t standbyUs[8] = { 500, 62500, 125000, 250000, 500000, 1000000, 2000000, 4000000 };
+  return BMP280_GetMeasurementTimeUs() + standbyUs[BMP280_STANDBY_TIME];
+}
+
+/**
+ * @brief Read the latest measurement with one burst of 0xF7..0xFC.
+ * @param sample Outputs the timestamped sample, not changed on error.
+ * @return Result of execution, see @ref BMP280_return_status .
+ * @note Never polls the status register. The burst keeps pressure and
+ * temperature of the same measurement, see the datasheet, chapter 3.9.
+ * The burst is queued on the IIC scheduler behind more urgent devices.
+ * The timestamp is taken when the read starts, not when the chip measured.
+ * The registers hold the last finished measurement, so the timestamp can
+ * trail it by up to @ref BMP280_GetSamplePeriodUs .
+ */
+uint8_t BMP280_ReadSample(BMP280_Sample *sample)
+{
+  uint8_t data[6];
+  uint32_t timestamp = UTILS_GetCycleCount();
+
+  if (IIC_SCHED_ReadRegBytes(&bmp280Device, BMP280_PRES_MSB_ADDR, 6, data) != BMP280_OK)
+    return BMP280_ERROR;
+  BMP280_Compensate(data, &sample->pressure, &sample->temperature);
+  sample->timestamp = timestamp;
+  return BMP280_OK;
+}
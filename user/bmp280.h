@@ -1,7 +1,7 @@
 /**
  * @file    bmp280.h
  * @author  Miaow
- * @version 0.1.0
+ * @version 0.2.0
  * @date    2019/07/07
  * @brief   
  *          This file provides bsp functions to manage the following 
@@ -9,9 +9,10 @@
  *              1. Communicate using I2C
  *              2. Initialization and Configuration
  *              3. Measure and read out temperature and pressure
+ *              4. Stream timestamped samples in normal mode with integer compensation
  * @note     
  *          Minimum version of source file:
- *              0.1.0
+ *              0.2.0
  *          
  *          Pin connection(defined in iic.h):
  *               
@@ -36,15 +37,15 @@
 #include "utils.h"
 
 /** 
- * @defgroup DMP280
- * @brief DMP280 driver
+ * @defgroup BMP280
+ * @brief BMP280 driver
  * @{
  */
  
 #define BMP280_DEVICE_ADDR              0x76 //!< I2C address of the chip.
 
 /** 
- * @defgroup DRV8825_configuration
+ * @defgroup BMP280_configuration
  * @brief Uncomment one of the macro define to use the preset parameters.
  * See the datasheet for details.
  * @{
@@ -72,7 +73,7 @@
 #endif
 
 /** 
- * @defgroup DRV8825_return_status
+ * @defgroup BMP280_return_status
  * @{
  */
 #define BMP280_OK                       0
@@ -81,11 +82,25 @@
  * @}
  */
 
+/**
+ * @brief A compensated measurement.
+ */
+typedef struct
+{
+  uint32_t timestamp; //!< Core clock cycles when the sample was read, see UTILS_GetCycleCount. Up to one BMP280_GetSamplePeriodUs after the measurement.
+  int32_t temperature; //!< Temperature in 0.01 degrees Celsius.
+  uint32_t pressure; //!< Pressure in Pa as unsigned Q24.8, i.e. pressure / 256.0f Pa.
+}BMP280_Sample;
+
 uint8_t BMP280_Init(void);
 float BMP280_GetTemperature(void);
 float BMP280_GetPressure(void);
 uint8_t BMP280_GetTemperatureAndPressure(float* pressure, float* temperature);
 uint8_t BMP280_PerformMeasurement(void);
+uint8_t BMP280_StartStreaming(void);
+uint8_t BMP280_StopStreaming(void);
+uint32_t BMP280_GetSamplePeriodUs(void);
+uint8_t BMP280_ReadSample(BMP280_Sample *sample);
 
 /**
  * @}
@@ -1,7 +1,7 @@
 /**
  * @file    bsp_iic.c
  * @author  Miaow
- * @version 0.1.0
+ * @version 0.5.0
  * @date    2018/08/30
  * @brief
  *          This file provides functions to manage the following
@@ -9,9 +9,16 @@
  *              1. Initialization
  *              2. Write and read one byte
  *              3. Write and read registers of slave
+ *              4. Software IIC engine shared by drivers, one descriptor per bus,
+ *                 SCL timing calibrated by the DWT cycle counter, lock-step
+ *                 reads of several buses on one GPIO port
+ *              5. Hardware I2C1 with interrupt and DMA, blocking and asynchronous
+ *                 register access
+ *              6. Optional trace of every transfer to a RAM ring buffer, dumped
+ *                 over the serial port and decoded by tools/iic_tracedec.c
  * @note
  *          Minimum version of header file:
- *              0.1.0
+ *              0.5.0
  *          Pin connection:
  *               
  *               PB8SCL     
@@ -29,45 +36,951 @@
  */
 
 #include "bsp_iic.h"
+#ifndef IIC_HOST
 #include "utils.h"
+#endif
 
- /**
-  * @brief ûнյӦźţ򷵻1
-  */
-#define IIC_IF_NOT_ACK_RETURN_1     if(IIC_WaitAck()) {IIC_Stop(); return 1;}
+#ifndef IIC_HOST
+#define IIC_SCL_1(bus)      (bus)->sclPort->BSRRL = (bus)->sclPin
+#define IIC_SCL_0(bus)      (bus)->sclPort->BSRRH = (bus)->sclPin
+#define IIC_SDA_1(bus)      (bus)->sdaPort->BSRRL = (bus)->sdaPin
+#define IIC_SDA_0(bus)      (bus)->sdaPort->BSRRH = (bus)->sdaPin
+#else
+#define IIC_SCL_1(bus)      (bus)->sclPort->ODR |= (bus)->sclPin//PCϵļĴڴ, дBSRRụา
+#define IIC_SCL_0(bus)      (bus)->sclPort->ODR &= ~(uint32_t)(bus)->sclPin
+#define IIC_SDA_1(bus)      (bus)->sdaPort->ODR |= (bus)->sdaPin
+#define IIC_SDA_0(bus)      (bus)->sdaPort->ODR &= ~(uint32_t)(bus)->sdaPin
+#endif
+#define IIC_SDA_READ(bus)   ((bus)->sdaPort->IDR & (bus)->sdaPin)
+#define IIC_SDA_IN(bus)     (bus)->sdaPort->MODER &= ~(bus)->sdaModer//ģʽ
+#define IIC_SDA_OUT(bus)    (bus)->sdaPort->MODER = ((bus)->sdaPort->MODER & ~(bus)->sdaModer) | ((bus)->sdaModer & 0x55555555)//ģʽ
+#define IIC_GPIO_CLK(port)  ((uint32_t)1 << (((uint32_t)(port) - GPIOA_BASE) >> 10))//GPIOxAHB1ʱʹλ
 
-static void IIC_DelayUs(uint32_t us);
 static uint8_t isInitialized = 0;
 
+#if IIC_USE_TRACE == 1
+#define IIC_TRACE_FLAG_READ     0x01 //!< 
+#define IIC_TRACE_FLAG_NACK     0x02 //!< Ӧߴ
+#define IIC_TRACE_FLAG_NOREG    0x04 //!< ĴַĴ, reg
+
 /**
- * @brief ׼΢뼶ʱ
+ * @brief һδĸټ¼.
  */
-static inline void IIC_DelayUs(uint32_t us)
+typedef struct
 {
-  __IO uint32_t tmp = us;
-  tmp <<= 2;
-  while (tmp--);
-}
+  uint32_t timestamp;//ʼʱ(ںʱ)
+  uint32_t duration;//ʱ(ںʱ)
+  uint16_t len;//ֽ, ַͼĴַ
+  uint8_t bus;//, 0ΪӲIIC
+  uint8_t addr;//7λַ
+  uint8_t reg;//Ĵַ
+  uint8_t flags;//IIC_TRACE_FLAG_*
+} IIC_TRACE_RecordTypedef;
+
+static IIC_TRACE_RecordTypedef traceBuffer[IIC_TRACE_SIZE];
+static uint32_t traceHead = 0;//һ¼дλ, ֻ
+static uint32_t traceDropped = 0;//ǵļ¼
+static __IO uint8_t traceEnabled = 1;
+static uint8_t busCount = 0;//ѷ
+
 /**
- * @brief ʼIIC
+ * @brief дһ¼, ʱɵļ¼, же.
  */
-void IIC_Init()
+static void IIC_TRACE_Record(uint32_t start, uint8_t bus, uint8_t addr, uint8_t reg, uint16_t len, uint8_t flags)
 {
-  if (isInitialized)
+  IIC_TRACE_RecordTypedef *record;
+  uint32_t primask, now = UTILS_GetCycleCount();
+  if (!traceEnabled)
     return;
+  primask = __get_PRIMASK();
+  __disable_irq();
+  if (traceHead >= IIC_TRACE_SIZE)
+    traceDropped++;
+  record = &traceBuffer[traceHead++ & (IIC_TRACE_SIZE - 1)];
+  record->timestamp = start;
+  record->duration = now - start;
+  record->len = len;
+  record->bus = bus;
+  record->addr = addr;
+  record->reg = reg;
+  record->flags = flags;
+  __set_PRIMASK(primask);
+}
+
+#define IIC_TRACE_BEGIN()                           uint32_t traceStart = UTILS_GetCycleCount()
+#define IIC_TRACE_END(bus, addr, reg, len, flags)   IIC_TRACE_Record(traceStart, bus, addr, reg, len, flags)
+#else
+#define IIC_TRACE_BEGIN()
+#define IIC_TRACE_END(bus, addr, reg, len, flags)
+#endif
+
+/**
+ * @brief ȵһذSCL, ʱΪµı.
+ * @note һؿʼʱ, ִ֮дʱҲڰ, Żȼ޹.
+ */
+static inline void IIC_Delay(IIC_BusTypedef *bus)
+{
+  uint32_t now;
+  do
+  {
+    now = UTILS_GetCycleCount();
+  } while (now - bus->edge < bus->halfPeriod);
+  bus->edge = now;
+}
+
+/**
+ * @brief Ӧλ.
+ * @param ack 1-Ӧ; 0-Ӧ.
+ */
+static inline void IIC_BusSendAck(IIC_BusTypedef *bus, uint8_t ack)
+{
+  IIC_SDA_OUT(bus);
+  if (ack)
+    IIC_SDA_0(bus);
+  else
+    IIC_SDA_1(bus);
+  IIC_Delay(bus);
+  IIC_SCL_1(bus);
+  IIC_Delay(bus);
+  IIC_SCL_0(bus);
+}
+
+/**
+ * @brief ʼIIC.
+ * @param bus ,  @ref IIC_BUS.
+ * @note SystemCoreClockSCLİ, ںʱӸıµ.
+ *       ͬһſظʼ.
+ */
+void IIC_InitBus(IIC_BusTypedef *bus)
+{
   GPIO_InitTypeDef GPIO_InitStructure;
-  RCC_AHB1PeriphClockCmd(IIC_SCL_GPIO_CLK | IIC_SDA_GPIO_CLK, ENABLE);//ʹGPIOʱ
+  uint32_t sdaIndex = 31 - __CLZ(bus->sdaPin);
+  UTILS_InitCycleCounter();
+  bus->halfPeriod = SystemCoreClock / (bus->frequency << 1);
+  bus->sdaModer = (uint32_t)3 << (sdaIndex << 1);
+  RCC_AHB1PeriphClockCmd(IIC_GPIO_CLK(bus->sclPort) | IIC_GPIO_CLK(bus->sdaPort), ENABLE);//ʹGPIOʱ
   //SCL, SDAʼ
-  GPIO_InitStructure.GPIO_Pin = IIC_SCL_PIN;
+  GPIO_InitStructure.GPIO_Pin = bus->sclPin;
   GPIO_InitStructure.GPIO_Mode = GPIO_Mode_OUT;//ͨģʽ
   GPIO_InitStructure.GPIO_OType = GPIO_OType_PP;//
   GPIO_InitStructure.GPIO_Speed = GPIO_High_Speed;
   GPIO_InitStructure.GPIO_PuPd = GPIO_PuPd_UP;//
-  GPIO_Init(IIC_SCL_PORT, &GPIO_InitStructure);//ʼ
+  GPIO_Init(bus->sclPort, &GPIO_InitStructure);//ʼ
+  GPIO_InitStructure.GPIO_Pin = bus->sdaPin;
+  GPIO_Init(bus->sdaPort, &GPIO_InitStructure);//ʼ
+  IIC_SCL_1(bus);
+  IIC_SDA_1(bus);
+  bus->edge = UTILS_GetCycleCount();
+#if IIC_USE_TRACE == 1
+  if (bus->id == 0)
+    bus->id = ++busCount;
+#endif
+}
+
+/**
+ * @brief ʼź, Ҳظʼź.
+ */
+void IIC_BusStart(IIC_BusTypedef *bus)
+{
+  IIC_SDA_OUT(bus);
+  IIC_SDA_1(bus);
+  IIC_Delay(bus);
+  IIC_SCL_1(bus);
+  IIC_Delay(bus);
+  IIC_SDA_0(bus);//START:when CLK is high,DATA change form high to low
+  IIC_Delay(bus);
+  IIC_SCL_0(bus);//ǯסI2Cߣ׼ͻ
+}
+
+/**
+ * @brief ֹͣź.
+ */
+void IIC_BusStop(IIC_BusTypedef *bus)
+{
+  IIC_SDA_OUT(bus);
+  IIC_SCL_0(bus);
+  IIC_SDA_0(bus);
+  IIC_Delay(bus);
+  IIC_SCL_1(bus);
+  IIC_Delay(bus);
+  IIC_SDA_1(bus);//STOP:when CLK is high DATA change form low to high
+  IIC_Delay(bus);//߿ʱ
+}
+
+/**
+ * @brief һֽڲӦ.
+ * @return 0-յӦ; 1-ûӦ.
+ */
+uint8_t IIC_BusWriteByte(IIC_BusTypedef *bus, uint8_t data)
+{
+  uint8_t i, nack;
+  IIC_SDA_OUT(bus);
+  for (i = 0; i < 8; i++)
+  {
+    if (data & 0x80)
+      IIC_SDA_1(bus);
+    else
+      IIC_SDA_0(bus);
+    data <<= 1;
+    IIC_Delay(bus);
+    IIC_SCL_1(bus);
+    IIC_Delay(bus);
+    IIC_SCL_0(bus);
+  }
+  IIC_SDA_IN(bus);//ͷSDA, ɴӻӦ
+  IIC_Delay(bus);
+  IIC_SCL_1(bus);
+  IIC_Delay(bus);
+  nack = IIC_SDA_READ(bus) != 0;
+  IIC_SCL_0(bus);
+  return nack;
+}
+
+/**
+ * @brief 1ֽ.
+ * @param ack
+ *          1-Ӧ
+ *          0-ͷӦ
+ * @return ضȡһֽ
+ */
+uint8_t IIC_BusReadByte(IIC_BusTypedef *bus, uint8_t ack)
+{
+  uint8_t i, receive = 0;
+  IIC_SDA_IN(bus);
+  for (i = 0; i < 8; i++)
+  {
+    IIC_Delay(bus);
+    IIC_SCL_1(bus);
+    IIC_Delay(bus);
+    receive <<= 1;
+    if (IIC_SDA_READ(bus))
+      receive++;
+    IIC_SCL_0(bus);
+  }
+  IIC_BusSendAck(bus, ack);
+  return receive;
+}
+
+/**
+ * @brief һδд.
+ * @param addr 7λַ
+ * @param data Ҫд
+ * @param len дֽ
+ * @return 0-; 1-
+ */
+uint8_t IIC_BusWrite(IIC_BusTypedef *bus, uint8_t addr, const uint8_t *data, uint16_t len)
+{
+  uint16_t i = 0;
+  uint8_t nack;
+  IIC_TRACE_BEGIN();
+  IIC_BusStart(bus);
+  nack = IIC_BusWriteByte(bus, addr << 1);//ַ+д
+  while (!nack && i < len)
+    nack = IIC_BusWriteByte(bus, data[i++]);
+  IIC_BusStop(bus);
+  IIC_TRACE_END(bus->id, addr, 0, len, IIC_TRACE_FLAG_NOREG | (nack ? IIC_TRACE_FLAG_NACK : 0));
+  return nack;
+}
+
+/**
+ * @brief ʼź, ַ+, ֹͣź.
+ * @return 0-; 1-
+ */
+static uint8_t IIC_BusReceive(IIC_BusTypedef *bus, uint8_t addr, uint8_t *data, uint16_t len)
+{
+  uint16_t i;
+  uint8_t nack;
+  IIC_BusStart(bus);
+  nack = IIC_BusWriteByte(bus, (addr << 1) | 1);//ַ+
+  for (i = 0; !nack && i < len; i++)
+    data[i] = IIC_BusReadByte(bus, i + 1 < len);//һֽڷnACK
+  IIC_BusStop(bus);
+  return nack;
+}
+
+/**
+ * @brief һδ.
+ * @param addr 7λַ
+ * @param data 
+ * @param len ȡֽ
+ * @return 0-; 1-
+ */
+uint8_t IIC_BusRead(IIC_BusTypedef *bus, uint8_t addr, uint8_t *data, uint16_t len)
+{
+  uint8_t nack;
+  IIC_TRACE_BEGIN();
+  nack = IIC_BusReceive(bus, addr, data, len);
+  IIC_TRACE_END(bus->id, addr, 0, len, IIC_TRACE_FLAG_READ | IIC_TRACE_FLAG_NOREG | (nack ? IIC_TRACE_FLAG_NACK : 0));
+  return nack;
+}
+
+/**
+ * @brief IICд1ֽڵĴ
+ * @param addr 7λַ
+ * @param reg Ĵַ
+ * @param data Ҫд
+ * @return 0-; 1-
+ */
+uint8_t IIC_BusWriteRegByte(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg, uint8_t data)
+{
+  return IIC_BusWriteRegBytes(bus, addr, reg, 1, &data);
+}
+
+/**
+ * @brief IIC1ֽڵĴ
+ * @param addr 7λַ
+ * @param reg Ĵַ
+ * @return Ҫȡ, ʱΪ0xFF
+ */
+uint8_t IIC_BusReadRegByte(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg)
+{
+  uint8_t data = 0xFF;
+  IIC_BusReadRegBytes(bus, addr, reg, 1, &data);
+  return data;
+}
+
+/**
+ * @brief IICдĴ
+ * @param addr 7λַ
+ * @param reg Ĵַ
+ * @param len дֽ
+ * @param data Ҫд
+ * @return 0-; 1-
+ */
+uint8_t IIC_BusWriteRegBytes(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg, uint16_t len, const uint8_t *data)
+{
+  uint16_t i = 0;
+  uint8_t nack;
+  IIC_TRACE_BEGIN();
+  IIC_BusStart(bus);
+  nack = IIC_BusWriteByte(bus, addr << 1) || IIC_BusWriteByte(bus, reg);//ַ+д, Ĵַ
+  while (!nack && i < len)
+    nack = IIC_BusWriteByte(bus, data[i++]);
+  IIC_BusStop(bus);
+  IIC_TRACE_END(bus->id, addr, reg, len, nack ? IIC_TRACE_FLAG_NACK : 0);
+  return nack;
+}
+
+/**
+ * @brief IICĴ, дĴַظʼźŶ
+ * @param addr 7λַ
+ * @param reg Ĵַ
+ * @param len ȡֽ
+ * @param data 
+ * @return 0-; 1-
+ */
+uint8_t IIC_BusReadRegBytes(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg, uint16_t len, uint8_t *data)
+{
+  uint8_t nack;
+  IIC_TRACE_BEGIN();
+  IIC_BusStart(bus);
+  if (IIC_BusWriteByte(bus, addr << 1) || IIC_BusWriteByte(bus, reg))//ַ+д, Ĵַ
+  {
+    IIC_BusStop(bus);
+    nack = 1;
+  }
+  else
+    nack = IIC_BusReceive(bus, addr, data, len);
+  IIC_TRACE_END(bus->id, addr, reg, len, IIC_TRACE_FLAG_READ | (nack ? IIC_TRACE_FLAG_NACK : 0));
+  return nack;
+}
+
+/**
+ * @brief ںϲ˼ŵͬʱ͸ߵһֽڲӦ.
+ * @param group ϲ
+ * @param data Ҫ͵ֽ
+ * @return ûӦλ
+ */
+static uint8_t IIC_GroupWriteByte(IIC_BusTypedef *group, IIC_BusTypedef * const *buses, uint8_t count, const uint8_t *data)
+{
+  uint8_t i, bit, nack = 0;
+  uint16_t set, idr;
+  IIC_SDA_OUT(group);
+  for (bit = 0x80; bit; bit >>= 1)
+  {
+    set = 0;
+    for (i = 0; i < count; i++)
+      if (data[i] & bit)
+        set |= buses[i]->sdaPin;
+    group->sdaPort->BSRRL = set;
+    group->sdaPort->BSRRH = group->sdaPin & ~set;
+    IIC_Delay(group);
+    IIC_SCL_1(group);
+    IIC_Delay(group);
+    IIC_SCL_0(group);
+  }
+  IIC_SDA_IN(group);
+  IIC_Delay(group);
+  IIC_SCL_1(group);
+  IIC_Delay(group);
+  idr = group->sdaPort->IDR;
+  IIC_SCL_0(group);
+  for (i = 0; i < count; i++)
+    if (idr & buses[i]->sdaPin)
+      nack |= 1 << i;
+  return nack;
+}
+
+/**
+ * @brief ںϲ˼ŵͬʱߵһֽ, ÿλֻһIDR.
+ * @param group ϲ
+ * @param data iߵֽڴ浽data[i * stride]
+ * @param ack 1-Ӧ; 0-ͷӦ
+ */
+static void IIC_GroupReadByte(IIC_BusTypedef *group, IIC_BusTypedef * const *buses, uint8_t count, uint8_t *data, uint16_t stride, uint8_t ack)
+{
+  uint8_t i, bit;
+  uint16_t idr;
+  for (i = 0; i < count; i++)
+    data[i * stride] = 0;
+  IIC_SDA_IN(group);
+  for (bit = 0x80; bit; bit >>= 1)
+  {
+    IIC_Delay(group);
+    IIC_SCL_1(group);
+    IIC_Delay(group);
+    idr = group->sdaPort->IDR;
+    IIC_SCL_0(group);
+    for (i = 0; i < count; i++)
+      if (idr & buses[i]->sdaPin)
+        data[i * stride] |= bit;
+  }
+  IIC_BusSendAck(group, ack);
+}
+
+/**
+ * @brief ڼIICͬʱͬļĴ.
+ * @param buses , ѳʼ
+ * @param count , 1~8
+ * @param addr ߵ7λַ
+ * @param reg Ĵַ
+ * @param len ÿ߶ȡֽ, Ϊ0
+ * @param data , iߵdata + i * len
+ * @return λ, iλӦbuses[i]; 0-ȫ; 0xFF-countlenΧ, ûд
+ * @note SCLͬһGPIO˿SDAͬһGPIO˿ʱ, ͬշ,
+ *       SCLһת, ÿλֻһIDRSDA, ʱһͬ, SCLƵȡ͵.
+ *        @ref IIC_BusReadRegBytes , ټ¼д.
+ */
+uint8_t IIC_BusReadRegBytesParallel(IIC_BusTypedef * const *buses, uint8_t count, const uint8_t *addr, uint8_t reg, uint16_t len, uint8_t *data)
+{
+  IIC_BusTypedef group;
+  uint8_t i, failed = 0, bytes[8] = {0};
+  uint16_t n;
+  if (count == 0 || count > 8 || len == 0)
+    return 0xFF;//λֻ8λ
+  group = (IIC_BusTypedef)IIC_BUS(buses[0]->sclPort, 0, buses[0]->sdaPort, 0, 0);
+  for (i = 0; i < count; i++)
+  {
+    if (buses[i]->sclPort != group.sclPort || buses[i]->sdaPort != group.sdaPort)
+      break;
+    group.sclPin |= buses[i]->sclPin;
+    group.sdaPin |= buses[i]->sdaPin;
+    group.sdaModer |= buses[i]->sdaModer;
+    if (buses[i]->halfPeriod > group.halfPeriod)
+      group.halfPeriod = buses[i]->halfPeriod;
+  }
+  if (i < count)
+  {
+    //ŷɢڲͬ˿, ζ, ÿ߸һټ¼
+    for (i = 0; i < count; i++)
+      if (IIC_BusReadRegBytes(buses[i], addr[i], reg, len, data + i * len))
+        failed |= 1 << i;
+    return failed;
+  }
+  IIC_TRACE_BEGIN();
+  group.edge = UTILS_GetCycleCount();
+  IIC_BusStart(&group);
+  for (i = 0; i < count; i++)
+    bytes[i] = addr[i] << 1;//ַ+д
+  failed |= IIC_GroupWriteByte(&group, buses, count, bytes);
+  memset(bytes, reg, count);
+  failed |= IIC_GroupWriteByte(&group, buses, count, bytes);
+  IIC_BusStart(&group);
+  for (i = 0; i < count; i++)
+    bytes[i] = (addr[i] << 1) | 1;//ַ+
+  failed |= IIC_GroupWriteByte(&group, buses, count, bytes);
+  for (n = 0; n < len; n++)
+    IIC_GroupReadByte(&group, buses, count, data + n, len, n + 1 < len);//һֽڷnACK
+  IIC_BusStop(&group);
+#if IIC_USE_TRACE == 1
+  for (i = 0; i < count; i++)
+    IIC_TRACE_END(buses[i]->id, addr[i], reg, len, IIC_TRACE_FLAG_READ | ((failed >> i) & 1 ? IIC_TRACE_FLAG_NACK : 0));
+#endif
+  return failed;
+}
+
+#if IIC_USE_HARDWARE == 1
+
+/**
+ * @brief ӲIIC׶.
+ */
+typedef enum
+{
+  IIC_PhaseIdle = 0,//
+  IIC_PhaseWrite,//ͼĴַҪд
+  IIC_PhaseRead//ظʼźź
+} IIC_PhaseTypedef;
+
+static __IO IIC_PhaseTypedef transferPhase = IIC_PhaseIdle;
+static __IO uint8_t transferError = 0;//һδĽ, 0-; 1-
+static uint8_t transferAddr;//7λַ
+static uint8_t transferReg;//Ĵַ
+static uint8_t transferRead;//0-дĴ; 1-Ĵ
+static uint8_t transferNoReg;//1-ͼĴַ, ֻд
+static uint8_t *transferData;//д
+static uint16_t transferLength;//ֽ
+static uint16_t transferIndex;//д׶ѷ͵ֽ, Ĵַ
+static IIC_CompleteHandler transferHandler = NULL;
+static IIC_IdleHandler idleHandler = NULL;//߿к, IIC_SCHED_Poll
+#if IIC_USE_TRACE == 1
+static uint32_t transferStart;//俪ʼʱ(ںʱ)
+#endif
+
+/**
+ * @brief ʼIICͽDMA.
+ */
+void IIC_Init()
+{
+  GPIO_InitTypeDef GPIO_InitStructure;
+  I2C_InitTypeDef I2C_InitStructure;
+  DMA_InitTypeDef DMA_InitStructure;
+  NVIC_InitTypeDef NVIC_InitStructure;
+  if (isInitialized)
+    return;
+#if IIC_USE_TRACE == 1
+  UTILS_InitCycleCounter();//ټ¼ʱ
+#endif
+
+  //SCL, SDAÿ©
+  RCC_AHB1PeriphClockCmd(IIC_GPIO_CLK(IIC_SCL_PORT) | IIC_GPIO_CLK(IIC_SDA_PORT), ENABLE);
+  GPIO_PinAFConfig(IIC_SCL_PORT, IIC_SCL_PINSOURCE, IIC_I2C_GPIO_AF);
+  GPIO_PinAFConfig(IIC_SDA_PORT, IIC_SDA_PINSOURCE, IIC_I2C_GPIO_AF);
+  GPIO_InitStructure.GPIO_Pin = IIC_SCL_PIN;
+  GPIO_InitStructure.GPIO_Mode = GPIO_Mode_AF;
+  GPIO_InitStructure.GPIO_OType = GPIO_OType_OD;
+  GPIO_InitStructure.GPIO_Speed = GPIO_Fast_Speed;
+  GPIO_InitStructure.GPIO_PuPd = GPIO_PuPd_UP;
+  GPIO_Init(IIC_SCL_PORT, &GPIO_InitStructure);
   GPIO_InitStructure.GPIO_Pin = IIC_SDA_PIN;
-  GPIO_Init(IIC_SDA_PORT, &GPIO_InitStructure);//ʼ
-  IIC_SCL_PORT->BSRRL = IIC_SCL_PIN;//IIC_SCL=1
-  IIC_SDA_PORT->BSRRL = IIC_SDA_PIN;//IIC_SDA=1
+  GPIO_Init(IIC_SDA_PORT, &GPIO_InitStructure);
+
+  //IIC
+  RCC_APB1PeriphClockCmd(IIC_I2C_CLK, ENABLE);
+  I2C_DeInit(IIC_I2C);
+  I2C_InitStructure.I2C_ClockSpeed = IIC_SPEED;
+  I2C_InitStructure.I2C_Mode = I2C_Mode_I2C;
+  I2C_InitStructure.I2C_DutyCycle = I2C_DutyCycle_2;
+  I2C_InitStructure.I2C_OwnAddress1 = 0;
+  I2C_InitStructure.I2C_Ack = I2C_Ack_Enable;
+  I2C_InitStructure.I2C_AcknowledgedAddress = I2C_AcknowledgedAddress_7bit;
+  I2C_Init(IIC_I2C, &I2C_InitStructure);
+  I2C_Cmd(IIC_I2C, ENABLE);
+
+  //DMA, ÿδǰõַͳ
+  RCC_AHB1PeriphClockCmd(IIC_RX_DMA_CLK, ENABLE);
+  DMA_DeInit(IIC_RX_DMA_STREAM);
+  DMA_InitStructure.DMA_Channel = IIC_RX_DMA_CHANNEL;
+  DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&IIC_I2C->DR;
+  DMA_InitStructure.DMA_Memory0BaseAddr = 0;
+  DMA_InitStructure.DMA_DIR = DMA_DIR_PeripheralToMemory;
+  DMA_InitStructure.DMA_BufferSize = 1;
+  DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+  DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+  DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+  DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+  DMA_InitStructure.DMA_Mode = DMA_Mode_Normal;
+  DMA_InitStructure.DMA_Priority = DMA_Priority_High;
+  DMA_InitStructure.DMA_FIFOMode = DMA_FIFOMode_Disable;
+  DMA_InitStructure.DMA_FIFOThreshold = DMA_FIFOThreshold_Full;
+  DMA_InitStructure.DMA_MemoryBurst = DMA_MemoryBurst_Single;
+  DMA_InitStructure.DMA_PeripheralBurst = DMA_PeripheralBurst_Single;
+  DMA_Init(IIC_RX_DMA_STREAM, &DMA_InitStructure);
+  DMA_ITConfig(IIC_RX_DMA_STREAM, DMA_IT_TC, ENABLE);
+
+  //¼ж, жϺDMAж
+  NVIC_InitStructure.NVIC_IRQChannel = IIC_I2C_EV_IRQ_CHANNEL;
+  NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 1;
+  NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+  NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+  NVIC_Init(&NVIC_InitStructure);
+  NVIC_InitStructure.NVIC_IRQChannel = IIC_I2C_ER_IRQ_CHANNEL;
+  NVIC_Init(&NVIC_InitStructure);
+  NVIC_InitStructure.NVIC_IRQChannel = IIC_RX_DMA_IRQ_CHANNEL;
+  NVIC_Init(&NVIC_InitStructure);
+  isInitialized = 1;
+}
+
+/**
+ * @brief һδĴ.
+ * @param error 0-; 1-.
+ */
+static void IIC_TransferComplete(uint8_t error)
+{
+  IIC_CompleteHandler handler;
+  uint16_t timeout = 0xFFFF;
+  while ((IIC_I2C->CR1 & I2C_CR1_STOP) && --timeout);//ȴֹͣźŷٿʼ´δ
+  I2C_ITConfig(IIC_I2C, I2C_IT_EVT | I2C_IT_BUF | I2C_IT_ERR, DISABLE);
+  I2C_DMACmd(IIC_I2C, DISABLE);
+  I2C_DMALastTransferCmd(IIC_I2C, DISABLE);
+  I2C_AcknowledgeConfig(IIC_I2C, ENABLE);
+#if IIC_USE_TRACE == 1
+  IIC_TRACE_Record(transferStart, 0, transferAddr, transferReg, transferLength, (transferRead ? IIC_TRACE_FLAG_READ : 0) | (transferNoReg ? IIC_TRACE_FLAG_NOREG : 0) | (error ? IIC_TRACE_FLAG_NACK : 0));
+#endif
+  handler = transferHandler;
+  transferHandler = NULL;
+  transferError = error;
+  transferPhase = IIC_PhaseIdle;
+  if (handler == NULL)
+    return;//ͬIIC_TransferǰidleHandler
+  handler(error);
+  if (idleHandler != NULL && transferPhase == IIC_PhaseIdle)
+    idleHandler();
+}
+
+/**
+ * @brief ռ߲ʼһδ.
+ * @param noReg 1-ͼĴַ, ʱֱӽ׶, дʱݿʼ.
+ * @return 0-ѿʼ; 1-æ.
+ */
+static uint8_t IIC_StartTransfer(uint8_t addr, uint8_t reg, uint8_t read, uint8_t noReg, uint16_t len, uint8_t *data, IIC_CompleteHandler handler)
+{
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  if (transferPhase != IIC_PhaseIdle)
+  {
+    __set_PRIMASK(primask);
+    return 1;
+  }
+  transferPhase = read && noReg ? IIC_PhaseRead : IIC_PhaseWrite;
+  __set_PRIMASK(primask);
+  transferAddr = addr;
+  transferReg = reg;
+  transferRead = read;
+  transferNoReg = noReg;
+  transferData = data;
+  transferLength = len;
+  transferIndex = noReg;//д׶ε0ֽǼĴַ
+  transferHandler = handler;
+  transferError = 0;
+#if IIC_USE_TRACE == 1
+  transferStart = UTILS_GetCycleCount();
+#endif
+  I2C_ITConfig(IIC_I2C, I2C_IT_EVT | I2C_IT_ERR, ENABLE);
+  I2C_GenerateSTART(IIC_I2C, ENABLE);
+  return 0;
+}
+
+/**
+ * @brief IIC¼ж.
+ * @note д׶ֽTXEжϷ, һֽڷ(BTF)ֹͣźŻظʼź.
+ *       ׶ֻ1ֽʱRXNEжϽ, DMA, DMALASTλ, һֽԶظӦ.
+ */
+void IIC_I2C_EV_IRQ_HANDLER()
+{
+  uint16_t sr1 = IIC_I2C->SR1;
+  if (sr1 & I2C_SR1_SB)
+  {
+    if (transferPhase == IIC_PhaseRead)//SR1дDRSB
+      I2C_Send7bitAddress(IIC_I2C, transferAddr << 1, I2C_Direction_Receiver);
+    else
+      I2C_Send7bitAddress(IIC_I2C, transferAddr << 1, I2C_Direction_Transmitter);
+  }
+  else if (sr1 & I2C_SR1_ADDR)
+  {
+    if (transferPhase == IIC_PhaseWrite)
+    {
+      (void)IIC_I2C->SR2;//SR1SR2ADDR
+      I2C_ITConfig(IIC_I2C, I2C_IT_BUF, ENABLE);
+    }
+    else if (transferLength == 1)
+    {
+      I2C_AcknowledgeConfig(IIC_I2C, DISABLE);//ADDRǰرӦ, ΨһֽڻظӦ
+      (void)IIC_I2C->SR2;
+      I2C_GenerateSTOP(IIC_I2C, ENABLE);
+      I2C_ITConfig(IIC_I2C, I2C_IT_BUF, ENABLE);
+    }
+    else
+    {
+      DMA_ClearFlag(IIC_RX_DMA_STREAM, IIC_RX_DMA_FLAGS);
+      DMA_MemoryTargetConfig(IIC_RX_DMA_STREAM, (uint32_t)transferData, DMA_Memory_0);
+      DMA_SetCurrDataCounter(IIC_RX_DMA_STREAM, transferLength);
+      DMA_Cmd(IIC_RX_DMA_STREAM, ENABLE);
+      I2C_DMALastTransferCmd(IIC_I2C, ENABLE);
+      I2C_DMACmd(IIC_I2C, ENABLE);
+      (void)IIC_I2C->SR2;
+    }
+  }
+  else if (transferPhase == IIC_PhaseRead)
+  {
+    if (sr1 & I2C_SR1_RXNE)
+    {
+      transferData[0] = IIC_I2C->DR;
+      IIC_TransferComplete(0);
+    }
+  }
+  else if (transferPhase == IIC_PhaseWrite)
+  {
+    if ((sr1 & (I2C_SR1_TXE | I2C_SR1_BTF)) && transferIndex <= (transferRead ? 0 : transferLength))
+    {
+      IIC_I2C->DR = transferIndex ? transferData[transferIndex - 1] : transferReg;
+      if (++transferIndex > (transferRead ? 0 : transferLength))
+        I2C_ITConfig(IIC_I2C, I2C_IT_BUF, DISABLE);//һֽںȴBTF
+    }
+    else if (sr1 & I2C_SR1_BTF)
+    {
+      if (transferRead)
+      {
+        transferPhase = IIC_PhaseRead;
+        I2C_GenerateSTART(IIC_I2C, ENABLE);//ظʼź
+      }
+      else
+      {
+        I2C_GenerateSTOP(IIC_I2C, ENABLE);
+        IIC_TransferComplete(0);
+      }
+    }
+  }
+}
+
+/**
+ * @brief IICж, Ӧߴٲöʧʱֹδ.
+ */
+void IIC_I2C_ER_IRQ_HANDLER()
+{
+  IIC_I2C->SR1 &= ~(I2C_SR1_AF | I2C_SR1_BERR | I2C_SR1_ARLO | I2C_SR1_OVR);
+  DMA_Cmd(IIC_RX_DMA_STREAM, DISABLE);
+  I2C_GenerateSTOP(IIC_I2C, ENABLE);
+  if (transferPhase != IIC_PhaseIdle)
+    IIC_TransferComplete(1);
+}
+
+/**
+ * @brief DMAж, ֹͣź.
+ */
+void IIC_RX_DMA_IRQ_HANDLER()
+{
+  if (DMA_GetITStatus(IIC_RX_DMA_STREAM, IIC_RX_DMA_IT_TC) != RESET)
+  {
+    DMA_ClearITPendingBit(IIC_RX_DMA_STREAM, IIC_RX_DMA_IT_TC);
+    I2C_GenerateSTOP(IIC_I2C, ENABLE);
+    IIC_TransferComplete(0);
+  }
+}
+
+/**
+ * @brief Ƿڴ.
+ * @return 0-; 1-ڴ.
+ */
+uint8_t IIC_IsBusy()
+{
+  return transferPhase != IIC_PhaseIdle;
+}
+
+/**
+ * @brief ʼں̨дĴ, .
+ * @param addr 7λַ
+ * @param reg Ĵַ
+ * @param len дֽ
+ * @param data Ҫд, ǰ޸
+ * @param handler жеõĻص, ΪNULL
+ * @return 0-ѿʼ; 1-æ
+ */
+uint8_t IIC_WriteRegBytesAsync(uint8_t addr, uint8_t reg, uint16_t len, const uint8_t *data, IIC_CompleteHandler handler)
+{
+  return IIC_StartTransfer(addr, reg, 0, 0, len, (uint8_t *)data, handler);
+}
+
+/**
+ * @brief ʼں̨Ĵ, .
+ * @param addr 7λַ
+ * @param reg Ĵַ
+ * @param len ȡֽ, Ϊ0
+ * @param data , DMAд, CCM RAM
+ * @param handler жеõĻص, ΪNULL
+ * @return 0-ѿʼ; 1-ælenΪ0
+ */
+uint8_t IIC_ReadRegBytesAsync(uint8_t addr, uint8_t reg, uint16_t len, uint8_t *data, IIC_CompleteHandler handler)
+{
+  if (len == 0)
+    return 1;
+  return IIC_StartTransfer(addr, reg, 1, 0, len, data, handler);
+}
+
+/**
+ * @brief ǰܷIICжռ.
+ * @return 0-, жϻռȼIICжϵж; 1-.
+ */
+static uint8_t IIC_CanPreempt()
+{
+  uint32_t active = __get_IPSR(), group = NVIC_GetPriorityGrouping();
+  uint32_t activePreempt, iicPreempt, sub;
+  if (__get_PRIMASK())
+    return 0;
+  if (active == 0)
+    return 1;//߳ģʽ
+  NVIC_DecodePriority(NVIC_GetPriority((IRQn_Type)((int32_t)active - 16)), group, &activePreempt, &sub);
+  NVIC_DecodePriority(NVIC_GetPriority(IIC_I2C_EV_IRQ_CHANNEL), group, &iicPreempt, &sub);
+  return iicPreempt < activePreempt;
+}
+
+/**
+ * @brief ֱӵѹIICDMAжϷ, IICжϲռʱƽ.
+ * @note ¼жǵƽ, ־ʱٴι, һηûӰ.
+ */
+static void IIC_PollInterrupts()
+{
+  if (NVIC_GetPendingIRQ(IIC_I2C_ER_IRQ_CHANNEL))
+  {
+    NVIC_ClearPendingIRQ(IIC_I2C_ER_IRQ_CHANNEL);
+    IIC_I2C_ER_IRQ_HANDLER();
+  }
+  if (NVIC_GetPendingIRQ(IIC_I2C_EV_IRQ_CHANNEL))
+  {
+    NVIC_ClearPendingIRQ(IIC_I2C_EV_IRQ_CHANNEL);
+    IIC_I2C_EV_IRQ_HANDLER();
+  }
+  if (NVIC_GetPendingIRQ(IIC_RX_DMA_IRQ_CHANNEL))
+  {
+    NVIC_ClearPendingIRQ(IIC_RX_DMA_IRQ_CHANNEL);
+    IIC_RX_DMA_IRQ_HANDLER();
+  }
+}
+
+/**
+ * @brief IICжϲռʱ, ڵƽڽеĴ.
+ * @note ڵȴ첽ѭе, ռʱʲôҲ.
+ */
+void IIC_Poll()
+{
+  if (!IIC_CanPreempt())
+    IIC_PollInterrupts();
+}
+
+/**
+ * @brief ߿кõĺ.
+ * @param handler 첽Ļصغͬ, ʱ߿; ΪNULL
+ * @note ֱӵõĴʼŶӵĴ,  @ref IIC_SCHED_Init.
+ */
+void IIC_SetIdleHandler(IIC_IdleHandler handler)
+{
+  idleHandler = handler;
+}
+
+/**
+ * @brief ȴ߿кʼ, ŷ.
+ * @return 0-; 1-
+ * @note κже. IICжϲռʱ(紫ⲿж), ɱѯ
+ *       ƽ, ڽе첽, صҲڵߵжִ.
+ *       idleHandler, ʼڱδڼŶӵĴ.
+ */
+static uint8_t IIC_Transfer(uint8_t addr, uint8_t reg, uint8_t read, uint8_t noReg, uint16_t len, uint8_t *data)
+{
+  uint8_t poll, result;
+  if ((read || noReg) && len == 0)
+    return 1;
+  poll = !IIC_CanPreempt();
+  while (IIC_StartTransfer(addr, reg, read, noReg, len, data, NULL))
+  {
+    if (poll)
+      IIC_PollInterrupts();
+  }
+  while (transferPhase != IIC_PhaseIdle)
+  {
+    if (poll)
+      IIC_PollInterrupts();
+  }
+  result = transferError;
+  if (idleHandler != NULL)
+    idleHandler();
+  return result;
+}
+
+/**
+ * @brief IICд1ֽڵĴ
+ * @param addr ַ
+ * @param reg Ĵַ
+ * @param data Ҫд
+ * @return 0-; 1-
+ */
+uint8_t IIC_WriteRegByte(uint8_t addr, uint8_t reg, uint8_t data)
+{
+  return IIC_Transfer(addr, reg, 0, 0, 1, &data);
+}
+/**
+ * @brief IIC1ֽڵĴ
+ * @param addr ַ
+ * @param reg Ĵַ
+ * @return Ҫȡ, ʱΪ0xFF
+ */
+uint8_t IIC_ReadRegByte(uint8_t addr, uint8_t reg)
+{
+  uint8_t data = 0xFF;
+  IIC_Transfer(addr, reg, 1, 0, 1, &data);
+  return data;
+}
+
+/**
+ * @brief IICд
+ * @param addr ַ
+ * @param reg Ĵַ
+ * @param len дֽ
+ * @param data Ҫд
+ * @return 0-; 1-
+ */
+uint8_t IIC_WriteRegBytes(uint8_t addr, uint8_t reg, uint8_t len, uint8_t * data)
+{
+  return IIC_Transfer(addr, reg, 0, 0, len, data);
+}
+/**
+ * @brief IIC
+ * @param addr ַ
+ * @param reg Ĵַ
+ * @param len ȡֽ
+ * @param data Ҫȡ
+ * @return 0-; 1-
+ */
+uint8_t IIC_ReadRegBytes(uint8_t addr, uint8_t reg, uint8_t len, uint8_t * data)
+{
+  return IIC_Transfer(addr, reg, 1, 0, len, data);
+}
+
+/**
+ * @brief һδд, Ĵַ
+ * @param addr 7λַ
+ * @param data Ҫд
+ * @param len дֽ, Ϊ0
+ * @return 0-; 1-
+ */
+uint8_t IIC_Write(uint8_t addr, const uint8_t *data, uint16_t len)
+{
+  return IIC_Transfer(addr, 0, 0, 1, len, (uint8_t *)data);
+}
+
+/**
+ * @brief һδ, Ĵַ
+ * @param addr 7λַ
+ * @param data , DMAд, CCM RAM
+ * @param len ȡֽ, Ϊ0
+ * @return 0-; 1-
+ */
+uint8_t IIC_Read(uint8_t addr, uint8_t *data, uint16_t len)
+{
+  return IIC_Transfer(addr, 0, 1, 1, len, data);
+}
+
+#else
+
+static IIC_BusTypedef iicBus = IIC_BUS(IIC_SCL_PORT, IIC_SCL_PIN, IIC_SDA_PORT, IIC_SDA_PIN, IIC_SPEED);
+static uint8_t lastNack = 0;//IIC_WriteByteյӦ, IIC_WaitAck
+
+/**
+ * @brief ʼIIC
+ */
+void IIC_Init()
+{
+  if (isInitialized)
+    return;
+  IIC_InitBus(&iicBus);
   isInitialized = 1;
 }
 /**
@@ -75,99 +988,46 @@ void IIC_Init()
  */
 void IIC_Start()
 {
-  IIC_Out();//sda
-  IIC_SDA_PORT->BSRRL = IIC_SDA_PIN;//IIC_SDA=1      
-  IIC_SCL_PORT->BSRRL = IIC_SCL_PIN;//IIC_SCL=1
-  IIC_DelayUs(2);
-  IIC_SDA_PORT->BSRRH = IIC_SDA_PIN;//IIC_SDA=0 START:when CLK is high,DATA change form high to low 
-  IIC_DelayUs(2);
-  IIC_SCL_PORT->BSRRH = IIC_SCL_PIN;//ǯסI2Cߣ׼ͻ 
+  IIC_BusStart(&iicBus);
 }
 /**
  * @brief ֹͣź
  */
 void IIC_Stop()
 {
-  IIC_Out();//sda
-  IIC_SCL_PORT->BSRRH = IIC_SCL_PIN;//IIC_SCL=0
-  IIC_SDA_PORT->BSRRH = IIC_SDA_PIN;//IIC_SDA=0 STOP:when CLK is high DATA change form low to high
-  IIC_DelayUs(2);
-  IIC_SCL_PORT->BSRRL = IIC_SCL_PIN;//IIC_SCL=1
-  IIC_SDA_PORT->BSRRL = IIC_SDA_PIN;//IIC_SDA=1 I2C߽ź
-  IIC_DelayUs(2);
+  IIC_BusStop(&iicBus);
 }
 /**
  * @brief ȴӦź
  * @return 1-Ӧʧ; 0-Ӧɹ
+ * @note Ӧλ @ref IIC_WriteByte н, ﷵ.
  */
 uint8_t IIC_WaitAck()
 {
-  uint8_t ucErrTime = 0;
-  IIC_In();//SDAΪ  
-  IIC_SDA_PORT->BSRRL = IIC_SDA_PIN;//IIC_SDA=1
-  IIC_DelayUs(1);
-  IIC_SCL_PORT->BSRRL = IIC_SCL_PIN;//IIC_SCL=1
-  IIC_DelayUs(1);
-  while (IIC_SDA_PORT->IDR & IIC_SDA_PIN)
-  {
-    ucErrTime++;
-    if (ucErrTime > 250)
-    {
-      IIC_Stop();
-      return 1;
-    }
-  }
-  IIC_SCL_PORT->BSRRH = IIC_SCL_PIN;//IIC_SCL=0 ʱ0        
-  return 0;
+  if (lastNack)
+    IIC_Stop();
+  return lastNack;
 }
 /**
  * @brief Ӧź
  */
 void IIC_Ack()
 {
-  IIC_SCL_PORT->BSRRH = IIC_SCL_PIN;//IIC_SCL=0
-  IIC_Out();
-  IIC_SDA_PORT->BSRRH = IIC_SDA_PIN;//IIC_SDA=0
-  IIC_DelayUs(1);
-  IIC_SCL_PORT->BSRRL = IIC_SCL_PIN;//IIC_SCL=1
-  IIC_DelayUs(1);
-  IIC_SCL_PORT->BSRRH = IIC_SCL_PIN;//IIC_SCL=0
+  IIC_BusSendAck(&iicBus, 1);
 }
 /**
  * @brief Ӧź
  */
 void IIC_NAck()
 {
-  IIC_SCL_PORT->BSRRH = IIC_SCL_PIN;//IIC_SCL=0
-  IIC_Out();
-  IIC_SDA_PORT->BSRRL = IIC_SDA_PIN;//IIC_SDA=1
-  IIC_DelayUs(1);
-  IIC_SCL_PORT->BSRRL = IIC_SCL_PIN;//IIC_SCL=1
-  IIC_SCL_PORT->BSRRH = IIC_SCL_PIN;//IIC_SCL=0
+  IIC_BusSendAck(&iicBus, 0);
 }
 /**
- * @brief IICһֽ
+ * @brief IICһֽ,  @ref IIC_WaitAck ȡӦ
  */
 void IIC_WriteByte(uint8_t data)
 {
-  uint8_t i;
-  __IO uint32_t j;
-  IIC_Out();
-  IIC_SCL_PORT->BSRRH = IIC_SCL_PIN;//IIC_SCL=0 ʱӿʼݴ
-  for (i = 0; i < 8; i++)
-  {
-    if ((data & 0x80) >> 7)
-      IIC_SDA_PORT->BSRRL = IIC_SDA_PIN;//IIC_SDA=1
-    else
-      IIC_SDA_PORT->BSRRH = IIC_SDA_PIN;//IIC_SDA=0
-    data <<= 1;
-    j = 1;
-    while (j--);
-    IIC_SCL_PORT->BSRRL = IIC_SCL_PIN;//IIC_SCL=1
-    j = 1;
-    while (j--);
-    IIC_SCL_PORT->BSRRH = IIC_SCL_PIN;//IIC_SCL=0
-  }
+  lastNack = IIC_BusWriteByte(&iicBus, data);
 }
 /**
  * @brief 1ֽ
@@ -178,25 +1038,7 @@ void IIC_WriteByte(uint8_t data)
  */
 uint8_t IIC_ReadByte(uint8_t ack)
 {
-  uint8_t i, receive = 0;
-  __IO uint32_t j;
-  IIC_In();//SDAΪ
-  for (i = 0; i < 8; i++)
-  {
-    IIC_DelayUs(1);
-    IIC_SCL_PORT->BSRRH = IIC_SCL_PIN;//IIC_SCL=0
-    j = 10;
-    while (j--);
-    IIC_SCL_PORT->BSRRL = IIC_SCL_PIN;//IIC_SCL=1
-    receive <<= 1;
-    if (IIC_SDA_PORT->IDR & IIC_SDA_PIN)
-      receive++;
-  }
-  if (!ack)
-    IIC_NAck();//nACK
-  else
-    IIC_Ack(); //ACK   
-  return receive;
+  return IIC_BusReadByte(&iicBus, ack);
 }
 /**
  * @brief IICд1ֽڵĴ
@@ -207,23 +1049,7 @@ uint8_t IIC_ReadByte(uint8_t ack)
  */
 uint8_t IIC_WriteRegByte(uint8_t addr, uint8_t reg, uint8_t data)
 {
-  IIC_Start();
-  IIC_WriteByte(addr << 1);//ַ+д	
-  if (IIC_WaitAck())	//ȴӦ
-  {
-    IIC_Stop();
-    return 1;
-  }
-  IIC_WriteByte(reg);	//дĴַ
-  IIC_WaitAck();		//ȴӦ 
-  IIC_WriteByte(data);//
-  if (IIC_WaitAck())	//ȴACK
-  {
-    IIC_Stop();
-    return 1;
-  }
-  IIC_Stop();
-  return 0;
+  return IIC_BusWriteRegBytes(&iicBus, addr, reg, 1, &data);
 }
 /**
  * @brief IIC1ֽڵĴ
@@ -233,18 +1059,7 @@ uint8_t IIC_WriteRegByte(uint8_t addr, uint8_t reg, uint8_t data)
  */
 uint8_t IIC_ReadRegByte(uint8_t addr, uint8_t reg)
 {
-  uint8_t res;
-  IIC_Start();
-  IIC_WriteByte(addr << 1);//ַ+д	
-  IIC_WaitAck();//ȴӦ 
-  IIC_WriteByte(reg);//дĴַ
-  IIC_WaitAck();//ȴӦ
-  IIC_Start();
-  IIC_WriteByte((addr << 1) | 1);//ַ+	
-  IIC_WaitAck();//ȴӦ 
-  res = IIC_ReadByte(0);//ȡ,nACK 
-  IIC_Stop();//һֹͣ 
-  return res;
+  return IIC_BusReadRegByte(&iicBus, addr, reg);
 }
 
 /**
@@ -257,28 +1072,53 @@ uint8_t IIC_ReadRegByte(uint8_t addr, uint8_t reg)
  */
 uint8_t IIC_WriteRegBytes(uint8_t addr, uint8_t reg, uint8_t len, uint8_t * data)
 {
-  uint8_t i;
-  IIC_Start();
-  IIC_WriteByte(addr << 1);//ַ+д    
-  if (IIC_WaitAck())//ȴӦ
-  {
-    IIC_Stop();
+  return IIC_BusWriteRegBytes(&iicBus, addr, reg, len, data);
+}
+/**
+ * @brief Ƿڴ.
+ * @return IICĴ䶼ںǰ, Ƿ0.
+ */
+uint8_t IIC_IsBusy()
+{
+  return 0;
+}
+
+/**
+ * @brief IICĴ䶼ںǰ, Ҫƽ.
+ */
+void IIC_Poll()
+{
+}
+
+/**
+ * @brief дĴ, IICʱдŷزûص.
+ * @param handler õĻص, ΪNULL
+ * @return 0-
+ */
+uint8_t IIC_WriteRegBytesAsync(uint8_t addr, uint8_t reg, uint16_t len, const uint8_t *data, IIC_CompleteHandler handler)
+{
+  uint8_t result = IIC_BusWriteRegBytes(&iicBus, addr, reg, len, data);
+  if (handler != NULL)
+    handler(result);
+  return 0;
+}
+
+/**
+ * @brief Ĵ, IICʱŷزûص.
+ * @param handler õĻص, ΪNULL
+ * @return 0-; 1-lenΪ0
+ */
+uint8_t IIC_ReadRegBytesAsync(uint8_t addr, uint8_t reg, uint16_t len, uint8_t *data, IIC_CompleteHandler handler)
+{
+  uint8_t result;
+  if (len == 0)
     return 1;
-  }
-  IIC_WriteByte(reg);//дĴַ
-  IIC_WaitAck();//ȴӦ
-  for (i = 0; i < len; i++)
-  {
-    IIC_WriteByte(data[i]);//
-    if (IIC_WaitAck())//ȴACK
-    {
-      IIC_Stop();
-      return 1;
-    }
-  }
-  IIC_Stop();
+  result = IIC_BusReadRegBytes(&iicBus, addr, reg, len, data);
+  if (handler != NULL)
+    handler(result);
   return 0;
 }
+
 /**
  * @brief IIC
  * @param addr ַ
@@ -289,27 +1129,82 @@ uint8_t IIC_WriteRegBytes(uint8_t addr, uint8_t reg, uint8_t len, uint8_t * data
  */
 uint8_t IIC_ReadRegBytes(uint8_t addr, uint8_t reg, uint8_t len, uint8_t * data)
 {
-  IIC_Start();
-  IIC_WriteByte(addr << 1);//ַ+д    
-  if (IIC_WaitAck())//ȴӦ
-  {
-    IIC_Stop();
-    return 1;
-  }
-  IIC_WriteByte(reg);//дĴַ
-  IIC_WaitAck();//ȴӦ
-  IIC_Start();
-  IIC_WriteByte((addr << 1) | 1);//ַ+    
-  IIC_WaitAck();//ȴӦ 
-  while (len)
+  return IIC_BusReadRegBytes(&iicBus, addr, reg, len, data);
+}
+
+/**
+ * @brief һδд, Ĵַ
+ * @param addr 7λַ
+ * @param data Ҫд
+ * @param len дֽ
+ * @return 0-; 1-
+ */
+uint8_t IIC_Write(uint8_t addr, const uint8_t *data, uint16_t len)
+{
+  return IIC_BusWrite(&iicBus, addr, data, len);
+}
+
+/**
+ * @brief һδ, Ĵַ
+ * @param addr 7λַ
+ * @param data 
+ * @param len ȡֽ
+ * @return 0-; 1-
+ */
+uint8_t IIC_Read(uint8_t addr, uint8_t *data, uint16_t len)
+{
+  return IIC_BusRead(&iicBus, addr, data, len);
+}
+
+#endif
+
+#if IIC_USE_TRACE == 1
+/**
+ * @brief ʼͣ¼.
+ * @param newState ENABLE-¼(Ĭ); DISABLE-ͣ, еļ¼.
+ */
+void IIC_TRACE_Cmd(FunctionalState newState)
+{
+  traceEnabled = newState != DISABLE;
+}
+
+/**
+ * @brief м¼.
+ */
+void IIC_TRACE_Clear()
+{
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  traceHead = 0;
+  traceDropped = 0;
+  __set_PRIMASK(primask);
+}
+
+/**
+ * @brief printfӴм¼, Ӿɵ, ڼͣ¼.
+ * @note ʽ(ʮ):
+ *           IICTRACE <ںʱƵ> <¼> <ǵ>
+ *           <ʱ> <ʱ> <> <ַ> <Ĵַ> <ֽ> <־>
+ *           ...
+ *           IICTRACE END
+ *       ʱͳʱĵλΪںʱ. tools/iic_tracedec.cյı.
+ */
+void IIC_TRACE_Dump()
+{
+  uint32_t i, first, count;
+  uint8_t enabled = traceEnabled;
+  IIC_TRACE_RecordTypedef *record;
+  traceEnabled = 0;
+  count = traceHead < IIC_TRACE_SIZE ? traceHead : IIC_TRACE_SIZE;
+  first = traceHead - count;
+  printf("IICTRACE %lX %lX %lX\r\n", (unsigned long)SystemCoreClock, (unsigned long)count, (unsigned long)traceDropped);
+  for (i = 0; i < count; i++)
   {
-    if (len == 1)
-      * data = IIC_ReadByte(0);//,nACK 
-    else
-      *data = IIC_ReadByte(1);//,ACK  
-    len--;
-    data++;
+    record = &traceBuffer[(first + i) & (IIC_TRACE_SIZE - 1)];
+    printf("%08lX %lX %X %02X %02X %X %X\r\n", (unsigned long)record->timestamp, (unsigned long)record->duration,
+           record->bus, record->addr, record->reg, record->len, record->flags);
   }
-  IIC_Stop();//һֹͣ 
-  return 0;
+  printf("IICTRACE END\r\n");
+  traceEnabled = enabled;
 }
+#endif
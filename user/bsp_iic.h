@@ -1,7 +1,7 @@
 /**
  * @file    bsp_iic.h
  * @author  Miaow
- * @version 0.1.0
+ * @version 0.5.0
  * @date    2018/08/30
  * @brief
  *          This file provides functions to manage the following
@@ -9,7 +9,18 @@
  *              1. Initialization
  *              2. Write and read one byte
  *              3. Write and read registers of slave
+ *              4. Software IIC engine shared by drivers, one descriptor per bus,
+ *                 SCL timing calibrated by the DWT cycle counter, lock-step
+ *                 reads of several buses on one GPIO port
+ *              5. Hardware I2C1 with interrupt and DMA, blocking and asynchronous
+ *                 register access
+ *              6. Optional trace of every transfer to a RAM ring buffer, dumped
+ *                 over the serial port and decoded by tools/iic_tracedec.c
  * @note
+ *          Define IIC_HOST to build the software IIC on PC against the GPIO
+ *          model of tools/host_stm32.h, see tools/oled_emu.c.
+ *          Minimum version of source file:
+ *              0.5.0
  *          Pin connection:
  *               
  *               PB8SCL     
@@ -28,30 +39,122 @@
 
 #ifndef __BSP_IIC_H
 #define __BSP_IIC_H
-#include "stdint.h"
+#ifndef IIC_HOST
+#include "stm32f4xx.h"
+#else
+#include "host_stm32.h"
+#endif
+
+#define IIC_USE_HARDWARE        0 //!< 1-IIC_*ʹӲI2C1+DMA, ͬһŲIIC, ûڰ֤; 0-ģIIC
+#ifdef IIC_HOST
+#undef IIC_USE_HARDWARE
+#define IIC_USE_HARDWARE        0 //PCֻGPIOģ
+#endif
 
 //GPIO
-#define IIC_SCL_PORT        GPIOB
-#define IIC_SCL_PIN         GPIO_Pin_8
-#define IIC_SCL_GPIO_CLK    RCC_AHB1Periph_GPIOB
-#define IIC_SDA_PORT        GPIOB
-#define IIC_SDA_PIN         GPIO_Pin_9
-#define IIC_SDA_GPIO_CLK    RCC_AHB1Periph_GPIOB
-#define IIC_In()            IIC_SDA_PORT->MODER &= ~0x000C0000;IIC_SDA_PORT->MODER |= 0x00000000//ģʽ
-#define IIC_Out()           IIC_SDA_PORT->MODER &= ~0x000C0000;IIC_SDA_PORT->MODER |= 0x00040000//ģʽ
+#define IIC_SCL_PORT            GPIOB
+#define IIC_SCL_PIN             GPIO_Pin_8
+#define IIC_SDA_PORT            GPIOB
+#define IIC_SDA_PIN             GPIO_Pin_9
+#define IIC_SPEED               400000 //!< SCLƵ(Hz), ӲIICʱ400kHz
+
+#define IIC_USE_TRACE           0 //!< 1-ÿδ¼λ,  @ref IIC_TRACE_Dump Ӵ; 0-¼, ûκο
+#define IIC_TRACE_SIZE          256 //!< ¼, 2, ÿ16ֽ
+
+#if IIC_USE_HARDWARE == 1
+#define IIC_SCL_PINSOURCE       GPIO_PinSource8
+#define IIC_SDA_PINSOURCE       GPIO_PinSource9
+#define IIC_I2C                 I2C1
+#define IIC_I2C_CLK             RCC_APB1Periph_I2C1
+#define IIC_I2C_GPIO_AF         GPIO_AF_I2C1
+#define IIC_I2C_EV_IRQ_CHANNEL  I2C1_EV_IRQn
+#define IIC_I2C_EV_IRQ_HANDLER  I2C1_EV_IRQHandler
+#define IIC_I2C_ER_IRQ_CHANNEL  I2C1_ER_IRQn
+#define IIC_I2C_ER_IRQ_HANDLER  I2C1_ER_IRQHandler
+#define IIC_RX_DMA_CLK          RCC_AHB1Periph_DMA1
+#define IIC_RX_DMA_CHANNEL      DMA_Channel_1
+#define IIC_RX_DMA_STREAM       DMA1_Stream5
+#define IIC_RX_DMA_FLAGS        (DMA_FLAG_TCIF5 | DMA_FLAG_HTIF5 | DMA_FLAG_TEIF5 | DMA_FLAG_DMEIF5 | DMA_FLAG_FEIF5)
+#define IIC_RX_DMA_IT_TC        DMA_IT_TCIF5
+#define IIC_RX_DMA_IRQ_CHANNEL  DMA1_Stream5_IRQn
+#define IIC_RX_DMA_IRQ_HANDLER  DMA1_Stream5_IRQHandler
+#endif
+
+/**
+ * @brief IIC.
+ * @note  @ref IIC_BUS , ʹǰ @ref IIC_InitBus.
+ */
+typedef struct
+{
+  GPIO_TypeDef *sclPort;
+  uint16_t sclPin;
+  GPIO_TypeDef *sdaPort;
+  uint16_t sdaPin;
+  uint32_t frequency;//SCLƵ(Hz), 100000, 400000, 1000000
+  uint32_t halfPeriod;//SCLڵںʱ, IIC_InitBus
+  uint32_t sdaModer;//SDAMODERеλ, IIC_InitBus
+  uint32_t edge;//һSCL/SDAصʱ(ںʱ)
+#if IIC_USE_TRACE == 1
+  uint8_t id;//ټ¼е, IIC_InitBus, 1ʼ; 0ΪӲIIC
+#endif
+} IIC_BusTypedef;
+
+/**
+ * @brief IICĳֵ.
+ */
+#define IIC_BUS(sclPort, sclPin, sdaPort, sdaPin, frequency)  {sclPort, sclPin, sdaPort, sdaPin, frequency, 0, 0, 0}
+
+void IIC_InitBus(IIC_BusTypedef *bus);
+void IIC_BusStart(IIC_BusTypedef *bus);
+void IIC_BusStop(IIC_BusTypedef *bus);
+uint8_t IIC_BusWriteByte(IIC_BusTypedef *bus, uint8_t data);
+uint8_t IIC_BusReadByte(IIC_BusTypedef *bus, uint8_t ack);
+uint8_t IIC_BusWrite(IIC_BusTypedef *bus, uint8_t addr, const uint8_t *data, uint16_t len);
+uint8_t IIC_BusRead(IIC_BusTypedef *bus, uint8_t addr, uint8_t *data, uint16_t len);
+uint8_t IIC_BusWriteRegByte(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg, uint8_t data);
+uint8_t IIC_BusReadRegByte(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg);
+uint8_t IIC_BusWriteRegBytes(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg, uint16_t len, const uint8_t *data);
+uint8_t IIC_BusReadRegBytes(IIC_BusTypedef *bus, uint8_t addr, uint8_t reg, uint16_t len, uint8_t *data);
+uint8_t IIC_BusReadRegBytesParallel(IIC_BusTypedef * const *buses, uint8_t count, const uint8_t *addr, uint8_t reg, uint16_t len, uint8_t *data);
+
+/**
+ * @brief 첽ɵĻص, ӲIICʱже.
+ * @param result 0-; 1-.
+ */
+typedef void (*IIC_CompleteHandler)(uint8_t result);
 
+/**
+ * @brief ߿кõĺ,  @ref IIC_SetIdleHandler.
+ */
+typedef void (*IIC_IdleHandler)(void);
 
+#if IIC_USE_HARDWARE == 0
 void IIC_Start(void);
 void IIC_Stop(void);
 uint8_t IIC_WaitAck(void);
 void IIC_Ack(void);
 void IIC_NAck(void);
-void IIC_Init(void);
 void IIC_WriteByte(uint8_t data);
 uint8_t IIC_ReadByte(uint8_t ack);
+#endif
+void IIC_Init(void);
+uint8_t IIC_IsBusy(void);
+void IIC_Poll(void);
+#if IIC_USE_HARDWARE == 1
+void IIC_SetIdleHandler(IIC_IdleHandler handler);
+#endif
+uint8_t IIC_WriteRegBytesAsync(uint8_t addr, uint8_t reg, uint16_t len, const uint8_t *data, IIC_CompleteHandler handler);
+uint8_t IIC_ReadRegBytesAsync(uint8_t addr, uint8_t reg, uint16_t len, uint8_t *data, IIC_CompleteHandler handler);
 uint8_t IIC_WriteRegByte(uint8_t addr, uint8_t reg, uint8_t data);
 uint8_t IIC_ReadRegByte(uint8_t addr, uint8_t reg);
 uint8_t IIC_WriteRegBytes(uint8_t addr, uint8_t reg, uint8_t len, uint8_t* data);
 uint8_t IIC_ReadRegBytes(uint8_t addr, uint8_t reg, uint8_t len, uint8_t* data);
+uint8_t IIC_Write(uint8_t addr, const uint8_t *data, uint16_t len);
+uint8_t IIC_Read(uint8_t addr, uint8_t *data, uint16_t len);
+#if IIC_USE_TRACE == 1
+void IIC_TRACE_Cmd(FunctionalState newState);
+void IIC_TRACE_Clear(void);
+void IIC_TRACE_Dump(void);
+#endif
 
 #endif
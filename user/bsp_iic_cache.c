@@ -0,0 +1,214 @@
+/**
+ * @file    bsp_iic_cache.c
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2019/08/24
+ * @brief
+ *          This file provides functions to manage the following
+ *          functionalities of IIC register shadow cache:
+ *              1. Keep a local copy of the configuration registers of a device
+ *              2. Skip writes that do not change the register
+ *              3. Serve read-modify-writes locally
+ *              4. Stage writes and flush the dirty registers in bursts
+ * @note
+ *          Minimum version of header file:
+ *              0.1.0
+ *          A register is valid once it has been read, written or preset.
+ *          A failed transfer makes the register invalid again, so the next
+ *          access goes to the device.
+ *
+ *          The source code repository is available on GitHub:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#include "bsp_iic_cache.h"
+#include "utils.h"
+
+#define IIC_CACHE_TEST(map, offset)     ((map)[(offset) >> 5] & (1UL << ((offset) & 31)))
+#define IIC_CACHE_SET(map, offset)      ((map)[(offset) >> 5] |= 1UL << ((offset) & 31))
+#define IIC_CACHE_RESET(map, offset)    ((map)[(offset) >> 5] &= ~(1UL << ((offset) & 31)))
+
+/**
+ * @brief Ĵڻе.
+ * @return ; -1-ڻ淶Χ.
+ */
+static int16_t IIC_CACHE_Offset(IIC_CACHE_DeviceTypedef *device, uint8_t reg)
+{
+  uint8_t offset = reg - device->firstReg;
+  return offset < device->count ? offset : -1;
+}
+
+/**
+ * @brief дĴ.
+ * @return 0-; 1-.
+ */
+static uint8_t IIC_CACHE_WriteDevice(IIC_CACHE_DeviceTypedef *device, uint8_t reg, uint8_t len, uint8_t *data)
+{
+  if (device->bus == NULL)
+    return IIC_WriteRegBytes(device->addr, reg, len, data);
+  return IIC_BusWriteRegBytes(device->bus, device->addr, reg, len, data);
+}
+
+/**
+ * @brief 1Ĵ.
+ * @return 0-; 1-.
+ */
+static uint8_t IIC_CACHE_ReadDevice(IIC_CACHE_DeviceTypedef *device, uint8_t reg, uint8_t *data)
+{
+  if (device->bus == NULL)
+    return IIC_ReadRegBytes(device->addr, reg, 1, data);
+  return IIC_BusReadRegBytes(device->bus, device->addr, reg, 1, data);
+}
+
+/**
+ * @brief ʹлЧ, ݴд.
+ * @param device .
+ * @note λ, ƹд˼Ĵ.
+ */
+void IIC_CACHE_Invalidate(IIC_CACHE_DeviceTypedef *device)
+{
+  uint8_t i;
+  for (i = 0; i < 8; i++)
+  {
+    device->valid[i] = 0;
+    device->dirty[i] = 0;
+  }
+}
+
+/**
+ * @brief ¼Ĵֵ֪, .
+ * @param device .
+ * @param reg Ĵַ, ڻ淶Χʱ.
+ * @param value Ĵǰֵ, 縴λĬֵ.
+ */
+void IIC_CACHE_Preset(IIC_CACHE_DeviceTypedef *device, uint8_t reg, uint8_t value)
+{
+  int16_t offset = IIC_CACHE_Offset(device, reg);
+  if (offset < 0)
+    return;
+  device->values[offset] = value;
+  IIC_CACHE_SET(device->valid, offset);
+  IIC_CACHE_RESET(device->dirty, offset);
+}
+
+/**
+ * @brief Ĵ, Чʱ.
+ * @param device .
+ * @param reg Ĵַ.
+ * @param value ֵ, ݴδдļĴݴֵ.
+ * @return 0-; 1-.
+ */
+uint8_t IIC_CACHE_Read(IIC_CACHE_DeviceTypedef *device, uint8_t reg, uint8_t *value)
+{
+  int16_t offset = IIC_CACHE_Offset(device, reg);
+  if (offset >= 0 && IIC_CACHE_TEST(device->valid, offset))
+  {
+    *value = device->values[offset];
+    return 0;
+  }
+  if (IIC_CACHE_ReadDevice(device, reg, value))
+    return 1;
+  if (offset >= 0)
+    IIC_CACHE_Preset(device, reg, *value);
+  return 0;
+}
+
+/**
+ * @brief дĴ, ֵ뻺ͬʱ.
+ * @param device .
+ * @param reg Ĵַ.
+ * @param value Ҫдֵ.
+ * @return 0-; 1-.
+ */
+uint8_t IIC_CACHE_Write(IIC_CACHE_DeviceTypedef *device, uint8_t reg, uint8_t value)
+{
+  int16_t offset = IIC_CACHE_Offset(device, reg);
+  if (offset < 0)
+    return IIC_CACHE_WriteDevice(device, reg, 1, &value);
+  if (IIC_CACHE_TEST(device->valid, offset) && !IIC_CACHE_TEST(device->dirty, offset) && device->values[offset] == value)
+    return 0;
+  if (IIC_CACHE_WriteDevice(device, reg, 1, &value))
+  {
+    IIC_CACHE_RESET(device->valid, offset);
+    IIC_CACHE_RESET(device->dirty, offset);
+    return 1;
+  }
+  IIC_CACHE_Preset(device, reg, value);
+  return 0;
+}
+
+/**
+ * @brief ޸ļĴĲλ.
+ * @param device .
+ * @param reg Ĵַ.
+ * @param mask Ҫ޸ĵλ.
+ * @param value µֵ, ֻmaskеλ.
+ * @return 0-; 1-.
+ * @note Чʱֻд, ʱ.
+ */
+uint8_t IIC_CACHE_Modify(IIC_CACHE_DeviceTypedef *device, uint8_t reg, uint8_t mask, uint8_t value)
+{
+  uint8_t old;
+  if (IIC_CACHE_Read(device, reg, &old))
+    return 1;
+  return IIC_CACHE_Write(device, reg, (old & ~mask) | (value & mask));
+}
+
+/**
+ * @brief ݴд,  @ref IIC_CACHE_Flush д.
+ * @param device .
+ * @param reg Ĵַ, ڻ淶Χʱд.
+ * @param value Ҫдֵ.
+ * @return 0-; 1-.
+ */
+uint8_t IIC_CACHE_Stage(IIC_CACHE_DeviceTypedef *device, uint8_t reg, uint8_t value)
+{
+  int16_t offset = IIC_CACHE_Offset(device, reg);
+  if (offset < 0)
+    return IIC_CACHE_WriteDevice(device, reg, 1, &value);
+  if (IIC_CACHE_TEST(device->valid, offset) && device->values[offset] == value)
+    return 0;
+  device->values[offset] = value;
+  IIC_CACHE_SET(device->valid, offset);
+  IIC_CACHE_SET(device->dirty, offset);
+  return 0;
+}
+
+/**
+ * @brief ַ˳дݴļĴ.
+ * @param device .
+ * @return 0-; 1-, ļĴЧ.
+ * @note burstΪ1ʱĴһд.
+ */
+uint8_t IIC_CACHE_Flush(IIC_CACHE_DeviceTypedef *device)
+{
+  uint16_t offset = 0, end, i;
+  uint8_t result = 0;
+  while (offset < device->count)
+  {
+    if (!IIC_CACHE_TEST(device->dirty, offset))
+    {
+      offset++;
+      continue;
+    }
+    end = offset + 1;
+    if (device->burst)
+      while (end < device->count && end - offset < 255 && IIC_CACHE_TEST(device->dirty, end))
+        end++;
+    if (IIC_CACHE_WriteDevice(device, device->firstReg + offset, end - offset, device->values + offset))
+    {
+      result = 1;
+      for (i = offset; i < end; i++)
+        IIC_CACHE_RESET(device->valid, i);
+    }
+    for (i = offset; i < end; i++)
+      IIC_CACHE_RESET(device->dirty, i);
+    offset = end;
+  }
+  return result;
+}
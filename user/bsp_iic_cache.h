@@ -0,0 +1,68 @@
+/**
+ * @file    bsp_iic_cache.h
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2019/08/24
+ * @brief
+ *          This file provides functions to manage the following
+ *          functionalities of IIC register shadow cache:
+ *              1. Keep a local copy of the configuration registers of a device
+ *              2. Skip writes that do not change the register
+ *              3. Serve read-modify-writes locally
+ *              4. Stage writes and flush the dirty registers in bursts
+ * @note
+ *          Minimum version of source file:
+ *              0.1.0
+ *          Usage:
+ *              static uint8_t mpu6050Registers[0x20];
+ *              static IIC_CACHE_DeviceTypedef mpu6050Cache = IIC_CACHE_DEVICE(NULL, 0x68, 1, 0x19, 0x20, mpu6050Registers);
+ *              IIC_CACHE_Stage(&mpu6050Cache, 0x1B, 0x18);
+ *              IIC_CACHE_Stage(&mpu6050Cache, 0x1C, 0x00);
+ *              IIC_CACHE_Flush(&mpu6050Cache);
+ *          Only cache registers that the device never changes by itself.
+ *          Call IIC_CACHE_Invalidate after the device is reset or written
+ *          without going through the cache.
+ *
+ *          The source code repository is available on GitHub:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#ifndef __BSP_IIC_CACHE_H
+#define __BSP_IIC_CACHE_H
+#include "bsp_iic.h"
+
+/**
+ * @brief Ĵ.
+ * @note  @ref IIC_CACHE_DEVICE . firstRegcountĴ, ΧļĴֱӶд.
+ */
+typedef struct
+{
+  IIC_BusTypedef *bus;//IIC; NULL-IIC_*
+  uint8_t addr;//7λַ
+  uint8_t burst;//1-ĴַԶ, Ĵһд; 0-д
+  uint8_t firstReg;//ĵһĴ
+  uint16_t count;//ļĴ, 1~256
+  uint8_t *values;//countֽڵĻ
+  uint32_t valid[8];//ЧļĴ, ÿλһ
+  uint32_t dirty[8];//ݴδдļĴ, ÿλһ
+} IIC_CACHE_DeviceTypedef;
+
+/**
+ * @brief Ĵĳֵ, ʼЧ.
+ */
+#define IIC_CACHE_DEVICE(bus, addr, burst, firstReg, count, values) {bus, addr, burst, firstReg, count, values, {0}, {0}}
+
+void IIC_CACHE_Invalidate(IIC_CACHE_DeviceTypedef *device);
+void IIC_CACHE_Preset(IIC_CACHE_DeviceTypedef *device, uint8_t reg, uint8_t value);
+uint8_t IIC_CACHE_Read(IIC_CACHE_DeviceTypedef *device, uint8_t reg, uint8_t *value);
+uint8_t IIC_CACHE_Write(IIC_CACHE_DeviceTypedef *device, uint8_t reg, uint8_t value);
+uint8_t IIC_CACHE_Modify(IIC_CACHE_DeviceTypedef *device, uint8_t reg, uint8_t mask, uint8_t value);
+uint8_t IIC_CACHE_Stage(IIC_CACHE_DeviceTypedef *device, uint8_t reg, uint8_t value);
+uint8_t IIC_CACHE_Flush(IIC_CACHE_DeviceTypedef *device);
+
+#endif
@@ -0,0 +1,435 @@
+/**
+ * @file    bsp_iic_sched.c
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2019/08/20
+ * @brief
+ *          This file provides functions to manage the following
+ *          functionalities of IIC transaction scheduler:
+ *              1. Queue register reads and writes of several devices sharing
+ *                 the bus of bsp_iic, run them in the background
+ *              2. Per-device priorities and deadlines
+ *              3. Batch back-to-back register reads of one device into one transfer
+ *              4. Per-device latency and bus utilisation statistics
+ * @note
+ *          Minimum version of header file:
+ *              0.1.0
+ *          Requests wait in a list. When the bus is free, the request of
+ *          the highest priority is started; ties go to the earliest deadline,
+ *          then to the earliest submission. Reads of the same device whose
+ *          register ranges touch are merged into that transfer.
+ *          With IIC_USE_HARDWARE = 0 the transfers run in the caller.
+ *
+ *          The source code repository is available on GitHub:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#include "bsp_iic_sched.h"
+#include "utils.h"
+
+static IIC_SCHED_RequestTypedef *pendingHead = NULL;//ȴ, ڱͷ
+static IIC_SCHED_RequestTypedef *batch[IIC_SCHED_BATCH_MAX];//ڴ
+static uint8_t batchCount = 0;
+static uint8_t batchReg;
+static uint16_t batchLength;
+static uint8_t batchBuffer[IIC_SCHED_BATCH_SIZE];//ϲȡʱĽջ
+static __IO uint8_t busy = 0;
+static uint32_t transferStart;//δ俪ʼʱ(ںʱ)
+static uint32_t cyclesPerUs = 1;
+static IIC_SCHED_StatisticsTypedef busStatistics = {0};
+static uint32_t statisticsStamp;//elapsedUsͳƵʱ(ںʱ)
+static uint8_t isInitialized = 0;
+
+static void IIC_SCHED_Dispatch(void);
+
+/**
+ * @brief ѴstatisticsStampڵʱelapsedUs.
+ */
+static void IIC_SCHED_UpdateElapsed(uint32_t now)
+{
+  uint32_t us = (now - statisticsStamp) / cyclesPerUs;
+  busStatistics.elapsedUs += us;
+  statisticsStamp += us * cyclesPerUs;
+}
+
+/**
+ * @brief aǷӦbǰ.
+ */
+static uint8_t IIC_SCHED_IsBefore(IIC_SCHED_RequestTypedef *a, IIC_SCHED_RequestTypedef *b)
+{
+  if (a->device->priority != b->device->priority)
+    return a->device->priority < b->device->priority;
+  if (a->deadlineUs && b->deadlineUs && a->deadline != b->deadline)
+    return (int32_t)(a->deadline - b->deadline) < 0;
+  if (!a->deadlineUs != !b->deadlineUs)
+    return a->deadlineUs != 0;
+  return (int32_t)(a->submitTime - b->submitTime) < 0;
+}
+
+/**
+ * @brief ¼һĽûص.
+ */
+static void IIC_SCHED_Finish(IIC_SCHED_RequestTypedef *request, IIC_SCHED_StatusTypedef status, uint32_t now)
+{
+  IIC_SCHED_DeviceTypedef *device = request->device;
+  uint32_t latencyUs = (now - request->submitTime) / cyclesPerUs;
+  if (status == IIC_SCHED_Expired || (request->deadlineUs && (int32_t)(now - request->deadline) > 0))
+    device->deadlineMisses++;
+  if (status != IIC_SCHED_Expired)
+  {
+    device->requests++;
+    device->bytes += request->len;
+    device->latencySumUs += latencyUs;
+    if (latencyUs > device->latencyMaxUs)
+      device->latencyMaxUs = latencyUs;
+    if (status == IIC_SCHED_Error)
+      device->errors++;
+  }
+  request->status = status;
+  if (request->handler != NULL)
+    request->handler(request);
+}
+
+/**
+ * @brief , IICже.
+ * @param result 0-; 1-.
+ */
+static void IIC_SCHED_Complete(uint8_t result)
+{
+  uint8_t i;
+  uint32_t now = UTILS_GetCycleCount();
+  busStatistics.transfers++;
+  busStatistics.batchedRequests += batchCount - 1;
+  busStatistics.busTimeUs += (now - transferStart) / cyclesPerUs;
+  IIC_SCHED_UpdateElapsed(now);
+  for (i = 0; i < batchCount; i++)
+  {
+    if (batchCount > 1 && !result)
+      memcpy(batch[i]->data, batchBuffer + (batch[i]->reg - batchReg), batch[i]->len);
+    IIC_SCHED_Finish(batch[i], result ? IIC_SCHED_Error : IIC_SCHED_Done, now);
+  }
+  batchCount = 0;
+  busy = 0;
+  IIC_SCHED_Dispatch();
+}
+
+/**
+ * @brief ߿ʱӶȡһ󲢿ʼ.
+ * @note ̺߳же. ѳֹʱֱӶ.
+ */
+static void IIC_SCHED_Dispatch()
+{
+  IIC_SCHED_RequestTypedef *request, **link, **bestLink = NULL, *best, *expired = NULL;
+  uint8_t grown, result;
+  uint32_t now, primask;
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+  if (busy)
+  {
+    __set_PRIMASK(primask);
+    return;
+  }
+  now = UTILS_GetCycleCount();
+  link = &pendingHead;
+  while ((request = *link) != NULL)
+  {
+    if (request->deadlineUs && (int32_t)(now - request->deadline) > 0)
+    {
+      *link = request->next;
+      request->next = expired;
+      expired = request;
+      continue;
+    }
+    if (bestLink == NULL || IIC_SCHED_IsBefore(request, *bestLink))
+      bestLink = link;
+    link = &request->next;
+  }
+  if (bestLink != NULL)
+  {
+    best = *bestLink;
+    *bestLink = best->next;
+    batch[0] = best;
+    batchCount = 1;
+    batchReg = best->reg;
+    batchLength = best->len;
+    //ϲͬһĴβӵĶ
+    grown = best->read && best->device->batch;
+    while (grown && batchCount < IIC_SCHED_BATCH_MAX)
+    {
+      grown = 0;
+      for (link = &pendingHead; (request = *link) != NULL; link = &request->next)
+      {
+        if (request->device != best->device || !request->read || batchLength + request->len > IIC_SCHED_BATCH_SIZE)
+          continue;
+        if (request->reg + request->len == batchReg)
+          batchReg = request->reg;
+        else if (request->reg != batchReg + batchLength)
+          continue;
+        batchLength += request->len;
+        *link = request->next;
+        batch[batchCount++] = request;
+        grown = 1;
+        break;
+      }
+    }
+    for (grown = 0; grown < batchCount; grown++)
+      batch[grown]->status = IIC_SCHED_Busy;
+    busy = 1;
+  }
+  __set_PRIMASK(primask);
+
+  while (expired != NULL)
+  {
+    request = expired;
+    expired = request->next;
+    IIC_SCHED_Finish(request, IIC_SCHED_Expired, now);
+  }
+  if (bestLink == NULL)
+    return;
+
+  transferStart = UTILS_GetCycleCount();
+  if (best->read)
+    result = IIC_ReadRegBytesAsync(best->device->addr, batchReg, batchLength, batchCount > 1 ? batchBuffer : best->data, IIC_SCHED_Complete);
+  else
+    result = IIC_WriteRegBytesAsync(best->device->addr, best->reg, best->len, best->data, IIC_SCHED_Complete);
+  if (result)
+  {
+    //߱ƹĴռ, Żض, ǴδIIC_SCHED_Poll
+    primask = __get_PRIMASK();
+    __disable_irq();
+    while (batchCount)
+    {
+      request = batch[--batchCount];
+      request->status = IIC_SCHED_Pending;
+      request->next = pendingHead;
+      pendingHead = request;
+    }
+    busy = 0;
+    __set_PRIMASK(primask);
+  }
+}
+
+/**
+ * @brief ʼIIC͵.
+ * @note ʹõĸ, ֻеһЧ.
+ *       ӲIICʱIIC_SCHED_PollΪ߿лص, ֱӵIIC_*ĴʼŶӵ.
+ */
+void IIC_SCHED_Init()
+{
+  if (isInitialized)
+    return;
+  IIC_Init();
+  UTILS_InitCycleCounter();
+  cyclesPerUs = SystemCoreClock / 1000000;
+  IIC_SCHED_ResetStatistics();
+#if IIC_USE_HARDWARE == 1
+  IIC_SetIdleHandler(IIC_SCHED_Poll);
+#endif
+  isInitialized = 1;
+}
+
+/**
+ * @brief ύһõ.
+ * @param request , ǰ޸.
+ * @return 0-ύ; 1-ûɻ0ֽ.
+ * @note же.
+ */
+uint8_t IIC_SCHED_Submit(IIC_SCHED_RequestTypedef *request)
+{
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  if (request->status == IIC_SCHED_Pending || request->status == IIC_SCHED_Busy || (request->read && request->len == 0))
+  {
+    __set_PRIMASK(primask);
+    return 1;
+  }
+  request->submitTime = UTILS_GetCycleCount();
+  request->deadline = request->submitTime + request->deadlineUs * cyclesPerUs;
+  request->status = IIC_SCHED_Pending;
+  request->next = pendingHead;
+  pendingHead = request;
+  __set_PRIMASK(primask);
+  IIC_SCHED_Dispatch();
+  return 0;
+}
+
+/**
+ * @brief ύĴ.
+ * @param request , ǰ޸.
+ * @param device .
+ * @param reg Ĵַ.
+ * @param len ȡֽ, Ϊ0.
+ * @param data , DMAд, CCM RAM.
+ * @param deadlineUs ֹʱ(us), 0-ûнֹʱ.
+ * @param handler ɺõĻص, ΪNULL.
+ * @return 0-ύ; 1-ûɻlenΪ0.
+ */
+uint8_t IIC_SCHED_Read(IIC_SCHED_RequestTypedef *request, IIC_SCHED_DeviceTypedef *device, uint8_t reg, uint16_t len, uint8_t *data, uint32_t deadlineUs, IIC_SCHED_Handler handler)
+{
+  if (request->status == IIC_SCHED_Pending || request->status == IIC_SCHED_Busy)
+    return 1;
+  request->device = device;
+  request->read = 1;
+  request->reg = reg;
+  request->len = len;
+  request->data = data;
+  request->deadlineUs = deadlineUs;
+  request->handler = handler;
+  return IIC_SCHED_Submit(request);
+}
+
+/**
+ * @brief ύдĴ.
+ * @param request , ǰ޸.
+ * @param device .
+ * @param reg Ĵַ.
+ * @param len дֽ.
+ * @param data Ҫд, ǰ޸.
+ * @param deadlineUs ֹʱ(us), 0-ûнֹʱ.
+ * @param handler ɺõĻص, ΪNULL.
+ * @return 0-ύ; 1-û.
+ */
+uint8_t IIC_SCHED_Write(IIC_SCHED_RequestTypedef *request, IIC_SCHED_DeviceTypedef *device, uint8_t reg, uint16_t len, const uint8_t *data, uint32_t deadlineUs, IIC_SCHED_Handler handler)
+{
+  if (request->status == IIC_SCHED_Pending || request->status == IIC_SCHED_Busy)
+    return 1;
+  request->device = device;
+  request->read = 0;
+  request->reg = reg;
+  request->len = len;
+  request->data = (uint8_t *)data;
+  request->deadlineUs = deadlineUs;
+  request->handler = handler;
+  return IIC_SCHED_Submit(request);
+}
+
+/**
+ * @brief ȴ.
+ * @return 0-; 1-򱻶.
+ * @note ӲIICʱκже, IICжϲռʱ @ref IIC_Poll ƽ.
+ *       IICĴڷͬ, жеöϵĴռʱ,
+ *       󲻻ٿʼ, ʱӶȡ.
+ */
+uint8_t IIC_SCHED_Wait(IIC_SCHED_RequestTypedef *request)
+{
+#if IIC_USE_HARDWARE == 0
+  IIC_SCHED_RequestTypedef **link;
+  uint32_t primask;
+
+  if (__get_IPSR() != 0)
+  {
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if (busy && request->status == IIC_SCHED_Pending)
+    {
+      for (link = &pendingHead; *link != request; link = &(*link)->next)
+        ;
+      *link = request->next;
+      __set_PRIMASK(primask);
+      IIC_SCHED_Finish(request, IIC_SCHED_Error, UTILS_GetCycleCount());
+      return 1;
+    }
+    __set_PRIMASK(primask);
+  }
+#endif
+  while (request->status == IIC_SCHED_Pending || request->status == IIC_SCHED_Busy)
+  {
+    IIC_Poll();
+    IIC_SCHED_Poll();
+  }
+  return request->status != IIC_SCHED_Done;
+}
+
+/**
+ * @brief Ĵ, ŷ.
+ * @param device .
+ * @param reg Ĵַ.
+ * @param len ȡֽ, Ϊ0.
+ * @param data , DMAд, CCM RAM.
+ * @return 0-; 1-.
+ * @note IIC_ReadRegBytes, ȼŶ, жеõƼ @ref IIC_SCHED_Wait.
+ */
+uint8_t IIC_SCHED_ReadRegBytes(IIC_SCHED_DeviceTypedef *device, uint8_t reg, uint16_t len, uint8_t *data)
+{
+  IIC_SCHED_RequestTypedef request;
+  request.status = IIC_SCHED_Idle;
+  if (IIC_SCHED_Read(&request, device, reg, len, data, 0, NULL))
+    return 1;
+  return IIC_SCHED_Wait(&request);
+}
+
+/**
+ * @brief дĴ, дŷ.
+ * @param device .
+ * @param reg Ĵַ.
+ * @param len дֽ.
+ * @param data Ҫд.
+ * @return 0-; 1-.
+ * @note IIC_WriteRegBytes, ȼŶ, жеõƼ @ref IIC_SCHED_Wait.
+ */
+uint8_t IIC_SCHED_WriteRegBytes(IIC_SCHED_DeviceTypedef *device, uint8_t reg, uint16_t len, const uint8_t *data)
+{
+  IIC_SCHED_RequestTypedef request;
+  request.status = IIC_SCHED_Idle;
+  if (IIC_SCHED_Write(&request, device, reg, len, data, 0, NULL))
+    return 1;
+  return IIC_SCHED_Wait(&request);
+}
+
+/**
+ * @brief ߿жвʱʼ.
+ * @note ӲIICʱ߿лص,  @ref IIC_SCHED_Init; Ҳѭе.
+ */
+void IIC_SCHED_Poll()
+{
+  if (!busy && pendingHead != NULL)
+    IIC_SCHED_Dispatch();
+}
+
+/**
+ * @brief ȡͳ.
+ * @param statistics ͳֵ.
+ */
+void IIC_SCHED_GetStatistics(IIC_SCHED_StatisticsTypedef *statistics)
+{
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  IIC_SCHED_UpdateElapsed(UTILS_GetCycleCount());
+  *statistics = busStatistics;
+  __set_PRIMASK(primask);
+  statistics->utilisation = statistics->elapsedUs ? (uint16_t)((uint64_t)statistics->busTimeUs * 1000 / statistics->elapsedUs) : 0;
+}
+
+/**
+ * @brief ͳ.
+ */
+void IIC_SCHED_ResetStatistics()
+{
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  memset(&busStatistics, 0, sizeof(busStatistics));
+  statisticsStamp = UTILS_GetCycleCount();
+  __set_PRIMASK(primask);
+}
+
+/**
+ * @brief ͳֵ.
+ */
+void IIC_SCHED_ResetDeviceStatistics(IIC_SCHED_DeviceTypedef *device)
+{
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  device->requests = 0;
+  device->errors = 0;
+  device->deadlineMisses = 0;
+  device->bytes = 0;
+  device->latencySumUs = 0;
+  device->latencyMaxUs = 0;
+  __set_PRIMASK(primask);
+}
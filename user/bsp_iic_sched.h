@@ -0,0 +1,131 @@
+/**
+ * @file    bsp_iic_sched.h
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2019/08/20
+ * @brief
+ *          This file provides functions to manage the following
+ *          functionalities of IIC transaction scheduler:
+ *              1. Queue register reads and writes of several devices sharing
+ *                 the bus of bsp_iic, run them in the background
+ *              2. Per-device priorities and deadlines
+ *              3. Batch back-to-back register reads of one device into one transfer
+ *              4. Per-device latency and bus utilisation statistics
+ * @note
+ *          Minimum version of source file:
+ *              0.1.0
+ *          Usage:
+ *              static IIC_SCHED_DeviceTypedef bmp280 = IIC_SCHED_DEVICE(0x76, 2, 1);
+ *              static IIC_SCHED_RequestTypedef request;
+ *              IIC_SCHED_Init();
+ *              IIC_SCHED_Read(&request, &bmp280, 0xF7, 6, data, 5000, handler);
+ *          Requests are owned by the caller and must stay valid until they complete.
+ *          Blocking drivers use IIC_SCHED_ReadRegBytes and IIC_SCHED_WriteRegBytes.
+ *          With IIC_USE_HARDWARE == 1 they may be called from any interrupt.
+ *          With the software IIC they fail instead of waiting when called from
+ *          an interrupt that preempted a transfer in progress.
+ *          Direct IIC_* transfers may still run; requests queued behind one
+ *          start as soon as it ends.
+ *
+ *          The source code repository is available on GitHub:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#ifndef __BSP_IIC_SCHED_H
+#define __BSP_IIC_SCHED_H
+#include "bsp_iic.h"
+
+#define IIC_SCHED_BATCH_SIZE    32 //!< ϲȡֽ
+#define IIC_SCHED_BATCH_MAX     4 //!< һδϲ
+
+/**
+ * @brief ϵ.
+ * @note  @ref IIC_SCHED_DEVICE . ǰ3Ϊͳֵ, ֻ.
+ */
+typedef struct
+{
+  uint8_t addr;//7λַ
+  uint8_t priority;//ȼ, 0
+  uint8_t batch;//1-ڼĴĶϲһδ; 0-ϲ, FIFOȶиõļĴ
+  uint32_t requests;//ɵ, 
+  uint32_t errors;//
+  uint32_t deadlineMisses;//ֹʱɻ򱻶
+  uint32_t bytes;//дֽ
+  uint32_t latencySumUs;//ύɵʱ֮(us)
+  uint32_t latencyMaxUs;//ύɵʱ(us)
+} IIC_SCHED_DeviceTypedef;
+
+/**
+ * @brief ĳֵ.
+ */
+#define IIC_SCHED_DEVICE(addr, priority, batch)     {addr, priority, batch, 0, 0, 0, 0, 0, 0}
+
+/**
+ * @brief ״̬.
+ */
+typedef enum
+{
+  IIC_SCHED_Idle = 0,//δύ
+  IIC_SCHED_Pending,//ڶеȴ
+  IIC_SCHED_Busy,//ڴ
+  IIC_SCHED_Done,//
+  IIC_SCHED_Error,//
+  IIC_SCHED_Expired//ʼǰѳֹʱ, 
+} IIC_SCHED_StatusTypedef;
+
+typedef struct IIC_SCHED_RequestStruct IIC_SCHED_RequestTypedef;
+
+/**
+ * @brief ɵĻص, ӲIICʱже, ٴύ.
+ */
+typedef void (*IIC_SCHED_Handler)(IIC_SCHED_RequestTypedef *request);
+
+/**
+ * @brief һμĴд.
+ */
+struct IIC_SCHED_RequestStruct
+{
+  IIC_SCHED_DeviceTypedef *device;
+  uint8_t read;//0-дĴ; 1-Ĵ
+  uint8_t reg;//Ĵַ
+  uint16_t len;//ֽ
+  uint8_t *data;//д, ǰ޸
+  uint32_t deadlineUs;//ύĽֹʱ(us), 10s; 0-ûнֹʱ
+  IIC_SCHED_Handler handler;//ΪNULL
+  void *context;//
+  __IO IIC_SCHED_StatusTypedef status;
+  uint32_t submitTime;//ύʱ(ںʱ)
+  uint32_t deadline;//ֹʱ(ںʱ)
+  IIC_SCHED_RequestTypedef *next;
+};
+
+/**
+ * @brief ͳ.
+ */
+typedef struct
+{
+  uint32_t transfers;//ߴ
+  uint32_t batchedRequests;//ϲĴе
+  uint32_t busTimeUs;//ռߵʱ(us)
+  uint32_t elapsedUs;//ͳƵʱ(us)
+  uint16_t utilisation;//ռ(0.1%)
+} IIC_SCHED_StatisticsTypedef;
+
+void IIC_SCHED_Init(void);
+uint8_t IIC_SCHED_Submit(IIC_SCHED_RequestTypedef *request);
+uint8_t IIC_SCHED_Read(IIC_SCHED_RequestTypedef *request, IIC_SCHED_DeviceTypedef *device, uint8_t reg, uint16_t len, uint8_t *data, uint32_t deadlineUs, IIC_SCHED_Handler handler);
+uint8_t IIC_SCHED_Write(IIC_SCHED_RequestTypedef *request, IIC_SCHED_DeviceTypedef *device, uint8_t reg, uint16_t len, const uint8_t *data, uint32_t deadlineUs, IIC_SCHED_Handler handler);
+uint8_t IIC_SCHED_Wait(IIC_SCHED_RequestTypedef *request);
+uint8_t IIC_SCHED_ReadRegBytes(IIC_SCHED_DeviceTypedef *device, uint8_t reg, uint16_t len, uint8_t *data);
+uint8_t IIC_SCHED_WriteRegBytes(IIC_SCHED_DeviceTypedef *device, uint8_t reg, uint16_t len, const uint8_t *data);
+void IIC_SCHED_Poll(void);
+void IIC_SCHED_GetStatistics(IIC_SCHED_StatisticsTypedef *statistics);
+void IIC_SCHED_ResetStatistics(void);
+void IIC_SCHED_ResetDeviceStatistics(IIC_SCHED_DeviceTypedef *device);
+
+#endif
@@ -0,0 +1,440 @@
+/**
+ * @file    flashkv.c
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2019/09/02
+ * @brief
+ *          This file provides a key-value store in the internal flash:
+ *              1. Small blobs such as calibration data, kept across power cycles
+ *              2. Every record has a CRC and a version number
+ *              3. Append-only log in a dedicated sector for wear levelling
+ *              4. Host build backed by a file
+ * @note
+ *          Minimum version of header file:
+ *              0.1.0
+ *          Sector layout, little endian words:
+ *              magic | record | record | ... | 0xFFFFFFFF ...
+ *          Record:
+ *              key(16) length(16) | version(16) crc(16) | value, padded to words with 0xFF
+ *          The first word is programmed first and the CRC word last, so a torn
+ *          record can still be skipped by its length and fails its CRC.
+ *          CRC is CRC-16/CCITT over key, length, version and value.
+ *
+ *          The source code repository is available on GitHub:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#include "flashkv.h"
+#include "string.h"
+
+#ifndef FLASHKV_HOST
+#include "stm32f4xx.h"
+#else
+#include "stdio.h"
+const char* FLASHKV_HostFile = "flashkv.bin"; //!< File emulating the sector.
+static FILE* hostFile = NULL;
+static uint8_t hostImage[FLASHKV_SIZE];
+static uint8_t hostLoaded = 0;
+#endif
+
+#define FLASHKV_MAGIC           0x3156464B //!< "KFV1", changes with the layout.
+#define FLASHKV_HEADER_SIZE     8
+#define FLASHKV_ALIGN(n)        (((n) + 3) & ~3U)
+
+/** @addtogroup FLASHKV
+ * @{
+ */
+
+/**
+ * @brief Latest record of a key, kept in RAM during a compaction.
+ */
+typedef struct {
+  uint16_t key;
+  uint16_t version;
+  uint16_t length;
+  uint8_t value[FLASHKV_MAX_LENGTH];
+}FLASHKV_EntryTypeDef;
+
+static uint8_t initialized = 0;
+static uint32_t writeOffset; //!< First free byte of the sector, FLASHKV_SIZE if the log is damaged.
+static FLASHKV_EntryTypeDef entries[FLASHKV_MAX_KEYS]; //!< Compaction buffer.
+
+#ifndef FLASHKV_HOST
+
+static uint32_t FLASHKV_ReadWord(uint32_t offset)
+{
+  return *(__IO uint32_t*)(FLASHKV_ADDR + offset);
+}
+
+static void FLASHKV_Unlock(void)
+{
+  FLASH_Unlock();
+  FLASH_ClearFlag(FLASH_FLAG_EOP | FLASH_FLAG_OPERR | FLASH_FLAG_WRPERR |
+                  FLASH_FLAG_PGAERR | FLASH_FLAG_PGPERR | FLASH_FLAG_PGSERR);
+}
+
+/**
+ * @brief Lock the flash and drop the data cache, which may hold the old contents.
+ */
+static void FLASHKV_Lock(void)
+{
+  FLASH_Lock();
+  FLASH_DataCacheCmd(DISABLE);
+  FLASH_DataCacheReset();
+  FLASH_DataCacheCmd(ENABLE);
+}
+
+static uint8_t FLASHKV_Program(uint32_t offset, uint32_t data)
+{
+  return FLASH_ProgramWord(FLASHKV_ADDR + offset, data) != FLASH_COMPLETE;
+}
+
+static uint8_t FLASHKV_EraseSector(void)
+{
+  return FLASH_EraseSector(FLASHKV_SECTOR, VoltageRange_3) != FLASH_COMPLETE;
+}
+
+#else
+
+/**
+ * @brief Load the image file once, a missing or short file reads as erased.
+ */
+static void FLASHKV_HostLoad(void)
+{
+  FILE* file;
+  if (hostLoaded)
+    return;
+  memset(hostImage, 0xFF, FLASHKV_SIZE);
+  if ((file = fopen(FLASHKV_HostFile, "rb")) != NULL)
+  {
+    if (fread(hostImage, 1, FLASHKV_SIZE, file) == 0)
+      memset(hostImage, 0xFF, FLASHKV_SIZE);
+    fclose(file);
+  }
+  hostLoaded = 1;
+}
+
+static uint32_t FLASHKV_ReadWord(uint32_t offset)
+{
+  FLASHKV_HostLoad();
+  return hostImage[offset] | ((uint32_t)hostImage[offset + 1] << 8) |
+         ((uint32_t)hostImage[offset + 2] << 16) | ((uint32_t)hostImage[offset + 3] << 24);
+}
+
+static void FLASHKV_Unlock(void)
+{
+  FLASHKV_HostLoad();
+  hostFile = fopen(FLASHKV_HostFile, "r+b");
+  if (hostFile == NULL)
+    hostFile = fopen(FLASHKV_HostFile, "w+b");
+}
+
+static void FLASHKV_Lock(void)
+{
+  if (hostFile != NULL)
+    fclose(hostFile);
+  hostFile = NULL;
+}
+
+/**
+ * @brief Program a word the way NOR flash does, bits only go from 1 to 0.
+ */
+static uint8_t FLASHKV_Program(uint32_t offset, uint32_t data)
+{
+  uint8_t i;
+  if (hostFile == NULL)
+    return 1;
+  for (i = 0; i < 4; i++)
+    hostImage[offset + i] &= (uint8_t)(data >> (i * 8));
+  fseek(hostFile, (long)offset, SEEK_SET);
+  return fwrite(hostImage + offset, 1, 4, hostFile) != 4;
+}
+
+static uint8_t FLASHKV_EraseSector(void)
+{
+  if (hostFile == NULL)
+    return 1;
+  memset(hostImage, 0xFF, FLASHKV_SIZE);
+  fseek(hostFile, 0, SEEK_SET);
+  return fwrite(hostImage, 1, FLASHKV_SIZE, hostFile) != FLASHKV_SIZE;
+}
+
+#endif
+
+/**
+ * @brief CRC-16/CCITT, polynomial 0x1021.
+ */
+static uint16_t FLASHKV_Crc(uint16_t crc, const uint8_t* data, uint16_t length)
+{
+  uint8_t i;
+  while (length--)
+  {
+    crc ^= (uint16_t)*data++ << 8;
+    for (i = 0; i < 8; i++)
+      crc = crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1;
+  }
+  return crc;
+}
+
+static uint16_t FLASHKV_RecordCrc(uint16_t key, uint16_t version, const uint8_t* value, uint16_t length)
+{
+  uint8_t header[6];
+  header[0] = (uint8_t)key;
+  header[1] = (uint8_t)(key >> 8);
+  header[2] = (uint8_t)length;
+  header[3] = (uint8_t)(length >> 8);
+  header[4] = (uint8_t)version;
+  header[5] = (uint8_t)(version >> 8);
+  return FLASHKV_Crc(FLASHKV_Crc(0xFFFF, header, 6), value, length);
+}
+
+/**
+ * @brief Copy bytes from the sector.
+ */
+static void FLASHKV_ReadBytes(uint32_t offset, uint8_t* data, uint16_t length)
+{
+  uint32_t word = 0;
+  uint16_t i;
+  for (i = 0; i < length; i++)
+  {
+    if ((i & 3) == 0)
+      word = FLASHKV_ReadWord(offset + i);
+    data[i] = (uint8_t)(word >> ((i & 3) * 8));
+  }
+}
+
+/**
+ * @brief Decode the record at offset.
+ * @param offset Offset of the record.
+ * @param entry Key, version, length and value of the record if it is valid, value is not read if NULL.
+ * @param size Bytes taken by the record.
+ * @return 0-valid; 1-torn, skip it; 2-end of the log.
+ */
+static uint8_t FLASHKV_ReadRecord(uint32_t offset, FLASHKV_EntryTypeDef* entry, uint32_t* size)
+{
+  uint32_t header, check;
+  uint8_t value[FLASHKV_MAX_LENGTH];
+  if (offset + FLASHKV_HEADER_SIZE > FLASHKV_SIZE)
+    return 2;//Sector full
+  header = FLASHKV_ReadWord(offset);
+  if (header == 0xFFFFFFFF)
+    return 2;
+  entry->key = (uint16_t)header;
+  entry->length = (uint16_t)(header >> 16);
+  *size = FLASHKV_HEADER_SIZE + FLASHKV_ALIGN(entry->length);
+  if (entry->length > FLASHKV_MAX_LENGTH || offset + *size > FLASHKV_SIZE)
+    return 2;//Not written by this module, stop here
+  check = FLASHKV_ReadWord(offset + 4);
+  if (check == 0xFFFFFFFF)
+    return 1;//Power lost before the CRC word
+  entry->version = (uint16_t)check;
+  FLASHKV_ReadBytes(offset + FLASHKV_HEADER_SIZE, value, entry->length);
+  if (FLASHKV_RecordCrc(entry->key, entry->version, value, entry->length) != (uint16_t)(check >> 16))
+    return 1;
+  memcpy(entry->value, value, entry->length);
+  return 0;
+}
+
+/**
+ * @brief Find the latest valid record of a key.
+ * @param key Key.
+ * @param entry Latest record.
+ * @return 0-found; 1-not found.
+ */
+static uint8_t FLASHKV_Find(uint16_t key, FLASHKV_EntryTypeDef* entry)
+{
+  FLASHKV_EntryTypeDef record;
+  uint32_t offset = 4, size;
+  uint8_t result, found = 0;
+  while ((result = FLASHKV_ReadRecord(offset, &record, &size)) != 2)
+  {
+    if (result == 0 && record.key == key)
+    {
+      *entry = record;
+      found = 1;
+    }
+    offset += size;
+  }
+  return !found || entry->length == 0;//Length 0 marks a deleted key
+}
+
+/**
+ * @brief Append a record, the caller unlocks the flash.
+ * @return 0-success; 1-flash error.
+ */
+static uint8_t FLASHKV_Append(uint16_t key, uint16_t version, const uint8_t* value, uint16_t length)
+{
+  uint32_t offset = writeOffset, word;
+  uint16_t i;
+  writeOffset += FLASHKV_HEADER_SIZE + FLASHKV_ALIGN(length);
+  if (FLASHKV_Program(offset, key | ((uint32_t)length << 16)))
+    return 1;
+  for (i = 0; i < length; i += 4)
+  {
+    word = 0xFFFFFFFF;
+    memcpy(&word, value + i, length - i < 4 ? length - i : 4);//Little endian like the reader
+    if (FLASHKV_Program(offset + FLASHKV_HEADER_SIZE + i, word))
+      return 1;
+  }
+  return FLASHKV_Program(offset + 4, version | ((uint32_t)FLASHKV_RecordCrc(key, version, value, length) << 16));
+}
+
+/**
+ * @brief Erase the sector and keep the latest record of each key, replacing one of them.
+ * @return 0-success; 1-too many keys or flash error.
+ */
+static uint8_t FLASHKV_Compact(uint16_t key, uint16_t version, const uint8_t* value, uint16_t length)
+{
+  FLASHKV_EntryTypeDef record;
+  uint32_t offset = 4, size;
+  uint16_t count = 0, i;
+  uint8_t result;
+  while ((result = FLASHKV_ReadRecord(offset, &record, &size)) != 2)
+  {
+    if (result == 0 && record.key != key)
+    {
+      for (i = 0; i < count && entries[i].key != record.key; i++);
+      if (i == FLASHKV_MAX_KEYS)
+        return 1;
+      entries[i] = record;
+      if (i == count)
+        count++;
+    }
+    offset += size;
+  }
+  FLASHKV_Unlock();
+  result = FLASHKV_EraseSector() || FLASHKV_Program(0, FLASHKV_MAGIC);
+  writeOffset = 4;
+  for (i = 0; i < count && !result; i++)
+    if (entries[i].length > 0)
+      result = FLASHKV_Append(entries[i].key, entries[i].version, entries[i].value, entries[i].length);
+  if (!result && length > 0)
+    result = FLASHKV_Append(key, version, value, length);
+  FLASHKV_Lock();
+  return result;
+}
+
+/**
+ * @brief Scan the sector, formatting it if it does not hold a store.
+ * @return 0-success; 1-flash error.
+ * @note Called by the other functions when needed.
+ */
+uint8_t FLASHKV_Init()
+{
+  FLASHKV_EntryTypeDef record;
+  uint32_t size;
+#ifdef FLASHKV_HOST
+  hostLoaded = 0;//The file may have been replaced
+#endif
+  if (FLASHKV_ReadWord(0) != FLASHKV_MAGIC)
+    return FLASHKV_Format();
+  writeOffset = 4;
+  while (FLASHKV_ReadRecord(writeOffset, &record, &size) != 2)
+    writeOffset += size;
+  if (writeOffset + FLASHKV_HEADER_SIZE <= FLASHKV_SIZE && FLASHKV_ReadWord(writeOffset) != 0xFFFFFFFF)
+    writeOffset = FLASHKV_SIZE;//Damaged record, append nothing after it
+  initialized = 1;
+  return 0;
+}
+
+/**
+ * @brief Read a value.
+ * @param key Key, see FLASHKV_keys.
+ * @param version Layout version the caller expects.
+ * @param value Value.
+ * @param length Length of value in bytes.
+ * @return 0-success; 1-not stored, stored with another version or length, or flash error.
+ */
+uint8_t FLASHKV_Read(uint16_t key, uint16_t version, void* value, uint16_t length)
+{
+  FLASHKV_EntryTypeDef entry;
+  if (!initialized && FLASHKV_Init())
+    return 1;
+  if (FLASHKV_Find(key, &entry) || entry.version != version || entry.length != length)
+    return 1;
+  memcpy(value, entry.value, length);
+  return 0;
+}
+
+/**
+ * @brief Write a value.
+ * @param key Key, see FLASHKV_keys.
+ * @param version Layout version of value.
+ * @param value Value.
+ * @param length Length of value in bytes, 1~FLASHKV_MAX_LENGTH.
+ * @return 0-success; 1-bad argument, too many keys or flash error.
+ * @note Nothing is written if the stored value is the same.
+ */
+uint8_t FLASHKV_Write(uint16_t key, uint16_t version, const void* value, uint16_t length)
+{
+  FLASHKV_EntryTypeDef entry;
+  uint8_t result;
+  if (key == 0xFFFF || version == 0xFFFF || length == 0 || length > FLASHKV_MAX_LENGTH)
+    return 1;
+  if (!initialized && FLASHKV_Init())
+    return 1;
+  if (!FLASHKV_Find(key, &entry) && entry.version == version && entry.length == length &&
+      memcmp(entry.value, value, length) == 0)
+    return 0;
+  if (writeOffset + FLASHKV_HEADER_SIZE + FLASHKV_ALIGN(length) > FLASHKV_SIZE)
+    return FLASHKV_Compact(key, version, (const uint8_t*)value, length);
+  FLASHKV_Unlock();
+  result = FLASHKV_Append(key, version, (const uint8_t*)value, length);
+  FLASHKV_Lock();
+  return result;
+}
+
+/**
+ * @brief Delete a value, the next read of the key fails.
+ * @param key Key, see FLASHKV_keys.
+ * @return 0-success; 1-flash error.
+ */
+uint8_t FLASHKV_Delete(uint16_t key)
+{
+  FLASHKV_EntryTypeDef entry;
+  uint8_t result;
+  if (!initialized && FLASHKV_Init())
+    return 1;
+  if (FLASHKV_Find(key, &entry))
+    return 0;
+  if (writeOffset + FLASHKV_HEADER_SIZE > FLASHKV_SIZE)
+    return FLASHKV_Compact(key, 0, NULL, 0);
+  FLASHKV_Unlock();
+  result = FLASHKV_Append(key, 0, NULL, 0);
+  FLASHKV_Lock();
+  return result;
+}
+
+/**
+ * @brief Erase the sector, deleting all values.
+ * @return 0-success; 1-flash error.
+ */
+uint8_t FLASHKV_Format()
+{
+  uint8_t result;
+  FLASHKV_Unlock();
+  result = FLASHKV_EraseSector() || FLASHKV_Program(0, FLASHKV_MAGIC);
+  FLASHKV_Lock();
+  writeOffset = 4;
+  initialized = !result;
+  return result;
+}
+
+/**
+ * @brief Get the bytes left before the next compaction.
+ */
+uint32_t FLASHKV_GetFreeSpace()
+{
+  if (!initialized && FLASHKV_Init())
+    return 0;
+  return writeOffset < FLASHKV_SIZE ? FLASHKV_SIZE - writeOffset : 0;
+}
+
+/**
+ * @}
+ */
@@ -0,0 +1,99 @@
+/**
+ * @file    flashkv.h
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2019/09/02
+ * @brief
+ *          This file provides a key-value store in the internal flash:
+ *              1. Small blobs such as calibration data, kept across power cycles
+ *              2. Every record has a CRC and a version number
+ *              3. Append-only log in a dedicated sector for wear levelling
+ *              4. Host build backed by a file
+ * @note
+ *          Minimum version of source file:
+ *              0.1.0
+ *          Usage:
+ *              MY_CalibTypeDef calib;
+ *              if (FLASHKV_Read(FLASHKV_KEY_XXX, MY_CALIB_VERSION, &calib, sizeof(calib)))
+ *              {
+ *                  //Not stored, or stored by an older layout: calibrate and save
+ *                  MY_Calibrate(&calib);
+ *                  FLASHKV_Write(FLASHKV_KEY_XXX, MY_CALIB_VERSION, &calib, sizeof(calib));
+ *              }
+ *          Writing a value appends a new record, the last valid record of a key
+ *          wins. Writing the same value again does not touch the flash. When the
+ *          sector is full, the latest record of each key is kept in RAM, the
+ *          sector is erased and they are written back. Erasing a 128KB sector
+ *          takes 1~2 s, during which code in flash is stalled.
+ *          A record torn by a power loss fails its CRC and is ignored, the
+ *          previous value of the key is used instead. A power loss during the
+ *          compaction loses the stored values, drivers then calibrate again.
+ *
+ *          FLASHKV_SECTOR must not hold code. The linker region of mwlib.uvprojx
+ *          ends before it.
+ *          Define FLASHKV_HOST to build flashkv.c on PC, the sector is then
+ *          emulated by the file FLASHKV_HostFile, see tools/flashkv_tool.c.
+ *
+ *          The source code repository is available on GitHub:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#ifndef __FLASHKV_H
+#define __FLASHKV_H
+#include "stdint.h"
+
+/**
+ * @defgroup FLASHKV
+ * @brief Key-value store in the internal flash
+ * @{
+ */
+
+/**
+ * @defgroup FLASHKV_config
+ * @{
+ */
+
+#define FLASHKV_SECTOR                FLASH_Sector_7 //!< Last sector of STM32F407VE, reserved for the store.
+#define FLASHKV_ADDR                  0x08060000 //!< Start address of FLASHKV_SECTOR.
+#define FLASHKV_SIZE                  0x20000 //!< Size of FLASHKV_SECTOR in bytes.
+#define FLASHKV_MAX_KEYS              16 //!< Keys kept by a compaction.
+#define FLASHKV_MAX_LENGTH            64 //!< Maximum length of a value in bytes.
+
+/**
+ * @}
+ */
+
+/**
+ * @defgroup FLASHKV_keys
+ * @brief Keys of the drivers, never reuse a key for other data.
+ * @{
+ */
+
+#define FLASHKV_KEY_MPU6050_BIAS      0x0001 //!< Gyroscope and accelerometer bias of MPU6050 for the DMP.
+#define FLASHKV_KEY_MQ7_R0            0x0002 //!< Sensor resistance of MQ7 at the calibration concentration.
+
+/**
+ * @}
+ */
+
+#ifdef FLASHKV_HOST
+extern const char* FLASHKV_HostFile;
+#endif
+
+uint8_t FLASHKV_Init(void);
+uint8_t FLASHKV_Read(uint16_t key, uint16_t version, void* value, uint16_t length);
+uint8_t FLASHKV_Write(uint16_t key, uint16_t version, const void* value, uint16_t length);
+uint8_t FLASHKV_Delete(uint16_t key);
+uint8_t FLASHKV_Format(void);
+uint32_t FLASHKV_GetFreeSpace(void);
+
+/**
+ * @}
+ */
+
+#endif
@@ -1,7 +1,7 @@
 /**
  * @file    gp2y0e03.c
  * @author  Miaow
- * @version 0.1.1
+ * @version 0.4.0
  * @date    2018/10/19
  * @brief   
  *          This file provides functions to manage the following 
@@ -9,9 +9,11 @@
  *              1. Initialization
  *              2. Configurations
  *              3. distance Measurement
+ *              4. Read all sensors at once over lock-step buses
+ *              5. Skip configuration writes that do not change the sensor
  * @note
  *          Minimum version of header file:
- *              0.1.1
+ *              0.4.0
  *          Pin connection:
  *               
  *              PE12SCL     
@@ -29,637 +31,34 @@
  */
 
 #include "gp2y0e03.h"
+#include "utils.h"
+#include "bsp_iic_cache.h"
 
 uint8_t GP2Y0E03_maxOutputDistance[4] = {GP2Y0E03_Mod_64cm, GP2Y0E03_Mod_64cm, GP2Y0E03_Mod_64cm, GP2Y0E03_Mod_64cm};
-/**
- * @brief ׼΢뼶ʱ.
- */
-void GP2Y0E03_DelayUs(volatile uint32_t us)
-{
-    us <<= 4;
-    while(us--);
-}
-
-/**
- * @brief ʼGP2Y0E03_1IIC.
- */
-static inline void GP2Y0E03_1_IIC_Init()
-{
-    GPIO_InitTypeDef GPIO_InitStructure;
-    RCC_AHB1PeriphClockCmd(GP2Y0E03_1_SCL_GPIO_CLK | GP2Y0E03_1_SDA_GPIO_CLK, ENABLE);//ʹGPIOʱ
-    //SCL, SDAʼ
-    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_OUT;//ͨģʽ
-    GPIO_InitStructure.GPIO_OType = GPIO_OType_PP;//
-    GPIO_InitStructure.GPIO_Speed = GPIO_Fast_Speed;//50MHz
-    GPIO_InitStructure.GPIO_PuPd = GPIO_PuPd_UP;//
-    GPIO_InitStructure.GPIO_Pin = GP2Y0E03_1_SCL_PIN;
-    GPIO_Init(GP2Y0E03_1_SCL_PORT, &GPIO_InitStructure);//ʼ
-    GPIO_InitStructure.GPIO_Pin = GP2Y0E03_1_SDA_PIN;
-    GPIO_Init(GP2Y0E03_1_SDA_PORT, &GPIO_InitStructure);//ʼ
-    GP2Y0E03_1_SCL_PORT->BSRRL = GP2Y0E03_1_SCL_PIN;//GP2Y0E03_1_SCL=1
-    GP2Y0E03_1_SDA_PORT->BSRRL = GP2Y0E03_1_SDA_PIN;//GP2Y0E03_1_SDA=1
-}
-
-/**
- * @brief ʼGP2Y0E03_2IIC.
- */
-static inline void GP2Y0E03_2_IIC_Init()
-{
-    GPIO_InitTypeDef GPIO_InitStructure;
-    RCC_AHB1PeriphClockCmd(GP2Y0E03_2_SCL_GPIO_CLK | GP2Y0E03_2_SDA_GPIO_CLK, ENABLE);//ʹGPIOʱ
-    //SCL, SDAʼ
-    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_OUT;//ͨģʽ
-    GPIO_InitStructure.GPIO_OType = GPIO_OType_PP;//
-    GPIO_InitStructure.GPIO_Speed = GPIO_Fast_Speed;//50MHz
-    GPIO_InitStructure.GPIO_PuPd = GPIO_PuPd_UP;//
-    GPIO_InitStructure.GPIO_Pin = GP2Y0E03_2_SCL_PIN;
-    GPIO_Init(GP2Y0E03_2_SCL_PORT, &GPIO_InitStructure);//ʼ
-    GPIO_InitStructure.GPIO_Pin = GP2Y0E03_2_SDA_PIN;
-    GPIO_Init(GP2Y0E03_2_SDA_PORT, &GPIO_InitStructure);//ʼ
-    GP2Y0E03_2_SCL_PORT->BSRRL = GP2Y0E03_2_SCL_PIN;//GP2Y0E03_2_SCL=1
-    GP2Y0E03_2_SDA_PORT->BSRRL = GP2Y0E03_2_SDA_PIN;//GP2Y0E03_2_SDA=1
-}
-
-/**
- * @brief ʼGP2Y0E03_3IIC.
- */
-static inline void GP2Y0E03_3_IIC_Init()
-{
-    GPIO_InitTypeDef GPIO_InitStructure;
-    RCC_AHB1PeriphClockCmd(GP2Y0E03_3_SCL_GPIO_CLK | GP2Y0E03_3_SDA_GPIO_CLK, ENABLE);//ʹGPIOʱ
-    //SCL, SDAʼ
-    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_OUT;//ͨģʽ
-    GPIO_InitStructure.GPIO_OType = GPIO_OType_PP;//
-    GPIO_InitStructure.GPIO_Speed = GPIO_Fast_Speed;//50MHz
-    GPIO_InitStructure.GPIO_PuPd = GPIO_PuPd_UP;//
-    GPIO_InitStructure.GPIO_Pin = GP2Y0E03_3_SCL_PIN;
-    GPIO_Init(GP2Y0E03_3_SCL_PORT, &GPIO_InitStructure);//ʼ
-    GPIO_InitStructure.GPIO_Pin = GP2Y0E03_3_SDA_PIN;
-    GPIO_Init(GP2Y0E03_3_SDA_PORT, &GPIO_InitStructure);//ʼ
-    GP2Y0E03_3_SCL_PORT->BSRRL = GP2Y0E03_3_SCL_PIN;//GP2Y0E03_3_SCL=1
-    GP2Y0E03_3_SDA_PORT->BSRRL = GP2Y0E03_3_SDA_PIN;//GP2Y0E03_3_SDA=1
-}
-
-/**
- * @brief ʼGP2Y0E03_4IIC.
- */
-static inline void GP2Y0E03_4_IIC_Init()
-{
-    GPIO_InitTypeDef GPIO_InitStructure;
-    RCC_AHB1PeriphClockCmd(GP2Y0E03_4_SCL_GPIO_CLK | GP2Y0E03_4_SDA_GPIO_CLK, ENABLE);//ʹGPIOʱ
-    //SCL, SDAʼ
-    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_OUT;//ͨģʽ
-    GPIO_InitStructure.GPIO_OType = GPIO_OType_PP;//
-    GPIO_InitStructure.GPIO_Speed = GPIO_Fast_Speed;//50MHz
-    GPIO_InitStructure.GPIO_PuPd = GPIO_PuPd_UP;//
-    GPIO_InitStructure.GPIO_Pin = GP2Y0E03_4_SCL_PIN;
-    GPIO_Init(GP2Y0E03_4_SCL_PORT, &GPIO_InitStructure);//ʼ
-    GPIO_InitStructure.GPIO_Pin = GP2Y0E03_4_SDA_PIN;
-    GPIO_Init(GP2Y0E03_4_SDA_PORT, &GPIO_InitStructure);//ʼ
-    GP2Y0E03_4_SCL_PORT->BSRRL = GP2Y0E03_4_SCL_PIN;//GP2Y0E03_4_SCL=1
-    GP2Y0E03_4_SDA_PORT->BSRRL = GP2Y0E03_4_SDA_PIN;//GP2Y0E03_4_SDA=1
-}
-
-/**
- * @brief GP2Y0E03_1IICʼź.
- */
-static inline void GP2Y0E03_1_IIC_Start()
-{
-
-    GP2Y0E03_1_Out();//sda
-    GP2Y0E03_1_SDA_PORT->BSRRL = GP2Y0E03_1_SDA_PIN;//GP2Y0E03_1_SDA=1      
-    GP2Y0E03_1_SCL_PORT->BSRRL = GP2Y0E03_1_SCL_PIN;//GP2Y0E03_1_SCL=1
-    GP2Y0E03_DelayUs(2);
-    GP2Y0E03_1_SDA_PORT->BSRRH = GP2Y0E03_1_SDA_PIN;//GP2Y0E03_1_SDA=0 START:when CLK is high,DATA change form high to low 
-    GP2Y0E03_DelayUs(2);
-    GP2Y0E03_1_SCL_PORT->BSRRH = GP2Y0E03_1_SCL_PIN;//ǯסI2Cߣ׼ͻ 
-    GP2Y0E03_DelayUs(2);
-}
-
-/**
- * @brief GP2Y0E03_2IICʼź.
- */
-static inline void GP2Y0E03_2_IIC_Start()
-{
-    GP2Y0E03_2_Out();//sda
-    GP2Y0E03_2_SDA_PORT->BSRRL = GP2Y0E03_2_SDA_PIN;//GP2Y0E03_2_SDA=1      
-    GP2Y0E03_2_SCL_PORT->BSRRL = GP2Y0E03_2_SCL_PIN;//GP2Y0E03_2_SCL=1
-    GP2Y0E03_DelayUs(2);
-    GP2Y0E03_2_SDA_PORT->BSRRH = GP2Y0E03_2_SDA_PIN;//GP2Y0E03_2_SDA=0 START:when CLK is high,DATA change form high to low 
-    GP2Y0E03_DelayUs(2);
-    GP2Y0E03_2_SCL_PORT->BSRRH = GP2Y0E03_2_SCL_PIN;//ǯסI2Cߣ׼ͻ 
-    GP2Y0E03_DelayUs(2);
-}
-
-/**
- * @brief GP2Y0E03_3IICʼź.
- */
-static inline void GP2Y0E03_3_IIC_Start()
-{
-    GP2Y0E03_3_Out();//sda
-    GP2Y0E03_3_SDA_PORT->BSRRL = GP2Y0E03_3_SDA_PIN;//GP2Y0E03_3_SDA=1      
-    GP2Y0E03_3_SCL_PORT->BSRRL = GP2Y0E03_3_SCL_PIN;//GP2Y0E03_3_SCL=1
-    GP2Y0E03_DelayUs(2);
-    GP2Y0E03_3_SDA_PORT->BSRRH = GP2Y0E03_3_SDA_PIN;//GP2Y0E03_3_SDA=0 START:when CLK is high,DATA change form high to low 
-    GP2Y0E03_DelayUs(2);
-    GP2Y0E03_3_SCL_PORT->BSRRH = GP2Y0E03_3_SCL_PIN;//ǯסI2Cߣ׼ͻ 
-    GP2Y0E03_DelayUs(2);
-}
-
-/**
- * @brief GP2Y0E03_4IICʼź.
- */
-static inline void GP2Y0E03_4_IIC_Start()
-{
-    GP2Y0E03_4_Out();//sda
-    GP2Y0E03_4_SDA_PORT->BSRRL = GP2Y0E03_4_SDA_PIN;//GP2Y0E03_4_SDA=1      
-    GP2Y0E03_4_SCL_PORT->BSRRL = GP2Y0E03_4_SCL_PIN;//GP2Y0E03_4_SCL=1
-    GP2Y0E03_DelayUs(2);
-    GP2Y0E03_4_SDA_PORT->BSRRH = GP2Y0E03_4_SDA_PIN;//GP2Y0E03_4_SDA=0 START:when CLK is high,DATA change form high to low 
-    GP2Y0E03_DelayUs(2);
-    GP2Y0E03_4_SCL_PORT->BSRRH = GP2Y0E03_4_SCL_PIN;//ǯסI2Cߣ׼ͻ 
-    GP2Y0E03_DelayUs(2);
-}
-
-/**
- * @brief GP2Y0E03_1IICֹͣź.
- */
-static inline void GP2Y0E03_1_IIC_Stop()
-{
-    GP2Y0E03_1_Out();//sda
-    GP2Y0E03_1_SCL_PORT->BSRRH = GP2Y0E03_1_SCL_PIN;//GP2Y0E03_1_SCL=0
-    GP2Y0E03_1_SDA_PORT->BSRRH = GP2Y0E03_1_SDA_PIN;//GP2Y0E03_1_SDA=0 STOP:when CLK is high DATA change form low to high
-    GP2Y0E03_DelayUs(2);
-    GP2Y0E03_1_SCL_PORT->BSRRL = GP2Y0E03_1_SCL_PIN;//GP2Y0E03_1_SCL=1
-    GP2Y0E03_DelayUs(2);
-    GP2Y0E03_1_SDA_PORT->BSRRL = GP2Y0E03_1_SDA_PIN;//GP2Y0E03_1_SDA=1 I2C߽ź
-    GP2Y0E03_DelayUs(2);
-}
-
-/**
- * @brief GP2Y0E03_2IICֹͣź.
- */
-static inline void GP2Y0E03_2_IIC_Stop()
-{
-    GP2Y0E03_2_Out();//sda
-    GP2Y0E03_2_SCL_PORT->BSRRH = GP2Y0E03_2_SCL_PIN;//GP2Y0E03_2_SCL=0
-    GP2Y0E03_2_SDA_PORT->BSRRH = GP2Y0E03_2_SDA_PIN;//GP2Y0E03_2_SDA=0 STOP:when CLK is high DATA change form low to high
-    GP2Y0E03_DelayUs(2);
-    GP2Y0E03_2_SCL_PORT->BSRRL = GP2Y0E03_2_SCL_PIN;//GP2Y0E03_2_SCL=1
-    GP2Y0E03_DelayUs(2);
-    GP2Y0E03_2_SDA_PORT->BSRRL = GP2Y0E03_2_SDA_PIN;//GP2Y0E03_2_SDA=1 I2C߽ź
-    GP2Y0E03_DelayUs(2);
-}
-
-/**
- * @brief GP2Y0E03_3IICֹͣź.
- */
-static inline void GP2Y0E03_3_IIC_Stop()
-{
-    GP2Y0E03_3_Out();//sda
-    GP2Y0E03_3_SCL_PORT->BSRRH = GP2Y0E03_3_SCL_PIN;//GP2Y0E03_3_SCL=0
-    GP2Y0E03_3_SDA_PORT->BSRRH = GP2Y0E03_3_SDA_PIN;//GP2Y0E03_3_SDA=0 STOP:when CLK is high DATA change form low to high
-    GP2Y0E03_DelayUs(2);
-    GP2Y0E03_3_SCL_PORT->BSRRL = GP2Y0E03_3_SCL_PIN;//GP2Y0E03_3_SCL=1
-    GP2Y0E03_DelayUs(2);
-    GP2Y0E03_3_SDA_PORT->BSRRL = GP2Y0E03_3_SDA_PIN;//GP2Y0E03_3_SDA=1 I2C߽ź
-    GP2Y0E03_DelayUs(2);
-}
-
-/**
- * @brief GP2Y0E03_4IICֹͣź.
- */
-static inline void GP2Y0E03_4_IIC_Stop()
-{
-    GP2Y0E03_4_Out();//sda
-    GP2Y0E03_4_SCL_PORT->BSRRH = GP2Y0E03_4_SCL_PIN;//GP2Y0E03_4_SCL=0
-    GP2Y0E03_4_SDA_PORT->BSRRH = GP2Y0E03_4_SDA_PIN;//GP2Y0E03_4_SDA=0 STOP:when CLK is high DATA change form low to high
-    GP2Y0E03_DelayUs(2);
-    GP2Y0E03_4_SCL_PORT->BSRRL = GP2Y0E03_4_SCL_PIN;//GP2Y0E03_4_SCL=1
-    GP2Y0E03_DelayUs(2);
-    GP2Y0E03_4_SDA_PORT->BSRRL = GP2Y0E03_4_SDA_PIN;//GP2Y0E03_4_SDA=1 I2C߽ź
-    GP2Y0E03_DelayUs(2);
-}
-
-/**
- * @brief ȴGP2Y0E03_1_IIC_WaitAckIICӦź.
- * @return 1-Ӧʧ; 0-Ӧɹ.
- */
-static inline uint8_t GP2Y0E03_1_IIC_WaitAck()
-{
-    uint8_t ucErrTime = 0;
-    GP2Y0E03_1_In();//SDAΪ  
-    GP2Y0E03_1_SDA_PORT->BSRRL = GP2Y0E03_1_SDA_PIN;//GP2Y0E03_1_SDA=1
-    GP2Y0E03_DelayUs(1);       
-    GP2Y0E03_1_SCL_PORT->BSRRL = GP2Y0E03_1_SCL_PIN;//GP2Y0E03_1_SCL=1
-    GP2Y0E03_DelayUs(1);     
-    while(GP2Y0E03_1_SDA_PORT->IDR & GP2Y0E03_1_SDA_PIN)
-    {
-        ucErrTime++;
-        if(ucErrTime > 250)
-        {
-            GP2Y0E03_1_IIC_Stop();
-            return 1;
-        }
-    }
-    GP2Y0E03_1_SCL_PORT->BSRRH = GP2Y0E03_1_SCL_PIN;//GP2Y0E03_1_SCL=0 ʱ0        
-    return 0;  
-} 
-
-/**
- * @brief ȴGP2Y0E03_2_IIC_WaitAckIICӦź.
- * @return 1-Ӧʧ; 0-Ӧɹ.
- */
-static inline uint8_t GP2Y0E03_2_IIC_WaitAck()
-{
-    uint8_t ucErrTime = 0;
-    GP2Y0E03_2_In();//SDAΪ  
-    GP2Y0E03_2_SDA_PORT->BSRRL = GP2Y0E03_2_SDA_PIN;//GP2Y0E03_2_SDA=1
-    GP2Y0E03_DelayUs(1);       
-    GP2Y0E03_2_SCL_PORT->BSRRL = GP2Y0E03_2_SCL_PIN;//GP2Y0E03_2_SCL=1
-    GP2Y0E03_DelayUs(1);     
-    while(GP2Y0E03_2_SDA_PORT->IDR & GP2Y0E03_2_SDA_PIN)
-    {
-        ucErrTime++;
-        if(ucErrTime > 250)
-        {
-            GP2Y0E03_2_IIC_Stop();
-            return 1;
-        }
-    }
-    GP2Y0E03_2_SCL_PORT->BSRRH = GP2Y0E03_2_SCL_PIN;//GP2Y0E03_2_SCL=0 ʱ0        
-    return 0;  
-}
-
-/**
- * @brief ȴGP2Y0E03_3_IIC_WaitAckIICӦź.
- * @return 1-Ӧʧ; 0-Ӧɹ.
- */
-static inline uint8_t GP2Y0E03_3_IIC_WaitAck()
-{
-    uint8_t ucErrTime = 0;
-    GP2Y0E03_3_In();//SDAΪ  
-    GP2Y0E03_3_SDA_PORT->BSRRL = GP2Y0E03_3_SDA_PIN;//GP2Y0E03_3_SDA=1
-    GP2Y0E03_DelayUs(1);       
-    GP2Y0E03_3_SCL_PORT->BSRRL = GP2Y0E03_3_SCL_PIN;//GP2Y0E03_3_SCL=1
-    GP2Y0E03_DelayUs(1);     
-    while(GP2Y0E03_3_SDA_PORT->IDR & GP2Y0E03_3_SDA_PIN)
-    {
-        ucErrTime++;
-        if(ucErrTime > 250)
-        {
-            GP2Y0E03_3_IIC_Stop();
-            return 1;
-        }
-    }
-    GP2Y0E03_3_SCL_PORT->BSRRH = GP2Y0E03_3_SCL_PIN;//GP2Y0E03_3_SCL=0 ʱ0        
-    return 0;  
-}
-
-/**
- * @brief ȴGP2Y0E03_4_IIC_WaitAckIICӦź.
- * @return 1-Ӧʧ; 0-Ӧɹ.
- */
-static inline uint8_t GP2Y0E03_4_IIC_WaitAck()
-{
-    uint8_t ucErrTime = 0;
-    GP2Y0E03_4_In();//SDAΪ  
-    GP2Y0E03_4_SDA_PORT->BSRRL = GP2Y0E03_4_SDA_PIN;//GP2Y0E03_4_SDA=1
-    GP2Y0E03_DelayUs(1);       
-    GP2Y0E03_4_SCL_PORT->BSRRL = GP2Y0E03_4_SCL_PIN;//GP2Y0E03_4_SCL=1
-    GP2Y0E03_DelayUs(1);     
-    while(GP2Y0E03_4_SDA_PORT->IDR & GP2Y0E03_4_SDA_PIN)
-    {
-        ucErrTime++;
-        if(ucErrTime > 250)
-        {
-            GP2Y0E03_4_IIC_Stop();
-            return 1;
-        }
-    }
-    GP2Y0E03_4_SCL_PORT->BSRRH = GP2Y0E03_4_SCL_PIN;//GP2Y0E03_4_SCL=0 ʱ0        
-    return 0;  
-}
-
-/**
- * @brief GP2Y0E03_1IICӦź.
- */
-static inline void GP2Y0E03_1_IIC_Ack()
-{
-    GP2Y0E03_1_SCL_PORT->BSRRH = GP2Y0E03_1_SCL_PIN;//GP2Y0E03_1_SCL=0
-    GP2Y0E03_1_Out();
-    GP2Y0E03_1_SDA_PORT->BSRRH = GP2Y0E03_1_SDA_PIN;//GP2Y0E03_1_SDA=0
-    GP2Y0E03_DelayUs(2);
-    GP2Y0E03_1_SCL_PORT->BSRRL = GP2Y0E03_1_SCL_PIN;//GP2Y0E03_1_SCL=1
-    GP2Y0E03_DelayUs(2);
-    GP2Y0E03_1_SCL_PORT->BSRRH = GP2Y0E03_1_SCL_PIN;//GP2Y0E03_1_SCL=0
-    GP2Y0E03_DelayUs(2);
-}
-
-/**
- * @brief GP2Y0E03_2IICӦź.
- */
-static inline void GP2Y0E03_2_IIC_Ack()
-{
-    GP2Y0E03_2_SCL_PORT->BSRRH = GP2Y0E03_2_SCL_PIN;//GP2Y0E03_2_SCL=0
-    GP2Y0E03_2_Out();
-    GP2Y0E03_2_SDA_PORT->BSRRH = GP2Y0E03_2_SDA_PIN;//GP2Y0E03_2_SDA=0
-    GP2Y0E03_DelayUs(2);
-    GP2Y0E03_2_SCL_PORT->BSRRL = GP2Y0E03_2_SCL_PIN;//GP2Y0E03_2_SCL=1
-    GP2Y0E03_DelayUs(2);
-    GP2Y0E03_2_SCL_PORT->BSRRH = GP2Y0E03_2_SCL_PIN;//GP2Y0E03_2_SCL=0
-    GP2Y0E03_DelayUs(2);
-}
-
-/**
- * @brief GP2Y0E03_3IICӦź.
- */
-static inline void GP2Y0E03_3_IIC_Ack()
-{
-    GP2Y0E03_3_SCL_PORT->BSRRH = GP2Y0E03_3_SCL_PIN;//GP2Y0E03_3_SCL=0
-    GP2Y0E03_3_Out();
-    GP2Y0E03_3_SDA_PORT->BSRRH = GP2Y0E03_3_SDA_PIN;//GP2Y0E03_3_SDA=0
-    GP2Y0E03_DelayUs(2);
-    GP2Y0E03_3_SCL_PORT->BSRRL = GP2Y0E03_3_SCL_PIN;//GP2Y0E03_3_SCL=1
-    GP2Y0E03_DelayUs(2);
-    GP2Y0E03_3_SCL_PORT->BSRRH = GP2Y0E03_3_SCL_PIN;//GP2Y0E03_3_SCL=0
-    GP2Y0E03_DelayUs(2);
-}
-
-/**
- * @brief GP2Y0E03_4IICӦź.
- */
-static inline void GP2Y0E03_4_IIC_Ack()
-{
-    GP2Y0E03_4_SCL_PORT->BSRRH = GP2Y0E03_4_SCL_PIN;//GP2Y0E03_4_SCL=0
-    GP2Y0E03_4_Out();
-    GP2Y0E03_4_SDA_PORT->BSRRH = GP2Y0E03_4_SDA_PIN;//GP2Y0E03_4_SDA=0
-    GP2Y0E03_DelayUs(2);
-    GP2Y0E03_4_SCL_PORT->BSRRL = GP2Y0E03_4_SCL_PIN;//GP2Y0E03_4_SCL=1
-    GP2Y0E03_DelayUs(2);
-    GP2Y0E03_4_SCL_PORT->BSRRH = GP2Y0E03_4_SCL_PIN;//GP2Y0E03_4_SCL=0
-    GP2Y0E03_DelayUs(2);
-}
-
-/**
- * @brief GP2Y0E03_1IICӦź.
- */
-static inline void GP2Y0E03_1_IIC_NAck()
-{
-    GP2Y0E03_1_SCL_PORT->BSRRH = GP2Y0E03_1_SCL_PIN;//GP2Y0E03_1_SCL=0
-    GP2Y0E03_1_Out();
-    GP2Y0E03_1_SDA_PORT->BSRRL = GP2Y0E03_1_SDA_PIN;//GP2Y0E03_1_SDA=1
-    GP2Y0E03_DelayUs(2);
-    GP2Y0E03_1_SCL_PORT->BSRRL = GP2Y0E03_1_SCL_PIN;//GP2Y0E03_1_SCL=1
-    GP2Y0E03_DelayUs(2);
-    GP2Y0E03_1_SCL_PORT->BSRRH = GP2Y0E03_1_SCL_PIN;//GP2Y0E03_1_SCL=0
-    GP2Y0E03_DelayUs(2);
-}
-
-/**
- * @brief GP2Y0E03_2IICӦź.
- */
-static inline void GP2Y0E03_2_IIC_NAck()
-{
-    GP2Y0E03_2_SCL_PORT->BSRRH = GP2Y0E03_2_SCL_PIN;//GP2Y0E03_2_SCL=0
-    GP2Y0E03_2_Out();
-    GP2Y0E03_2_SDA_PORT->BSRRL = GP2Y0E03_2_SDA_PIN;//GP2Y0E03_2_SDA=1
-    GP2Y0E03_DelayUs(2);
-    GP2Y0E03_2_SCL_PORT->BSRRL = GP2Y0E03_2_SCL_PIN;//GP2Y0E03_2_SCL=1
-    GP2Y0E03_DelayUs(2);
-    GP2Y0E03_2_SCL_PORT->BSRRH = GP2Y0E03_2_SCL_PIN;//GP2Y0E03_2_SCL=0
-    GP2Y0E03_DelayUs(2);
-}
-
-/**
- * @brief GP2Y0E03_3IICӦź.
- */
-static inline void GP2Y0E03_3_IIC_NAck()
-{
-    GP2Y0E03_3_SCL_PORT->BSRRH = GP2Y0E03_3_SCL_PIN;//GP2Y0E03_3_SCL=0
-    GP2Y0E03_3_Out();
-    GP2Y0E03_3_SDA_PORT->BSRRL = GP2Y0E03_3_SDA_PIN;//GP2Y0E03_3_SDA=1
-    GP2Y0E03_DelayUs(2);
-    GP2Y0E03_3_SCL_PORT->BSRRL = GP2Y0E03_3_SCL_PIN;//GP2Y0E03_3_SCL=1
-    GP2Y0E03_DelayUs(2);
-    GP2Y0E03_3_SCL_PORT->BSRRH = GP2Y0E03_3_SCL_PIN;//GP2Y0E03_3_SCL=0
-    GP2Y0E03_DelayUs(2);
-}
-
-/**
- * @brief GP2Y0E03_4IICӦź.
- */
-static inline void GP2Y0E03_4_IIC_NAck()
-{
-    GP2Y0E03_4_SCL_PORT->BSRRH = GP2Y0E03_4_SCL_PIN;//GP2Y0E03_4_SCL=0
-    GP2Y0E03_4_Out();
-    GP2Y0E03_4_SDA_PORT->BSRRL = GP2Y0E03_4_SDA_PIN;//GP2Y0E03_4_SDA=1
-    GP2Y0E03_DelayUs(2);
-    GP2Y0E03_4_SCL_PORT->BSRRL = GP2Y0E03_4_SCL_PIN;//GP2Y0E03_4_SCL=1
-    GP2Y0E03_DelayUs(2);
-    GP2Y0E03_4_SCL_PORT->BSRRH = GP2Y0E03_4_SCL_PIN;//GP2Y0E03_4_SCL=0
-    GP2Y0E03_DelayUs(2);
-}
-
-/**
- * @brief GP2Y0E03_1IICһֽ.
- * @param data Ҫ͵ֽ.
- */
-static inline void GP2Y0E03_1_IIC_WriteByte(uint8_t data)
-{                        
-    uint8_t i;
-    GP2Y0E03_1_Out();
-    GP2Y0E03_1_SCL_PORT->BSRRH = GP2Y0E03_1_SCL_PIN;//GP2Y0E03_1_SCL=0 ʱӿʼݴ
-    for(i = 0; i < 8; i++)
-    {
-        if((data & 0x80) >> 7)
-            GP2Y0E03_1_SDA_PORT->BSRRL = GP2Y0E03_1_SDA_PIN;//GP2Y0E03_1_SDA=1
-        else
-            GP2Y0E03_1_SDA_PORT->BSRRH = GP2Y0E03_1_SDA_PIN;//GP2Y0E03_1_SDA=0
-        data <<= 1;
-        GP2Y0E03_DelayUs(1);
-        GP2Y0E03_1_SCL_PORT->BSRRL = GP2Y0E03_1_SCL_PIN;//GP2Y0E03_1_SCL=1
-        GP2Y0E03_DelayUs(1);
-        GP2Y0E03_1_SCL_PORT->BSRRH = GP2Y0E03_1_SCL_PIN;//GP2Y0E03_1_SCL=0
-        GP2Y0E03_DelayUs(1);
-    }
-}
-
-/**
- * @brief GP2Y0E03_2IICһֽ.
- * @param data Ҫ͵ֽ.
- */
-static inline void GP2Y0E03_2_IIC_WriteByte(uint8_t data)
-{                        
-    uint8_t i;
-    GP2Y0E03_2_Out();
-    GP2Y0E03_2_SCL_PORT->BSRRH = GP2Y0E03_2_SCL_PIN;//GP2Y0E03_2_SCL=0 ʱӿʼݴ
-    for(i = 0; i < 8; i++)
-    {
-        if((data & 0x80) >> 7)
-            GP2Y0E03_2_SDA_PORT->BSRRL = GP2Y0E03_2_SDA_PIN;//GP2Y0E03_2_SDA=1
-        else
-            GP2Y0E03_2_SDA_PORT->BSRRH = GP2Y0E03_2_SDA_PIN;//GP2Y0E03_2_SDA=0
-        data <<= 1;
-        GP2Y0E03_DelayUs(1);
-        GP2Y0E03_2_SCL_PORT->BSRRL = GP2Y0E03_2_SCL_PIN;//GP2Y0E03_2_SCL=1
-        GP2Y0E03_DelayUs(1);
-        GP2Y0E03_2_SCL_PORT->BSRRH = GP2Y0E03_2_SCL_PIN;//GP2Y0E03_2_SCL=0
-        GP2Y0E03_DelayUs(1);
-    }
-}
-
-/**
- * @brief GP2Y0E03_3IICһֽ.
- * @param data Ҫ͵ֽ.
- */
-static inline void GP2Y0E03_3_IIC_WriteByte(uint8_t data)
-{                        
-    uint8_t i;
-    GP2Y0E03_3_Out();
-    GP2Y0E03_3_SCL_PORT->BSRRH = GP2Y0E03_3_SCL_PIN;//GP2Y0E03_3_SCL=0 ʱӿʼݴ
-    for(i = 0; i < 8; i++)
-    {
-        if((data & 0x80) >> 7)
-            GP2Y0E03_3_SDA_PORT->BSRRL = GP2Y0E03_3_SDA_PIN;//GP2Y0E03_3_SDA=1
-        else
-            GP2Y0E03_3_SDA_PORT->BSRRH = GP2Y0E03_3_SDA_PIN;//GP2Y0E03_3_SDA=0
-        data <<= 1;
-        GP2Y0E03_DelayUs(1);
-        GP2Y0E03_3_SCL_PORT->BSRRL = GP2Y0E03_3_SCL_PIN;//GP2Y0E03_3_SCL=1
-        GP2Y0E03_DelayUs(1);
-        GP2Y0E03_3_SCL_PORT->BSRRH = GP2Y0E03_3_SCL_PIN;//GP2Y0E03_3_SCL=0
-        GP2Y0E03_DelayUs(1);
-    }
-}
-
-/**
- * @brief GP2Y0E03_4IICһֽ.
- * @param data Ҫ͵ֽ.
- */
-static inline void GP2Y0E03_4_IIC_WriteByte(uint8_t data)
-{                        
-    uint8_t i;
-    GP2Y0E03_4_Out();
-    GP2Y0E03_4_SCL_PORT->BSRRH = GP2Y0E03_4_SCL_PIN;//GP2Y0E03_4_SCL=0 ʱӿʼݴ
-    for(i = 0; i < 8; i++)
-    {
-        if((data & 0x80) >> 7)
-            GP2Y0E03_4_SDA_PORT->BSRRL = GP2Y0E03_4_SDA_PIN;//GP2Y0E03_4_SDA=1
-        else
-            GP2Y0E03_4_SDA_PORT->BSRRH = GP2Y0E03_4_SDA_PIN;//GP2Y0E03_4_SDA=0
-        data <<= 1;
-        GP2Y0E03_DelayUs(1);
-        GP2Y0E03_4_SCL_PORT->BSRRL = GP2Y0E03_4_SCL_PIN;//GP2Y0E03_4_SCL=1
-        GP2Y0E03_DelayUs(1);
-        GP2Y0E03_4_SCL_PORT->BSRRH = GP2Y0E03_4_SCL_PIN;//GP2Y0E03_4_SCL=0
-        GP2Y0E03_DelayUs(1);
-    }
-}
-/**
- * @brief GP2Y0E03_1IIC1ֽ.
- * @param ack 1-Ӧ; 0-ͷӦ.
- * @return ضȡһֽ.
- */
-static inline uint8_t GP2Y0E03_1_IIC_ReadByte(uint8_t ack)
-{
-    uint8_t i, receive = 0;
-    GP2Y0E03_1_In();//SDAΪ
-    for(i = 0; i < 8; i++)
-    {
-        GP2Y0E03_1_SCL_PORT->BSRRH = GP2Y0E03_1_SCL_PIN;//GP2Y0E03_1_SCL=0 
-        GP2Y0E03_DelayUs(2);
-        GP2Y0E03_1_SCL_PORT->BSRRL = GP2Y0E03_1_SCL_PIN;//GP2Y0E03_1_SCL=1
-        receive <<= 1;
-        if(GP2Y0E03_1_SDA_PORT->IDR & GP2Y0E03_1_SDA_PIN)
-            receive++;
-        GP2Y0E03_DelayUs(2);
-    } 
-    if (!ack)
-        GP2Y0E03_1_IIC_NAck();//nACK
-    else
-        GP2Y0E03_1_IIC_Ack(); //ACK   
-    return receive;
-}
-
-/**
- * @brief GP2Y0E03_2IIC1ֽ.
- * @param ack 1-Ӧ; 0-ͷӦ.
- * @return ضȡһֽ.
- */
-static inline uint8_t GP2Y0E03_2_IIC_ReadByte(uint8_t ack)
-{
-    uint8_t i, receive = 0;
-    GP2Y0E03_2_In();//SDAΪ
-    for(i = 0; i < 8; i++)
-    {
-        GP2Y0E03_2_SCL_PORT->BSRRH = GP2Y0E03_2_SCL_PIN;//GP2Y0E03_2_SCL=0 
-        GP2Y0E03_DelayUs(2);
-        GP2Y0E03_2_SCL_PORT->BSRRL = GP2Y0E03_2_SCL_PIN;//GP2Y0E03_2_SCL=1
-        receive <<= 1;
-        if(GP2Y0E03_2_SDA_PORT->IDR & GP2Y0E03_2_SDA_PIN)
-            receive++;
-        GP2Y0E03_DelayUs(2);
-    } 
-    if (!ack)
-        GP2Y0E03_2_IIC_NAck();//nACK
-    else
-        GP2Y0E03_2_IIC_Ack(); //ACK   
-    return receive;
-}
-
-/**
- * @brief GP2Y0E03_3IIC1ֽ.
- * @param ack 1-Ӧ; 0-ͷӦ.
- * @return ضȡһֽ.
- */
-static inline uint8_t GP2Y0E03_3_IIC_ReadByte(uint8_t ack)
-{
-    uint8_t i, receive = 0;
-    GP2Y0E03_3_In();//SDAΪ
-    for(i = 0; i < 8; i++)
-    {
-        GP2Y0E03_3_SCL_PORT->BSRRH = GP2Y0E03_3_SCL_PIN;//GP2Y0E03_3_SCL=0 
-        GP2Y0E03_DelayUs(2);
-        GP2Y0E03_3_SCL_PORT->BSRRL = GP2Y0E03_3_SCL_PIN;//GP2Y0E03_3_SCL=1
-        receive <<= 1;
-        if(GP2Y0E03_3_SDA_PORT->IDR & GP2Y0E03_3_SDA_PIN)
-            receive++;
-        GP2Y0E03_DelayUs(2);
-    } 
-    if (!ack)
-        GP2Y0E03_3_IIC_NAck();//nACK
-    else
-        GP2Y0E03_3_IIC_Ack(); //ACK   
-    return receive;
-}
-
-/**
- * @brief GP2Y0E03_4IIC1ֽ.
- * @param ack 1-Ӧ; 0-ͷӦ.
- * @return ضȡһֽ.
+static IIC_BusTypedef gp2y0e03Bus[4] = {
+    IIC_BUS(GP2Y0E03_1_SCL_PORT, GP2Y0E03_1_SCL_PIN, GP2Y0E03_1_SDA_PORT, GP2Y0E03_1_SDA_PIN, GP2Y0E03_IIC_SPEED),
+    IIC_BUS(GP2Y0E03_2_SCL_PORT, GP2Y0E03_2_SCL_PIN, GP2Y0E03_2_SDA_PORT, GP2Y0E03_2_SDA_PIN, GP2Y0E03_IIC_SPEED),
+    IIC_BUS(GP2Y0E03_3_SCL_PORT, GP2Y0E03_3_SCL_PIN, GP2Y0E03_3_SDA_PORT, GP2Y0E03_3_SDA_PIN, GP2Y0E03_IIC_SPEED),
+    IIC_BUS(GP2Y0E03_4_SCL_PORT, GP2Y0E03_4_SCL_PIN, GP2Y0E03_4_SDA_PORT, GP2Y0E03_4_SDA_PIN, GP2Y0E03_IIC_SPEED)
+};
+static uint8_t initializedSensors = 0;//ѳʼĴ, @ref GP2Y0E03_select 
+static const uint8_t gp2y0e03Address[4] = {GP2Y0E03_1_IIC_ADDRESS, GP2Y0E03_2_IIC_ADDRESS, GP2Y0E03_3_IIC_ADDRESS, GP2Y0E03_4_IIC_ADDRESS};
+static uint8_t gp2y0e03Thresholds[4][0x2D];//0x13~0x3Fֵ˲ĴĻ
+static uint8_t gp2y0e03Judgements[4][0x18];//0xA8~0xBFۼӴжؼĴĻ
+#define GP2Y0E03_CACHE(i, address)  {IIC_CACHE_DEVICE(&gp2y0e03Bus[i], address, 0, 0x13, 0x2D, gp2y0e03Thresholds[i]), \
+                                     IIC_CACHE_DEVICE(&gp2y0e03Bus[i], address, 0, 0xA8, 0x18, gp2y0e03Judgements[i])}
+static IIC_CACHE_DeviceTypedef gp2y0e03Cache[4][2] = {
+    GP2Y0E03_CACHE(0, GP2Y0E03_1_IIC_ADDRESS),
+    GP2Y0E03_CACHE(1, GP2Y0E03_2_IIC_ADDRESS),
+    GP2Y0E03_CACHE(2, GP2Y0E03_3_IIC_ADDRESS),
+    GP2Y0E03_CACHE(3, GP2Y0E03_4_IIC_ADDRESS)
+};
+
+/**
+ * @brief е.
+ * @param sensorX ָĴ, GP2Y0E03_ALL @ref GP2Y0E03_select ѡһ.
  */
-static inline uint8_t GP2Y0E03_4_IIC_ReadByte(uint8_t ack)
-{
-    uint8_t i, receive = 0;
-    GP2Y0E03_4_In();//SDAΪ
-    for(i = 0; i < 8; i++)
-    {
-        GP2Y0E03_4_SCL_PORT->BSRRH = GP2Y0E03_4_SCL_PIN;//GP2Y0E03_4_SCL=0 
-        GP2Y0E03_DelayUs(2);
-        GP2Y0E03_4_SCL_PORT->BSRRL = GP2Y0E03_4_SCL_PIN;//GP2Y0E03_4_SCL=1
-        receive <<= 1;
-        if(GP2Y0E03_4_SDA_PORT->IDR & GP2Y0E03_4_SDA_PIN)
-            receive++;
-        GP2Y0E03_DelayUs(2);
-    } 
-    if (!ack)
-        GP2Y0E03_4_IIC_NAck();//nACK
-    else
-        GP2Y0E03_4_IIC_Ack(); //ACK   
-    return receive;
-}
-
+#define GP2Y0E03_INDEX(sensorX)     (31 - __CLZ(sensorX))
 
 /**
  * @brief IICд1ֽڵĴ.
@@ -670,98 +69,8 @@ static inline uint8_t GP2Y0E03_4_IIC_ReadByte(uint8_t ack)
  */
 uint8_t GP2Y0E03_IIC_WriteRegByte(uint8_t sensorX, uint8_t reg, uint8_t data)
 {
-    switch(sensorX)
-    {
-        case GP2Y0E03_1:
-            GP2Y0E03_1_IIC_Start();
-            GP2Y0E03_1_IIC_WriteByte(GP2Y0E03_1_IIC_ADDRESS << 1);//ַ+д
-            if(GP2Y0E03_1_IIC_WaitAck())//ȴӦ
-            {
-                GP2Y0E03_1_IIC_Stop();
-                return 1;
-            }
-            GP2Y0E03_1_IIC_WriteByte(reg);//дĴַ
-            if(GP2Y0E03_1_IIC_WaitAck())//ȴӦ
-            {
-                GP2Y0E03_1_IIC_Stop();
-                return 1;
-            }
-            GP2Y0E03_1_IIC_WriteByte(data);//
-            if(GP2Y0E03_1_IIC_WaitAck())//ȴACK
-            {
-                GP2Y0E03_1_IIC_Stop();
-                return 1;
-            }		 
-            GP2Y0E03_1_IIC_Stop();
-            break;
-        case GP2Y0E03_2:
-            GP2Y0E03_2_IIC_Start();
-            GP2Y0E03_2_IIC_WriteByte(GP2Y0E03_2_IIC_ADDRESS << 1);//ַ+д
-            if(GP2Y0E03_2_IIC_WaitAck())//ȴӦ
-            {
-                GP2Y0E03_2_IIC_Stop();
-                return 1;
-            }
-            GP2Y0E03_2_IIC_WriteByte(reg);//дĴַ
-            if(GP2Y0E03_2_IIC_WaitAck())//ȴӦ
-            {
-                GP2Y0E03_2_IIC_Stop();
-                return 1;
-            }
-            GP2Y0E03_2_IIC_WriteByte(data);//
-            if(GP2Y0E03_2_IIC_WaitAck())//ȴACK
-            {
-                GP2Y0E03_2_IIC_Stop();
-                return 1;
-            }		 
-            GP2Y0E03_2_IIC_Stop();
-            break;
-        case GP2Y0E03_3:
-            GP2Y0E03_3_IIC_Start();
-            GP2Y0E03_3_IIC_WriteByte(GP2Y0E03_3_IIC_ADDRESS << 1);//ַ+д
-            if(GP2Y0E03_3_IIC_WaitAck())//ȴӦ
-            {
-                GP2Y0E03_3_IIC_Stop();
-                return 1;
-            }
-            GP2Y0E03_3_IIC_WriteByte(reg);//дĴַ
-            if(GP2Y0E03_3_IIC_WaitAck())//ȴӦ
-            {
-                GP2Y0E03_3_IIC_Stop();
-                return 1;
-            }
-            GP2Y0E03_3_IIC_WriteByte(data);//
-            if(GP2Y0E03_3_IIC_WaitAck())//ȴACK
-            {
-                GP2Y0E03_3_IIC_Stop();
-                return 1;
-            }		 
-            GP2Y0E03_3_IIC_Stop();
-            break;
-        case GP2Y0E03_4:
-            GP2Y0E03_4_IIC_Start();
-            GP2Y0E03_4_IIC_WriteByte(GP2Y0E03_4_IIC_ADDRESS << 1);//ַ+д
-            if(GP2Y0E03_4_IIC_WaitAck())//ȴӦ
-            {
-                GP2Y0E03_4_IIC_Stop();
-                return 1;
-            }
-            GP2Y0E03_4_IIC_WriteByte(reg);//дĴַ
-            if(GP2Y0E03_4_IIC_WaitAck())//ȴӦ
-            {
-                GP2Y0E03_4_IIC_Stop();
-                return 1;
-            }
-            GP2Y0E03_4_IIC_WriteByte(data);//
-            if(GP2Y0E03_4_IIC_WaitAck())//ȴACK
-            {
-                GP2Y0E03_4_IIC_Stop();
-                return 1;
-            }		 
-            GP2Y0E03_4_IIC_Stop();
-            break;
-    }
-    return 0;
+    uint8_t index = GP2Y0E03_INDEX(sensorX);
+    return IIC_BusWriteRegByte(&gp2y0e03Bus[index], gp2y0e03Address[index], reg, data);
 }
 
 /**
@@ -772,66 +81,8 @@ uint8_t GP2Y0E03_IIC_WriteRegByte(uint8_t sensorX, uint8_t reg, uint8_t data)
  */
 uint8_t GP2Y0E03_IIC_ReadRegByte(uint8_t sensorX, uint8_t reg)
 {
-	uint8_t res;
-    switch(sensorX)
-    {
-        case GP2Y0E03_1:
-            GP2Y0E03_1_IIC_Start(); 
-            GP2Y0E03_1_IIC_WriteByte(GP2Y0E03_1_IIC_ADDRESS << 1);//ַ+д	
-            GP2Y0E03_1_IIC_WaitAck();//ȴӦ
-            GP2Y0E03_1_IIC_WriteByte(reg);//дĴַ
-            GP2Y0E03_1_IIC_WaitAck();//ȴӦ
-            GP2Y0E03_1_IIC_Stop();
-            GP2Y0E03_1_IIC_Start();
-            GP2Y0E03_1_IIC_WriteByte((GP2Y0E03_2_IIC_ADDRESS << 1) | 1);//ַ+	
-            GP2Y0E03_1_IIC_WaitAck();//ȴӦ
-            res = GP2Y0E03_1_IIC_ReadByte(0);//ȡ,nACK 
-            GP2Y0E03_1_IIC_Stop();//һֹͣ
-            break;
-        
-        case GP2Y0E03_2:
-            GP2Y0E03_2_IIC_Start(); 
-            GP2Y0E03_2_IIC_WriteByte(GP2Y0E03_2_IIC_ADDRESS << 1);//ַ+д	
-            GP2Y0E03_2_IIC_WaitAck();//ȴӦ
-            GP2Y0E03_2_IIC_WriteByte(reg);//дĴַ
-            GP2Y0E03_2_IIC_WaitAck();//ȴӦ
-            GP2Y0E03_2_IIC_Stop();
-            GP2Y0E03_2_IIC_Start();
-            GP2Y0E03_2_IIC_WriteByte((GP2Y0E03_2_IIC_ADDRESS << 1) | 1);//ַ+	
-            GP2Y0E03_2_IIC_WaitAck();//ȴӦ
-            res = GP2Y0E03_2_IIC_ReadByte(0);//ȡ,nACK 
-            GP2Y0E03_2_IIC_Stop();//һֹͣ
-            break;
-        
-        case GP2Y0E03_3:
-            GP2Y0E03_3_IIC_Start(); 
-            GP2Y0E03_3_IIC_WriteByte(GP2Y0E03_3_IIC_ADDRESS << 1);//ַ+д	
-            GP2Y0E03_3_IIC_WaitAck();//ȴӦ
-            GP2Y0E03_3_IIC_WriteByte(reg);//дĴַ
-            GP2Y0E03_3_IIC_WaitAck();//ȴӦ
-            GP2Y0E03_3_IIC_Stop();
-            GP2Y0E03_3_IIC_Start();
-            GP2Y0E03_3_IIC_WriteByte((GP2Y0E03_3_IIC_ADDRESS << 1) | 1);//ַ+	
-            GP2Y0E03_3_IIC_WaitAck();//ȴӦ
-            res = GP2Y0E03_3_IIC_ReadByte(0);//ȡ,nACK 
-            GP2Y0E03_3_IIC_Stop();//һֹͣ
-            break;
-        
-        case GP2Y0E03_4:
-            GP2Y0E03_4_IIC_Start(); 
-            GP2Y0E03_4_IIC_WriteByte(GP2Y0E03_4_IIC_ADDRESS << 1);//ַ+д	
-            GP2Y0E03_4_IIC_WaitAck();//ȴӦ
-            GP2Y0E03_4_IIC_WriteByte(reg);//дĴַ
-            GP2Y0E03_4_IIC_WaitAck();//ȴӦ
-            GP2Y0E03_4_IIC_Stop();
-            GP2Y0E03_4_IIC_Start();
-            GP2Y0E03_4_IIC_WriteByte((GP2Y0E03_4_IIC_ADDRESS << 1) | 1);//ַ+	
-            GP2Y0E03_4_IIC_WaitAck();//ȴӦ
-            res = GP2Y0E03_4_IIC_ReadByte(0);//ȡ,nACK 
-            GP2Y0E03_4_IIC_Stop();//һֹͣ
-            break;
-    }
-	return res;		
+    uint8_t index = GP2Y0E03_INDEX(sensorX);
+    return IIC_BusReadRegByte(&gp2y0e03Bus[index], gp2y0e03Address[index], reg);
 }
 
 /**
@@ -844,142 +95,31 @@ uint8_t GP2Y0E03_IIC_ReadRegByte(uint8_t sensorX, uint8_t reg)
  */
 uint8_t GP2Y0E03_IIC_ReadRegBytes(uint8_t sensorX, uint8_t reg, uint8_t len, uint8_t *data)
 {
-    switch(sensorX)
-    {
-        case GP2Y0E03_1:
-            GP2Y0E03_1_IIC_Start();
-            GP2Y0E03_1_IIC_WriteByte(GP2Y0E03_1_IIC_ADDRESS << 1);//ַ+д
-            if(GP2Y0E03_1_IIC_WaitAck())//ȴӦ
-            {
-                GP2Y0E03_1_IIC_Stop();
-                return 1;
-            }
-            GP2Y0E03_1_IIC_WriteByte(reg);//дĴַ
-            if(GP2Y0E03_1_IIC_WaitAck())//ȴӦ
-            {
-                GP2Y0E03_1_IIC_Stop();
-                return 1;
-            }
-            GP2Y0E03_1_IIC_Start();
-            GP2Y0E03_1_IIC_WriteByte((GP2Y0E03_1_IIC_ADDRESS << 1) | 1);//ַ+
-            if(GP2Y0E03_1_IIC_WaitAck())//ȴӦ
-            {
-                GP2Y0E03_1_IIC_Stop();
-                return 1;
-            }
-            while(len)
-            {
-                if(len == 1)
-                    *data=GP2Y0E03_1_IIC_ReadByte(0);//,nACK
-                else
-                    *data=GP2Y0E03_1_IIC_ReadByte(1);//,ACK
-                len--;
-                data++;
-            }
-            GP2Y0E03_1_IIC_Stop();//һֹͣ
-            break;
-            
-        case GP2Y0E03_2:
-            GP2Y0E03_2_IIC_Start();
-            GP2Y0E03_2_IIC_WriteByte(GP2Y0E03_2_IIC_ADDRESS << 1);//ַ+д
-            if(GP2Y0E03_2_IIC_WaitAck())//ȴӦ
-            {
-                GP2Y0E03_2_IIC_Stop();
-                return 1;
-            }
-            GP2Y0E03_2_IIC_WriteByte(reg);//дĴַ
-            if(GP2Y0E03_2_IIC_WaitAck())//ȴӦ
-            {
-                GP2Y0E03_2_IIC_Stop();
-                return 1;
-            }
-            GP2Y0E03_2_IIC_Start();
-            GP2Y0E03_2_IIC_WriteByte((GP2Y0E03_2_IIC_ADDRESS << 1) | 1);//ַ+
-            if(GP2Y0E03_2_IIC_WaitAck())//ȴӦ
-            {
-                GP2Y0E03_2_IIC_Stop();
-                return 1;
-            }
-            while(len)
-            {
-                if(len == 1)
-                    *data=GP2Y0E03_2_IIC_ReadByte(0);//,nACK
-                else
-                    *data=GP2Y0E03_2_IIC_ReadByte(1);//,ACK
-                len--;
-                data++;
-            }
-            GP2Y0E03_2_IIC_Stop();//һֹͣ
-            break;
-            
-        case GP2Y0E03_3:
-            GP2Y0E03_3_IIC_Start();
-            GP2Y0E03_3_IIC_WriteByte(GP2Y0E03_3_IIC_ADDRESS << 1);//ַ+д
-            if(GP2Y0E03_3_IIC_WaitAck())//ȴӦ
-            {
-                GP2Y0E03_3_IIC_Stop();
-                return 1;
-            }
-            GP2Y0E03_3_IIC_WriteByte(reg);//дĴַ
-            if(GP2Y0E03_3_IIC_WaitAck())//ȴӦ
-            {
-                GP2Y0E03_3_IIC_Stop();
-                return 1;
-            }
-            GP2Y0E03_3_IIC_Start();
-            GP2Y0E03_3_IIC_WriteByte((GP2Y0E03_3_IIC_ADDRESS << 1) | 1);//ַ+
-            if(GP2Y0E03_3_IIC_WaitAck())//ȴӦ
-            {
-                GP2Y0E03_3_IIC_Stop();
-                return 1;
-            }
-            while(len)
-            {
-                if(len == 1)
-                    *data=GP2Y0E03_3_IIC_ReadByte(0);//,nACK
-                else
-                    *data=GP2Y0E03_3_IIC_ReadByte(1);//,ACK
-                len--;
-                data++;
-            }
-            GP2Y0E03_3_IIC_Stop();//һֹͣ
-            break;
-            
-        case GP2Y0E03_4:
-            GP2Y0E03_4_IIC_Start();
-            GP2Y0E03_4_IIC_WriteByte(GP2Y0E03_4_IIC_ADDRESS << 1);//ַ+д
-            if(GP2Y0E03_4_IIC_WaitAck())//ȴӦ
-            {
-                GP2Y0E03_4_IIC_Stop();
-                return 1;
-            }
-            GP2Y0E03_4_IIC_WriteByte(reg);//дĴַ
-            if(GP2Y0E03_4_IIC_WaitAck())//ȴӦ
-            {
-                GP2Y0E03_4_IIC_Stop();
-                return 1;
-            }
-            GP2Y0E03_4_IIC_Start();
-            GP2Y0E03_4_IIC_WriteByte((GP2Y0E03_4_IIC_ADDRESS << 1) | 1);//ַ+
-            if(GP2Y0E03_4_IIC_WaitAck())//ȴӦ
-            {
-                GP2Y0E03_4_IIC_Stop();
-                return 1;
-            }
-            while(len)
-            {
-                if(len == 1)
-                    *data=GP2Y0E03_4_IIC_ReadByte(0);//,nACK
-                else
-                    *data=GP2Y0E03_4_IIC_ReadByte(1);//,ACK
-                len--;
-                data++;
-            }
-            GP2Y0E03_4_IIC_Stop();//һֹͣ
-            break;
-    }
+    uint8_t index = GP2Y0E03_INDEX(sensorX);
+    return IIC_BusReadRegBytes(&gp2y0e03Bus[index], gp2y0e03Address[index], reg, len, data);
+}
+
+/**
+ * @brief дüĴ, 봫еֵͬʱ.
+ * @param sensorX ָĴ, GP2Y0E03_ALL @ref GP2Y0E03_select ѡһ.
+ * @param reg Ĵַ, λʱֱд.
+ * @param data Ҫд.
+ * @return 0-; 1-.
+ */
+static uint8_t GP2Y0E03_WriteConfig(uint8_t sensorX, uint8_t reg, uint8_t data)
+{
+    IIC_CACHE_DeviceTypedef *cache = gp2y0e03Cache[GP2Y0E03_INDEX(sensorX)];
+    return IIC_CACHE_Write(reg < 0xA8 ? &cache[0] : &cache[1], reg, data);
+}
 
-    return 0;
+/**
+ * @brief λʼʹʧЧ.
+ * @param index е.
+ */
+static void GP2Y0E03_InvalidateCache(uint8_t index)
+{
+    IIC_CACHE_Invalidate(&gp2y0e03Cache[index][0]);
+    IIC_CACHE_Invalidate(&gp2y0e03Cache[index][1]);
 }
 
 /**
@@ -992,7 +132,7 @@ uint8_t GP2Y0E03_IIC_ReadRegBytes(uint8_t sensorX, uint8_t reg, uint8_t len, uin
  */
 inline void GP2Y0E03_SetMaxPulseWidth(uint8_t sensorX, GP2Y0E03_MaxPulseWidthTypedef maxPulseWidth)
 {
-    GP2Y0E03_IIC_WriteRegByte(sensorX, 0x13, maxPulseWidth);
+    GP2Y0E03_WriteConfig(sensorX, 0x13, maxPulseWidth);
 }
 
 /**
@@ -1004,7 +144,7 @@ inline void GP2Y0E03_SetMaxPulseWidth(uint8_t sensorX, GP2Y0E03_MaxPulseWidthTyp
  */
 inline void GP2Y0E03_SetSignalAccumulation(uint8_t sensorX, GP2Y0E03_SignalAccumulationTypedef signalAccumulation)
 {
-    GP2Y0E03_IIC_WriteRegByte(sensorX, 0xA8, signalAccumulation);
+    GP2Y0E03_WriteConfig(sensorX, 0xA8, signalAccumulation);
 }
 
 /**
@@ -1018,7 +158,7 @@ inline void GP2Y0E03_SetSignalAccumulation(uint8_t sensorX, GP2Y0E03_SignalAccum
  */
 inline void GP2Y0E03_SetMedianFilter(uint8_t sensorX, GP2Y0E03_MedianFilterTypedef medianFilter)
 {
-    GP2Y0E03_IIC_WriteRegByte(sensorX, 0x3F, medianFilter);
+    GP2Y0E03_WriteConfig(sensorX, 0x3F, medianFilter);
 }
 
 /**
@@ -1032,8 +172,8 @@ inline void GP2Y0E03_SetMedianFilter(uint8_t sensorX, GP2Y0E03_MedianFilterTyped
  */
 inline void GP2Y0E03_SetSignalIntensityJudement(uint8_t sensorX, FunctionalState command, uint8_t signalIntensityThreshold)
 {
-    GP2Y0E03_IIC_WriteRegByte(sensorX, 0xBC, command == DISABLE);
-    GP2Y0E03_IIC_WriteRegByte(sensorX, 0x2F, signalIntensityThreshold);
+    GP2Y0E03_WriteConfig(sensorX, 0xBC, command == DISABLE);
+    GP2Y0E03_WriteConfig(sensorX, 0x2F, signalIntensityThreshold);
 }
 
 /**
@@ -1047,8 +187,8 @@ inline void GP2Y0E03_SetSignalIntensityJudement(uint8_t sensorX, FunctionalState
  */
 inline void GP2Y0E03_SetMinSpotSizeJudement(uint8_t sensorX, FunctionalState command, uint8_t minSpotSizeThreshold)
 {
-    GP2Y0E03_IIC_WriteRegByte(sensorX, 0xBD, command == DISABLE);
-    GP2Y0E03_IIC_WriteRegByte(sensorX, 0x34, minSpotSizeThreshold);
+    GP2Y0E03_WriteConfig(sensorX, 0xBD, command == DISABLE);
+    GP2Y0E03_WriteConfig(sensorX, 0x34, minSpotSizeThreshold);
 }
 
 /**
@@ -1063,8 +203,8 @@ inline void GP2Y0E03_SetMinSpotSizeJudement(uint8_t sensorX, FunctionalState com
  */
 inline void GP2Y0E03_SetMaxSpotSizeJudement(uint8_t sensorX, FunctionalState command, uint8_t maxSpotSizeThreshold)
 {
-    GP2Y0E03_IIC_WriteRegByte(sensorX, 0xBE, command == DISABLE);
-    GP2Y0E03_IIC_WriteRegByte(sensorX, 0x33, maxSpotSizeThreshold);
+    GP2Y0E03_WriteConfig(sensorX, 0xBE, command == DISABLE);
+    GP2Y0E03_WriteConfig(sensorX, 0x33, maxSpotSizeThreshold);
 }
 
 /**
@@ -1078,8 +218,8 @@ inline void GP2Y0E03_SetMaxSpotSizeJudement(uint8_t sensorX, FunctionalState com
  */
 inline void GP2Y0E03_SetSpotSymmetryJudement(uint8_t sensorX, FunctionalState command, uint8_t spotSymmetryThreshold)
 {
-    GP2Y0E03_IIC_WriteRegByte(sensorX, 0xBF, command == DISABLE);
-    GP2Y0E03_IIC_WriteRegByte(sensorX, 0x1C, spotSymmetryThreshold);
+    GP2Y0E03_WriteConfig(sensorX, 0xBF, command == DISABLE);
+    GP2Y0E03_WriteConfig(sensorX, 0x1C, spotSymmetryThreshold);
 }
 
 /**
@@ -1091,22 +231,8 @@ inline void GP2Y0E03_SetSpotSymmetryJudement(uint8_t sensorX, FunctionalState co
  */
 inline void GP2Y0E03_SetMaxOutputDistance(uint8_t sensorX, GP2Y0E03_MaxOutputDistanceTypedef maxOutputDistance)
 {
-    GP2Y0E03_IIC_WriteRegByte(sensorX, 0x35, maxOutputDistance);
-    switch(sensorX)
-    {
-        case GP2Y0E03_1:
-            GP2Y0E03_maxOutputDistance[0] = maxOutputDistance;
-            break;
-        case GP2Y0E03_2:
-            GP2Y0E03_maxOutputDistance[1] = maxOutputDistance;
-            break;
-        case GP2Y0E03_3:
-            GP2Y0E03_maxOutputDistance[2] = maxOutputDistance;
-        break;
-        case GP2Y0E03_4:
-            GP2Y0E03_maxOutputDistance[3] = maxOutputDistance;
-            break;
-    }
+    GP2Y0E03_WriteConfig(sensorX, 0x35, maxOutputDistance);
+    GP2Y0E03_maxOutputDistance[GP2Y0E03_INDEX(sensorX)] = maxOutputDistance;
 }
 
 /**
@@ -1118,8 +244,8 @@ inline void GP2Y0E03_SetMaxOutputDistance(uint8_t sensorX, GP2Y0E03_MaxOutputDis
  */
 inline void GP2Y0E03_StateControlState(uint8_t sensorX, FunctionalState setActive)
 {
-    GP2Y0E03_IIC_WriteRegByte(sensorX, 0xE8, setActive == DISABLE);
-    GP2Y0E03_DelayUs(600);
+    GP2Y0E03_WriteConfig(sensorX, 0xE8, setActive == DISABLE);
+    UTILS_DelayUs(600);
 }
 
 /**
@@ -1133,6 +259,7 @@ inline void GP2Y0E03_SoftwareReset(uint8_t sensorX)
     GP2Y0E03_IIC_WriteRegByte(sensorX, 0xEF, 0xEC);
     GP2Y0E03_IIC_WriteRegByte(sensorX, 0x06, 0xEE);
     GP2Y0E03_IIC_WriteRegByte(sensorX, 0x7F, 0xEC);
+    GP2Y0E03_InvalidateCache(GP2Y0E03_INDEX(sensorX));
 }
 
 /**
@@ -1164,12 +291,52 @@ float GP2Y0E03_ReadOutDistance(uint8_t sensorX)
     high = (uint32_t)GP2Y0E03_IIC_ReadRegByte(sensorX, 0x5E);
     low = (uint32_t)GP2Y0E03_IIC_ReadRegByte(sensorX, 0x5F);
     res = (high << 4) | low;
-    if(GP2Y0E03_maxOutputDistance[0] == GP2Y0E03_Mod_128cm)
+    if(GP2Y0E03_maxOutputDistance[GP2Y0E03_INDEX(sensorX)] == GP2Y0E03_Mod_128cm)
         return (float)res / 128.0f;
     else
         return (float)res / 64.0f;
 }
 
+/**
+ * @brief ͬʱȡѳʼĴĲ.
+ * @param out (cm), out[0]~out[3]ӦGP2Y0E03_1~GP2Y0E03_4, δʼĲ޸.
+ * @return δʼĴ, @ref GP2Y0E03_select ; 0-ȫ.
+ * @note SCLͬһGPIO˿SDAͬһGPIO˿ʱ, ͬշ, ʱһͬ;
+ *       ζȡ.
+ */
+uint8_t GP2Y0E03_ReadAllDistances(float out[4])
+{
+    IIC_BusTypedef *buses[4];
+    uint8_t address[4], index[4], data[4][2];
+    uint8_t i, count = 0, failed, result = GP2Y0E03_ALL & ~initializedSensors;
+    int32_t res;
+    for(i = 0; i < 4; i++)
+    {
+        if(!(initializedSensors & (1 << i)))
+            continue;
+        buses[count] = &gp2y0e03Bus[i];
+        address[count] = gp2y0e03Address[i];
+        index[count++] = i;
+    }
+    if(count == 0)
+        return result;
+    failed = IIC_BusReadRegBytesParallel(buses, count, address, 0x5E, 2, data[0]);
+    for(i = 0; i < count; i++)
+    {
+        if(failed & (1 << i))
+        {
+            result |= 1 << index[i];
+            continue;
+        }
+        res = ((int32_t)data[i][0] << 4) | data[i][1];
+        if(GP2Y0E03_maxOutputDistance[index[i]] == GP2Y0E03_Mod_128cm)
+            out[index[i]] = (float)res / 128.0f;
+        else
+            out[index[i]] = (float)res / 64.0f;
+    }
+    return result;
+}
+
 /**
  * @brief ʼ.
  * @param sensorX ָĴ,  @ref GP2Y0E03_select .
@@ -1178,7 +345,9 @@ void GP2Y0E03_Init(uint8_t sensorX)
 {
     if(sensorX & GP2Y0E03_1)
     {
-        GP2Y0E03_1_IIC_Init();
+        IIC_InitBus(&gp2y0e03Bus[0]);
+        initializedSensors |= GP2Y0E03_1;
+        GP2Y0E03_InvalidateCache(0);
         GP2Y0E03_SetSignalIntensityJudement(GP2Y0E03_1,DISABLE, 0);
         GP2Y0E03_SetMinSpotSizeJudement(GP2Y0E03_1, DISABLE, 0);
         GP2Y0E03_SetMaxSpotSizeJudement(GP2Y0E03_1, DISABLE, 0);
@@ -1187,7 +356,9 @@ void GP2Y0E03_Init(uint8_t sensorX)
     
     if(sensorX & GP2Y0E03_2)
     {
-        GP2Y0E03_2_IIC_Init();
+        IIC_InitBus(&gp2y0e03Bus[1]);
+        initializedSensors |= GP2Y0E03_2;
+        GP2Y0E03_InvalidateCache(1);
 //        GP2Y0E03_SetSignalIntensityJudement(GP2Y0E03_2,DISABLE, 0);
 //        GP2Y0E03_SetMinSpotSizeJudement(GP2Y0E03_2, DISABLE, 0);
 //        GP2Y0E03_SetMaxSpotSizeJudement(GP2Y0E03_2, DISABLE, 0);
@@ -1196,7 +367,9 @@ void GP2Y0E03_Init(uint8_t sensorX)
     
     if(sensorX & GP2Y0E03_3)
     {
-        GP2Y0E03_3_IIC_Init();
+        IIC_InitBus(&gp2y0e03Bus[2]);
+        initializedSensors |= GP2Y0E03_3;
+        GP2Y0E03_InvalidateCache(2);
         GP2Y0E03_SetSignalIntensityJudement(GP2Y0E03_3,DISABLE, 0);
         GP2Y0E03_SetMinSpotSizeJudement(GP2Y0E03_3, DISABLE, 0);
         GP2Y0E03_SetMaxSpotSizeJudement(GP2Y0E03_3, DISABLE, 0);
@@ -1205,7 +378,9 @@ void GP2Y0E03_Init(uint8_t sensorX)
     
     if(sensorX & GP2Y0E03_4)
     {
-        GP2Y0E03_4_IIC_Init();
+        IIC_InitBus(&gp2y0e03Bus[3]);
+        initializedSensors |= GP2Y0E03_4;
+        GP2Y0E03_InvalidateCache(3);
         GP2Y0E03_SetSignalIntensityJudement(GP2Y0E03_4,DISABLE, 0);
         GP2Y0E03_SetMinSpotSizeJudement(GP2Y0E03_4, DISABLE, 0);
         GP2Y0E03_SetMaxSpotSizeJudement(GP2Y0E03_4, DISABLE, 0);
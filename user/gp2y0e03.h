@@ -1,7 +1,7 @@
 /**
  * @file    gp2y0e03.h
  * @author  Miaow
- * @version 0.1.1
+ * @version 0.4.0
  * @date    2018/10/19
  * @brief   
  *          This file provides functions to manage the following 
@@ -9,9 +9,11 @@
  *              1. Initialization
  *              2. Configurations
  *              3. distance Measurement
+ *              4. Read all sensors at once over lock-step buses
+ *              5. Skip configuration writes that do not change the sensor
  * @note
  *          Minimum version of source file:
- *              0.1.0
+ *              0.4.0
  *          Pin connection:
  *               
  *              PE12SCL     
@@ -32,6 +34,7 @@
 #define __GP2Y0E03_H
 
 #include "stm32f4xx.h"
+#include "bsp_iic.h"
 
 /** 
  * @defgroup GP2Y0E03
@@ -43,41 +46,27 @@
  * @{
  */
 //GPIO
+#define GP2Y0E03_IIC_SPEED          400000 //!< SCLƵ(Hz), 400kHz
+
 #define GP2Y0E03_1_SCL_PORT         GPIOE
 #define GP2Y0E03_1_SCL_PIN          GPIO_Pin_12
-#define GP2Y0E03_1_SCL_GPIO_CLK     RCC_AHB1Periph_GPIOE
 #define GP2Y0E03_1_SDA_PORT         GPIOE
 #define GP2Y0E03_1_SDA_PIN          GPIO_Pin_15
-#define GP2Y0E03_1_SDA_GPIO_CLK     RCC_AHB1Periph_GPIOE
-#define GP2Y0E03_1_In()             GP2Y0E03_1_SDA_PORT->MODER &= ~0xC0000000;GP2Y0E03_1_SDA_PORT->MODER |= 0x00000000//ģʽ
-#define GP2Y0E03_1_Out()            GP2Y0E03_1_SDA_PORT->MODER &= ~0xC0000000;GP2Y0E03_1_SDA_PORT->MODER |= 0x40000000//ģʽ
 
 #define GP2Y0E03_2_SCL_PORT         GPIOE
 #define GP2Y0E03_2_SCL_PIN          GPIO_Pin_8
-#define GP2Y0E03_2_SCL_GPIO_CLK     RCC_AHB1Periph_GPIOE
 #define GP2Y0E03_2_SDA_PORT         GPIOE
 #define GP2Y0E03_2_SDA_PIN          GPIO_Pin_10
-#define GP2Y0E03_2_SDA_GPIO_CLK     RCC_AHB1Periph_GPIOE
-#define GP2Y0E03_2_In()             GP2Y0E03_2_SDA_PORT->MODER &= ~0x00300000;GP2Y0E03_2_SDA_PORT->MODER |= 0x00000000//ģʽ
-#define GP2Y0E03_2_Out()            GP2Y0E03_2_SDA_PORT->MODER &= ~0x00300000;GP2Y0E03_2_SDA_PORT->MODER |= 0x00100000//ģʽ
 
 #define GP2Y0E03_3_SCL_PORT         GPIOE
 #define GP2Y0E03_3_SCL_PIN          GPIO_Pin_2
-#define GP2Y0E03_3_SCL_GPIO_CLK     RCC_AHB1Periph_GPIOE
 #define GP2Y0E03_3_SDA_PORT         GPIOE
 #define GP2Y0E03_3_SDA_PIN          GPIO_Pin_4
-#define GP2Y0E03_3_SDA_GPIO_CLK     RCC_AHB1Periph_GPIOE
-#define GP2Y0E03_3_In()             GP2Y0E03_3_SDA_PORT->MODER &= ~0x00000300;GP2Y0E03_3_SDA_PORT->MODER |= 0x00000000//ģʽ
-#define GP2Y0E03_3_Out()            GP2Y0E03_3_SDA_PORT->MODER &= ~0x00000300;GP2Y0E03_3_SDA_PORT->MODER |= 0x00000100//ģʽ
 
 #define GP2Y0E03_4_SCL_PORT         GPIOE
 #define GP2Y0E03_4_SCL_PIN          GPIO_Pin_5
-#define GP2Y0E03_4_SCL_GPIO_CLK     RCC_AHB1Periph_GPIOE
 #define GP2Y0E03_4_SDA_PORT         GPIOE
 #define GP2Y0E03_4_SDA_PIN          GPIO_Pin_3
-#define GP2Y0E03_4_SDA_GPIO_CLK     RCC_AHB1Periph_GPIOE
-#define GP2Y0E03_4_In()             GP2Y0E03_4_SDA_PORT->MODER &= ~0x000000C0;GP2Y0E03_4_SDA_PORT->MODER |= 0x00000000//ģʽ
-#define GP2Y0E03_4_Out()            GP2Y0E03_4_SDA_PORT->MODER &= ~0x000000C0;GP2Y0E03_4_SDA_PORT->MODER |= 0x00000040//ģʽ
 /**
  * @}
  */
@@ -162,6 +151,7 @@ typedef enum
 
 void GP2Y0E03_Init(uint8_t sensorX);
 float GP2Y0E03_ReadOutDistance(uint8_t sensorX);
+uint8_t GP2Y0E03_ReadAllDistances(float out[4]);
 uint32_t GP2Y0E03_ReadOutIntensity(uint8_t sensorX);
 extern inline void GP2Y0E03_SoftwareReset(uint8_t sensorX);
 extern inline void GP2Y0E03_StateControlState(uint8_t sensorX, FunctionalState setActive);
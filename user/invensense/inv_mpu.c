@@ -11,10 +11,9 @@
  *  @{
  *      @file       inv_mpu.c
  *      @brief      An I2C-based driver for Invensense gyroscopes.
- *      @details    This driver currently works for the following devices:
+ *      @details    This driver currently works for the following devices,
+ *                  selected at run time with mpu_select_chip:
  *                  MPU6050
- *                  MPU6500
- *                  MPU9150 (or MPU6050 w/ AK8975 on the auxiliary bus)
  *                  MPU9250 (or MPU6500 w/ AK8963 on the auxiliary bus)
  */
 #include "stdio.h"
@@ -37,14 +36,34 @@
  * min(int a, int b)
  */
 #if defined EMPL_TARGET_STM32F4
-#include "bsp_iic.h"
+#include "bsp_iic_sched.h"
 #include "utils.h"
 //#include "main.h"
 //#include "log.h"
 //#include "board-st_discovery.h"
-   
-#define i2c_write       IIC_WriteRegBytes
-#define i2c_read        IIC_ReadRegBytes 
+
+/* Transfers to the gyro (0x68) go through the scheduler, the DMP FIFO reads
+ * are queued ahead of slower sensors and never batched, since reading
+ * FIFO_R_W pops the FIFO. setup_compass and the compass self-test talk to the
+ * AK8963 at its own address in bypass mode, those go straight to the bus.
+ */
+static IIC_SCHED_DeviceTypedef inv_device = IIC_SCHED_DEVICE(0x68, 1, 0);
+
+static int i2c_write(unsigned char slave_addr, unsigned char reg_addr,
+    unsigned char length, unsigned char *data)
+{
+    if (slave_addr != inv_device.addr)
+        return IIC_WriteRegBytes(slave_addr, reg_addr, length, data);
+    return IIC_SCHED_WriteRegBytes(&inv_device, reg_addr, length, data);
+}
+
+static int i2c_read(unsigned char slave_addr, unsigned char reg_addr,
+    unsigned char length, unsigned char *data)
+{
+    if (slave_addr != inv_device.addr)
+        return IIC_ReadRegBytes(slave_addr, reg_addr, length, data);
+    return IIC_SCHED_ReadRegBytes(&inv_device, reg_addr, length, data);
+}
 #define delay_ms        UTILS_DelayMs
 #define get_ms(...)     do {} while (0)
 #define log_i(...)      do {} while (0)
@@ -120,45 +139,29 @@ static inline int reg_int_cb(struct int_param_s *int_param)
 #error  Gyro driver is missing the system layer implementations.
 #endif
 
-#if !defined MPU6050 && !defined MPU9150 && !defined MPU6500 && !defined MPU9250
-#error  Which gyro are you using? Define MPUxxxx in your compiler options.
-#endif
-
-/* Time for some messy macro work. =]
- * #define MPU9150
- * is equivalent to..
- * #define MPU6050
- * #define AK8975_SECONDARY
- *
- * #define MPU9250
- * is equivalent to..
- * #define MPU6500
- * #define AK8963_SECONDARY
+/* The chip is selected at run time with mpu_select_chip, so one copy of the
+ * driver serves both the MPU6050 and the MPU9250 boards.
+ * MPU6050 uses the MPU6050 register set and has no compass.
+ * MPU9250 is an MPU6500 with an AK8963 on the auxiliary bus.
+ * MPU9150 and the AK8975 are not supported.
  */
-#if defined MPU9150
-#ifndef MPU6050
-#define MPU6050
-#endif                          /* #ifndef MPU6050 */
-#if defined AK8963_SECONDARY
-#error "MPU9150 and AK8963_SECONDARY cannot both be defined."
-#elif !defined AK8975_SECONDARY /* #if defined AK8963_SECONDARY */
-#define AK8975_SECONDARY
-#endif                          /* #if defined AK8963_SECONDARY */
-#elif defined MPU9250           /* #if defined MPU9150 */
-#ifndef MPU6500
-#define MPU6500
-#endif                          /* #ifndef MPU6500 */
-#if defined AK8975_SECONDARY
-#error "MPU9250 and AK8975_SECONDARY cannot both be defined."
-#elif !defined AK8963_SECONDARY /* #if defined AK8975_SECONDARY */
 #define AK8963_SECONDARY
-#endif                          /* #if defined AK8975_SECONDARY */
-#endif                          /* #if defined MPU9150 */
-
-#if defined AK8975_SECONDARY || defined AK8963_SECONDARY
 #define AK89xx_SECONDARY
+
+/* Register set of the chip. */
+#define INV_CHIP_6050       (0)
+#define INV_CHIP_6500       (1)
+#if MPU_CHIP_6050 && MPU_CHIP_9250
+#define IS_6500             (st.chip->type == INV_CHIP_6500)
+#define HAS_COMPASS         (st.chip->compass)
+#elif MPU_CHIP_9250
+#define IS_6500             (1)
+#define HAS_COMPASS         (1)
+#elif MPU_CHIP_6050
+#define IS_6500             (0)
+#define HAS_COMPASS         (0)
 #else
-/* #warning "No compass = less profit for Invensense. Lame." */
+#error  Enable MPU_CHIP_6050 or MPU_CHIP_9250 in inv_mpu.h.
 #endif
 
 static int set_int_enable(unsigned char enable);
@@ -195,7 +198,6 @@ struct gyro_reg_s {
     unsigned char bank_sel;
     unsigned char mem_start_addr;
     unsigned char prgm_start_h;
-#if defined AK89xx_SECONDARY
     unsigned char s0_addr;
     unsigned char s0_reg;
     unsigned char s0_ctrl;
@@ -209,7 +211,6 @@ struct gyro_reg_s {
     unsigned char raw_compass;
     /* The I2C_MST_VDDIO bit is in this register. */
     unsigned char yg_offs_tc;
-#endif
 };
 
 /* Information specific to a particular device. */
@@ -219,10 +220,11 @@ struct hw_s {
     unsigned char num_reg;
     unsigned short temp_sens;
     short temp_offset;
+    /* Temperature in degrees C when the raw reading equals temp_offset. */
+    short temp_base;
     unsigned short bank_size;
-#if defined AK89xx_SECONDARY
+    /* 0 if there is no compass. */
     unsigned short compass_fsr;
-#endif
 };
 
 /* When entering motion interrupt mode, the driver keeps track of the
@@ -280,12 +282,10 @@ struct chip_cfg_s {
     unsigned char dmp_loaded;
     /* Sampling rate used when DMP is enabled. */
     unsigned short dmp_sample_rate;
-#ifdef AK89xx_SECONDARY
     /* Compass sample rate. */
     unsigned short compass_sample_rate;
     unsigned char compass_addr;
     short mag_sens_adj[3];
-#endif
 };
 
 /* Information for self-test. */
@@ -304,14 +304,23 @@ struct test_s {
     float min_g;
     float max_g;
     float max_accel_var;
-#ifdef MPU6500
     float max_g_offset;
     unsigned short sample_wait_ms;
-#endif
+};
+
+/* Chip descriptor, see mpu_select_chip. */
+struct mpu_chip_s {
+    unsigned char type;
+    /* 1 if an AK8963 is on the auxiliary I2C bus. */
+    unsigned char compass;
+    const struct gyro_reg_s *reg;
+    const struct hw_s *hw;
+    const struct test_s *test;
 };
 
 /* Gyro driver state variables. */
 struct gyro_state_s {
+    const struct mpu_chip_s *chip;
     const struct gyro_reg_s *reg;
     const struct hw_s *hw;
     struct chip_cfg_s chip_cfg;
@@ -357,13 +366,14 @@ enum clock_sel_e {
 };
 
 /* Low-power accel wakeup rates. */
+enum lp_accel_rate_6050_e {
+    INV_6050_LPA_1_25HZ,
+    INV_6050_LPA_5HZ,
+    INV_6050_LPA_20HZ,
+    INV_6050_LPA_40HZ
+};
+
 enum lp_accel_rate_e {
-#if defined MPU6050
-    INV_LPA_1_25HZ,
-    INV_LPA_5HZ,
-    INV_LPA_20HZ,
-    INV_LPA_40HZ
-#elif defined MPU6500
     INV_LPA_0_3125HZ,
     INV_LPA_0_625HZ,
     INV_LPA_1_25HZ,
@@ -376,7 +386,6 @@ enum lp_accel_rate_e {
     INV_LPA_160HZ,
     INV_LPA_320HZ,
     INV_LPA_640HZ
-#endif
 };
 
 #define BIT_I2C_MST_VDDIO   (0x80)
@@ -421,15 +430,9 @@ enum lp_accel_rate_e {
 #define BIT_STBY_XYZA       (BIT_STBY_XA | BIT_STBY_YA | BIT_STBY_ZA)
 #define BIT_STBY_XYZG       (BIT_STBY_XG | BIT_STBY_YG | BIT_STBY_ZG)
 
-#if defined AK8975_SECONDARY
-#define SUPPORTS_AK89xx_HIGH_SENS   (0x00)
-#define AK89xx_FSR                  (9830)
-#elif defined AK8963_SECONDARY
 #define SUPPORTS_AK89xx_HIGH_SENS   (0x10)
 #define AK89xx_FSR                  (4915)
-#endif
 
-#ifdef AK89xx_SECONDARY
 #define AKM_REG_WHOAMI      (0x00)
 
 #define AKM_REG_ST1         (0x02)
@@ -455,10 +458,9 @@ enum lp_accel_rate_e {
 #define AKM_MODE_SELF_TEST      (0x08 | SUPPORTS_AK89xx_HIGH_SENS)
 
 #define AKM_WHOAMI      (0x48)
-#endif
 
-#if defined MPU6050
-const struct gyro_reg_s reg = {
+#if MPU_CHIP_6050
+static const struct gyro_reg_s reg_6050 = {
     .who_am_i       = 0x75,
     .rate_div       = 0x19,
     .lpf            = 0x1A,
@@ -485,9 +487,8 @@ const struct gyro_reg_s reg = {
     .i2c_mst        = 0x24,
     .bank_sel       = 0x6D,
     .mem_start_addr = 0x6E,
-    .prgm_start_h   = 0x70
-#ifdef AK89xx_SECONDARY
-    ,.raw_compass   = 0x49,
+    .prgm_start_h   = 0x70,
+    .raw_compass   = 0x49,
     .yg_offs_tc     = 0x01,
     .s0_addr        = 0x25,
     .s0_reg         = 0x26,
@@ -499,21 +500,19 @@ const struct gyro_reg_s reg = {
     .s0_do          = 0x63,
     .s1_do          = 0x64,
     .i2c_delay_ctrl = 0x67
-#endif
 };
-const struct hw_s hw = {
+static const struct hw_s hw_6050 = {
     .addr           = 0x68,
     .max_fifo       = 1024,
     .num_reg        = 118,
     .temp_sens      = 340,
     .temp_offset    = -521,
-    .bank_size      = 256
-#if defined AK89xx_SECONDARY
-    ,.compass_fsr    = AK89xx_FSR
-#endif
+    .temp_base      = 35,
+    .bank_size      = 256,
+    .compass_fsr    = 0
 };
 
-const struct test_s test = {
+static const struct test_s test_6050 = {
     .gyro_sens      = 32768/250,
     .accel_sens     = 32768/16,
     .reg_rate_div   = 0,    /* 1kHz. */
@@ -529,14 +528,10 @@ const struct test_s test = {
     .max_g          = 0.95f,
     .max_accel_var  = 0.14f
 };
+#endif
 
-static struct gyro_state_s st = {
-    .reg = &reg,
-    .hw = &hw,
-    .test = &test
-};
-#elif defined MPU6500
-const struct gyro_reg_s reg = {
+#if MPU_CHIP_9250
+static const struct gyro_reg_s reg_6500 = {
     .who_am_i       = 0x75,
     .rate_div       = 0x19,
     .lpf            = 0x1A,
@@ -566,9 +561,8 @@ const struct gyro_reg_s reg = {
     .i2c_mst        = 0x24,
     .bank_sel       = 0x6D,
     .mem_start_addr = 0x6E,
-    .prgm_start_h   = 0x70
-#ifdef AK89xx_SECONDARY
-    ,.raw_compass   = 0x49,
+    .prgm_start_h   = 0x70,
+    .raw_compass   = 0x49,
     .s0_addr        = 0x25,
     .s0_reg         = 0x26,
     .s0_ctrl        = 0x27,
@@ -579,21 +573,19 @@ const struct gyro_reg_s reg = {
     .s0_do          = 0x63,
     .s1_do          = 0x64,
     .i2c_delay_ctrl = 0x67
-#endif
 };
-const struct hw_s hw = {
+static const struct hw_s hw_6500 = {
     .addr           = 0x68,
     .max_fifo       = 1024,
     .num_reg        = 128,
     .temp_sens      = 321,
     .temp_offset    = 0,
-    .bank_size      = 256
-#if defined AK89xx_SECONDARY
-    ,.compass_fsr    = AK89xx_FSR
-#endif
+    .temp_base      = 21,
+    .bank_size      = 256,
+    .compass_fsr    = AK89xx_FSR
 };
 
-const struct test_s test = {
+static const struct test_s test_6500 = {
     .gyro_sens      = 32768/250,
     .accel_sens     = 32768/2,  //FSR = +-2G = 16384 LSB/G
     .reg_rate_div   = 0,    /* 1kHz. */
@@ -611,23 +603,69 @@ const struct test_s test = {
     .max_g_offset   = .5f,   //500 mg for Accel Criteria C
     .sample_wait_ms = 10    //10ms sample time wait
 };
+#endif
 
-static struct gyro_state_s st = {
-    .reg = &reg,
-    .hw = &hw,
-    .test = &test
+#if MPU_CHIP_6050
+const struct mpu_chip_s mpu_chip_6050 = {
+    .type = INV_CHIP_6050,
+    .compass = 0,
+    .reg = &reg_6050,
+    .hw = &hw_6050,
+    .test = &test_6050
 };
 #endif
 
+#if MPU_CHIP_9250
+const struct mpu_chip_s mpu_chip_9250 = {
+    .type = INV_CHIP_6500,
+    .compass = 1,
+    .reg = &reg_6500,
+    .hw = &hw_6500,
+    .test = &test_6500
+};
+#endif
+
+static struct gyro_state_s st = {
+#if MPU_CHIP_6050
+    .chip = &mpu_chip_6050,
+    .reg = &reg_6050,
+    .hw = &hw_6050,
+    .test = &test_6050
+#else
+    .chip = &mpu_chip_9250,
+    .reg = &reg_6500,
+    .hw = &hw_6500,
+    .test = &test_6500
+#endif
+};
+
 #define MAX_PACKET_LENGTH (12)
-#ifdef MPU6500
 #define HWST_MAX_PACKET_LENGTH (512)
-#endif
 
-#ifdef AK89xx_SECONDARY
 static int setup_compass(void);
 #define MAX_COMPASS_SAMPLE_RATE (100)
-#endif
+
+/**
+ *  @brief      Select the chip the driver talks to.
+ *  Call before mpu_init. The driver keeps the state of one chip, so select
+ *  and initialize again when switching to another chip. MPU6050 is selected
+ *  by default, or MPU9250 when MPU_CHIP_6050 is 0.
+ *  @param[in]  chip    &mpu_chip_6050 or &mpu_chip_9250.
+ *  @return     0 if successful.
+ */
+int mpu_select_chip(const struct mpu_chip_s *chip)
+{
+    if (!chip)
+        return -1;
+    st.chip = chip;
+    st.reg = chip->reg;
+    st.hw = chip->hw;
+    st.test = chip->test;
+    st.chip_cfg.sensors = 0;
+    st.chip_cfg.dmp_on = 0;
+    st.chip_cfg.dmp_loaded = 0;
+    return 0;
+}
 
 /**
  *  @brief      Enable/disable data ready interrupt.
@@ -729,14 +767,14 @@ int mpu_init()
 
    st.chip_cfg.accel_half = 0;
 
-#ifdef MPU6500
-    /* MPU6500 shares 4kB of memory between the DMP and the FIFO. Since the
-     * first 3kB are needed by the DMP, we'll use the last 1kB for the FIFO.
-     */
-    data[0] = BIT_FIFO_SIZE_1024 | 0x8;
-    if (i2c_write(st.hw->addr, st.reg->accel_cfg2, 1, data))
-        return -1;
-#endif
+    if (IS_6500) {
+        /* MPU6500 shares 4kB of memory between the DMP and the FIFO. Since the
+         * first 3kB are needed by the DMP, we'll use the last 1kB for the FIFO.
+         */
+        data[0] = BIT_FIFO_SIZE_1024 | 0x8;
+        if (i2c_write(st.hw->addr, st.reg->accel_cfg2, 1, data))
+            return -1;
+    }
 
     /* Set to invalid values to ensure no I2C writes are skipped. */
     st.chip_cfg.sensors = 0xFF;
@@ -746,9 +784,7 @@ int mpu_init()
     st.chip_cfg.sample_rate = 0xFFFF;
     st.chip_cfg.fifo_enable = 0xFF;
     st.chip_cfg.bypass_mode = 0xFF;
-#ifdef AK89xx_SECONDARY
     st.chip_cfg.compass_sample_rate = 0xFFFF;
-#endif
     /* mpu_set_sensors always preserves this setting. */
     st.chip_cfg.clk_src = INV_CLK_PLL;
     /* Handled in next call to mpu_set_bypass. */
@@ -772,15 +808,15 @@ int mpu_init()
     if (mpu_configure_fifo(0))
         return -1;
 
-#ifdef AK89xx_SECONDARY
-    setup_compass();
-    if (mpu_set_compass_sample_rate(10))
-        return -1;
-#else
-    /* Already disabled by setup_compass. */
-    if (mpu_set_bypass(0))
-        return -1;
-#endif
+    if (HAS_COMPASS) {
+        setup_compass();
+        if (mpu_set_compass_sample_rate(10))
+            return -1;
+    } else {
+        /* Already disabled by setup_compass. */
+        if (mpu_set_bypass(0))
+            return -1;
+    }
 
     mpu_set_sensors(0);
     return 0;
@@ -825,25 +861,25 @@ int mpu_lp_accel_mode(unsigned short rate)
      * Any register read will clear the interrupt.
      */
     mpu_set_int_latched(1);
-#if defined MPU6050
+    if (!IS_6500) {
     tmp[0] = BIT_LPA_CYCLE;
     if (rate == 1) {
-        tmp[1] = INV_LPA_1_25HZ;
+        tmp[1] = INV_6050_LPA_1_25HZ;
         mpu_set_lpf(5);
     } else if (rate <= 5) {
-        tmp[1] = INV_LPA_5HZ;
+        tmp[1] = INV_6050_LPA_5HZ;
         mpu_set_lpf(5);
     } else if (rate <= 20) {
-        tmp[1] = INV_LPA_20HZ;
+        tmp[1] = INV_6050_LPA_20HZ;
         mpu_set_lpf(10);
     } else {
-        tmp[1] = INV_LPA_40HZ;
+        tmp[1] = INV_6050_LPA_40HZ;
         mpu_set_lpf(20);
     }
     tmp[1] = (tmp[1] << 6) | BIT_STBY_XYZG;
     if (i2c_write(st.hw->addr, st.reg->pwr_mgmt_1, 2, tmp))
         return -1;
-#elif defined MPU6500
+    } else {
     /* Set wake frequency. */
     if (rate == 1)
         tmp[0] = INV_LPA_1_25HZ;
@@ -870,7 +906,7 @@ int mpu_lp_accel_mode(unsigned short rate)
     tmp[0] = BIT_LPA_CYCLE;
     if (i2c_write(st.hw->addr, st.reg->pwr_mgmt_1, 1, tmp))
         return -1;
-#endif
+    }
     st.chip_cfg.sensors = INV_XYZ_ACCEL;
     st.chip_cfg.clk_src = 0;
     st.chip_cfg.lp_accel_mode = 1;
@@ -945,7 +981,7 @@ int mpu_get_temperature(long *data, unsigned long *timestamp)
     if (timestamp)
         get_ms(timestamp);
 
-    data[0] = (long)((35 + ((raw - (float)st.hw->temp_offset) / st.hw->temp_sens)) * 65536L);
+    data[0] = (long)((st.hw->temp_base + ((raw - (float)st.hw->temp_offset) / st.hw->temp_sens)) * 65536L);
     return 0;
 }
 
@@ -1424,9 +1460,8 @@ int mpu_set_sample_rate(unsigned short rate)
 
         st.chip_cfg.sample_rate = 1000 / (1 + data);
 
-#ifdef AK89xx_SECONDARY
-        mpu_set_compass_sample_rate(min(st.chip_cfg.compass_sample_rate, MAX_COMPASS_SAMPLE_RATE));
-#endif
+        if (HAS_COMPASS)
+            mpu_set_compass_sample_rate(min(st.chip_cfg.compass_sample_rate, MAX_COMPASS_SAMPLE_RATE));
 
         /* Automatically set LPF to 1/2 sampling rate. */
         mpu_set_lpf(st.chip_cfg.sample_rate >> 1);
@@ -1441,13 +1476,12 @@ int mpu_set_sample_rate(unsigned short rate)
  */
 int mpu_get_compass_sample_rate(unsigned short *rate)
 {
-#ifdef AK89xx_SECONDARY
+    if (!HAS_COMPASS) {
+        rate[0] = 0;
+        return -1;
+    }
     rate[0] = st.chip_cfg.compass_sample_rate;
     return 0;
-#else
-    rate[0] = 0;
-    return -1;
-#endif
 }
 
 /**
@@ -1463,8 +1497,9 @@ int mpu_get_compass_sample_rate(unsigned short *rate)
  */
 int mpu_set_compass_sample_rate(unsigned short rate)
 {
-#ifdef AK89xx_SECONDARY
     unsigned char div;
+    if (!HAS_COMPASS)
+        return -1;
     if (!rate || rate > st.chip_cfg.sample_rate || rate > MAX_COMPASS_SAMPLE_RATE)
         return -1;
 
@@ -1473,9 +1508,6 @@ int mpu_set_compass_sample_rate(unsigned short rate)
         return -1;
     st.chip_cfg.compass_sample_rate = st.chip_cfg.sample_rate / (div + 1);
     return 0;
-#else
-    return -1;
-#endif
 }
 
 /**
@@ -1620,9 +1652,7 @@ int mpu_get_power_state(unsigned char *power_on)
 int mpu_set_sensors(unsigned char sensors)
 {
     unsigned char data;
-#ifdef AK89xx_SECONDARY
     unsigned char user_ctrl;
-#endif
 
     if (sensors & INV_XYZ_GYRO)
         data = INV_CLK_PLL;
@@ -1654,7 +1684,7 @@ int mpu_set_sensors(unsigned char sensors)
         /* Latched interrupts only used in LP accel mode. */
         mpu_set_int_latched(0);
 
-#ifdef AK89xx_SECONDARY
+    if (HAS_COMPASS) {
 #ifdef AK89xx_BYPASS
     if (sensors & INV_XYZ_COMPASS)
         mpu_set_bypass(1);
@@ -1681,7 +1711,7 @@ int mpu_set_sensors(unsigned char sensors)
     if (i2c_write(st.hw->addr, st.reg->user_ctrl, 1, &user_ctrl))
         return -1;
 #endif
-#endif
+    }
 
     st.chip_cfg.sensors = sensors;
     st.chip_cfg.lp_accel_mode = 0;
@@ -1837,6 +1867,64 @@ int mpu_read_fifo_stream(unsigned short length, unsigned char *data,
     return 0;
 }
 
+/**
+ *  @brief      Get several unparsed packets from the FIFO.
+ *  Like mpu_read_fifo_stream, but reads every pending packet up to
+ *  @e max_packets after a single FIFO count read. The packets are read in as
+ *  few I2C transfers as the 255-byte transfer limit allows.
+ *  \n The overflow bit is checked on every call, a FIFO that has overflowed
+ *  is reset and -2 is returned.
+ *  @param[in]  length      Length of one packet.
+ *  @param[in]  max_packets Number of packets @e data can hold.
+ *  @param[out] data        FIFO packets, oldest first.
+ *  @param[out] packets     Number of packets read.
+ *  @param[out] more        Number of packets left in the FIFO.
+ *  @return     0 if successful, -2 if the FIFO overflowed.
+ */
+int mpu_read_fifo_stream_batch(unsigned short length, unsigned short max_packets,
+    unsigned char *data, unsigned short *packets, unsigned short *more)
+{
+    unsigned char tmp[2];
+    unsigned short fifo_count, total, chunk, ii;
+
+    packets[0] = 0;
+    more[0] = 0;
+    if (!st.chip_cfg.dmp_on)
+        return -1;
+    if (!st.chip_cfg.sensors)
+        return -1;
+    if (!length || length > 255)
+        return -1;
+
+    if (i2c_read(st.hw->addr, st.reg->int_status, 1, tmp))
+        return -1;
+    if (tmp[0] & BIT_FIFO_OVERFLOW) {
+        mpu_reset_fifo();
+        return -2;
+    }
+    if (i2c_read(st.hw->addr, st.reg->fifo_count_h, 2, tmp))
+        return -1;
+    fifo_count = (tmp[0] << 8) | tmp[1];
+    if (fifo_count >= st.hw->max_fifo) {
+        /* Full FIFO, the overflow bit is set by the next write. */
+        mpu_reset_fifo();
+        return -2;
+    }
+
+    total = min(fifo_count / length, max_packets);
+    chunk = 255 / length;
+    for (ii = 0; ii < total; ii += chunk) {
+        if (chunk > total - ii)
+            chunk = total - ii;
+        if (i2c_read(st.hw->addr, st.reg->fifo_r_w, chunk * length,
+                data + ii * length))
+            return -1;
+        packets[0] = ii + chunk;
+    }
+    more[0] = fifo_count / length - total;
+    return 0;
+}
+
 /**
  *  @brief      Set device to bypass mode.
  *  @param[in]  bypass_on   1 to enable bypass mode.
@@ -1924,7 +2012,6 @@ int mpu_set_int_latched(unsigned char enable)
     return 0;
 }
 
-#ifdef MPU6050
 static int get_accel_prod_shift(float *st_shift)
 {
     unsigned char tmp[4], shift_code[3], ii;
@@ -1960,10 +2047,10 @@ static int accel_self_test(long *bias_regular, long *bias_st)
         st_shift_cust = labs(bias_regular[jj] - bias_st[jj]) / 65536.f;
         if (st_shift[jj]) {
             st_shift_var = st_shift_cust / st_shift[jj] - 1.f;
-            if (fabs(st_shift_var) > test.max_accel_var)
+            if (fabs(st_shift_var) > st.test->max_accel_var)
                 result |= 1 << jj;
-        } else if ((st_shift_cust < test.min_g) ||
-            (st_shift_cust > test.max_g))
+        } else if ((st_shift_cust < st.test->min_g) ||
+            (st_shift_cust > st.test->max_g))
             result |= 1 << jj;
     }
 
@@ -1986,21 +2073,19 @@ static int gyro_self_test(long *bias_regular, long *bias_st)
     for (jj = 0; jj < 3; jj++) {
         st_shift_cust = labs(bias_regular[jj] - bias_st[jj]) / 65536.f;
         if (tmp[jj]) {
-            st_shift = 3275.f / test.gyro_sens;
+            st_shift = 3275.f / st.test->gyro_sens;
             while (--tmp[jj])
                 st_shift *= 1.046f;
             st_shift_var = st_shift_cust / st_shift - 1.f;
-            if (fabs(st_shift_var) > test.max_gyro_var)
+            if (fabs(st_shift_var) > st.test->max_gyro_var)
                 result |= 1 << jj;
-        } else if ((st_shift_cust < test.min_dps) ||
-            (st_shift_cust > test.max_dps))
+        } else if ((st_shift_cust < st.test->min_dps) ||
+            (st_shift_cust > st.test->max_dps))
             result |= 1 << jj;
     }
     return result;
 }
 
-#endif 
-#ifdef AK89xx_SECONDARY
 static int compass_self_test(void)
 {
     unsigned char tmp[6];
@@ -2034,17 +2119,6 @@ static int compass_self_test(void)
         goto AKM_restore;
 
     result = 0;
-#if defined MPU9150
-    data = (short)(tmp[1] << 8) | tmp[0];
-    if ((data > 100) || (data < -100))
-        result |= 0x01;
-    data = (short)(tmp[3] << 8) | tmp[2];
-    if ((data > 100) || (data < -100))
-        result |= 0x02;
-    data = (short)(tmp[5] << 8) | tmp[4];
-    if ((data > -300) || (data < -1000))
-        result |= 0x04;
-#elif defined MPU9250
     data = (short)(tmp[1] << 8) | tmp[0];
     if ((data > 200) || (data < -200))  
         result |= 0x01;
@@ -2054,7 +2128,6 @@ static int compass_self_test(void)
     data = (short)(tmp[5] << 8) | tmp[4];
     if ((data > -800) || (data < -3200))  
         result |= 0x04;
-#endif
 AKM_restore:
     tmp[0] = 0 | SUPPORTS_AK89xx_HIGH_SENS;
     i2c_write(st.chip_cfg.compass_addr, AKM_REG_ASTC, 1, tmp);
@@ -2063,7 +2136,6 @@ AKM_restore:
     mpu_set_bypass(0);
     return result;
 }
-#endif
 
 static int get_st_biases(long *gyro, long *accel, unsigned char hw_test)
 {
@@ -2107,13 +2179,13 @@ static int get_st_biases(long *gyro, long *accel, unsigned char hw_test)
     if (hw_test)
         data[0] = st.test->reg_accel_fsr | 0xE0;
     else
-        data[0] = test.reg_accel_fsr;
+        data[0] = st.test->reg_accel_fsr;
     if (i2c_write(st.hw->addr, st.reg->accel_cfg, 1, data))
         return -1;
     if (hw_test)
         delay_ms(200);
 
-    /* Fill FIFO for test.wait_ms milliseconds. */
+    /* Fill FIFO for st.test->wait_ms milliseconds. */
     data[0] = BIT_FIFO_EN;
     if (i2c_write(st.hw->addr, st.reg->user_ctrl, 1, data))
         return -1;
@@ -2121,7 +2193,7 @@ static int get_st_biases(long *gyro, long *accel, unsigned char hw_test)
     data[0] = INV_XYZ_GYRO | INV_XYZ_ACCEL;
     if (i2c_write(st.hw->addr, st.reg->fifo_en, 1, data))
         return -1;
-    delay_ms(test.wait_ms);
+    delay_ms(st.test->wait_ms);
     data[0] = 0;
     if (i2c_write(st.hw->addr, st.reg->fifo_en, 1, data))
         return -1;
@@ -2152,28 +2224,28 @@ static int get_st_biases(long *gyro, long *accel, unsigned char hw_test)
         gyro[2] += (long)gyro_cur[2];
     }
 #ifdef EMPL_NO_64BIT
-    gyro[0] = (long)(((float)gyro[0]*65536.f) / test.gyro_sens / packet_count);
-    gyro[1] = (long)(((float)gyro[1]*65536.f) / test.gyro_sens / packet_count);
-    gyro[2] = (long)(((float)gyro[2]*65536.f) / test.gyro_sens / packet_count);
+    gyro[0] = (long)(((float)gyro[0]*65536.f) / st.test->gyro_sens / packet_count);
+    gyro[1] = (long)(((float)gyro[1]*65536.f) / st.test->gyro_sens / packet_count);
+    gyro[2] = (long)(((float)gyro[2]*65536.f) / st.test->gyro_sens / packet_count);
     if (has_accel) {
-        accel[0] = (long)(((float)accel[0]*65536.f) / test.accel_sens /
+        accel[0] = (long)(((float)accel[0]*65536.f) / st.test->accel_sens /
             packet_count);
-        accel[1] = (long)(((float)accel[1]*65536.f) / test.accel_sens /
+        accel[1] = (long)(((float)accel[1]*65536.f) / st.test->accel_sens /
             packet_count);
-        accel[2] = (long)(((float)accel[2]*65536.f) / test.accel_sens /
+        accel[2] = (long)(((float)accel[2]*65536.f) / st.test->accel_sens /
             packet_count);
         /* Don't remove gravity! */
         accel[2] -= 65536L;
     }
 #else
-    gyro[0] = (long)(((long long)gyro[0]<<16) / test.gyro_sens / packet_count);
-    gyro[1] = (long)(((long long)gyro[1]<<16) / test.gyro_sens / packet_count);
-    gyro[2] = (long)(((long long)gyro[2]<<16) / test.gyro_sens / packet_count);
-    accel[0] = (long)(((long long)accel[0]<<16) / test.accel_sens /
+    gyro[0] = (long)(((long long)gyro[0]<<16) / st.test->gyro_sens / packet_count);
+    gyro[1] = (long)(((long long)gyro[1]<<16) / st.test->gyro_sens / packet_count);
+    gyro[2] = (long)(((long long)gyro[2]<<16) / st.test->gyro_sens / packet_count);
+    accel[0] = (long)(((long long)accel[0]<<16) / st.test->accel_sens /
         packet_count);
-    accel[1] = (long)(((long long)accel[1]<<16) / test.accel_sens /
+    accel[1] = (long)(((long long)accel[1]<<16) / st.test->accel_sens /
         packet_count);
-    accel[2] = (long)(((long long)accel[2]<<16) / test.accel_sens /
+    accel[2] = (long)(((long long)accel[2]<<16) / st.test->accel_sens /
         packet_count);
     /* Don't remove gravity! */
     if (accel[2] > 0L)
@@ -2185,7 +2257,6 @@ static int get_st_biases(long *gyro, long *accel, unsigned char hw_test)
     return 0;
 }
 
-#ifdef MPU6500
 #define REG_6500_XG_ST_DATA     0x0
 #define REG_6500_XA_ST_DATA     0xD
 static const unsigned short mpu_6500_st_tb[256] = {
@@ -2239,7 +2310,7 @@ static int accel_6500_self_test(long *bias_regular, long *bias_st, int debug)
 		if (regs[i] != 0) {
 			ct_shift_prod[i] = mpu_6500_st_tb[regs[i] - 1];
 			ct_shift_prod[i] *= 65536.f;
-			ct_shift_prod[i] /= test.accel_sens;
+			ct_shift_prod[i] /= st.test->accel_sens;
 		}
 		else {
 			ct_shift_prod[i] = 0;
@@ -2262,9 +2333,9 @@ static int accel_6500_self_test(long *bias_regular, long *bias_st, int debug)
 
 			if(debug)
 				log_i("ratio=%7.4f, threshold=%7.4f\r\n", st_shift_ratio[i]/1.f,
-							test.max_accel_var/1.f);
+							st.test->max_accel_var/1.f);
 
-			if (fabs(st_shift_ratio[i]) > test.max_accel_var) {
+			if (fabs(st_shift_ratio[i]) > st.test->max_accel_var) {
 				if(debug)
 					log_i("ACCEL Fail Axis = %d\n", i);
 				result |= 1 << i;	//Error condition
@@ -2273,8 +2344,8 @@ static int accel_6500_self_test(long *bias_regular, long *bias_st, int debug)
 	}
 	else {
 		/* Self Test Pass/Fail Criteria B */
-		accel_st_al_min = test.min_g * 65536.f;
-		accel_st_al_max = test.max_g * 65536.f;
+		accel_st_al_min = st.test->min_g * 65536.f;
+		accel_st_al_max = st.test->max_g * 65536.f;
 
 		if(debug) {
 			log_i("ACCEL:CRITERIA B\r\n");
@@ -2297,7 +2368,7 @@ static int accel_6500_self_test(long *bias_regular, long *bias_st, int debug)
 
 	if(result == 0) {
 	/* Self Test Pass/Fail Criteria C */
-		accel_offset_max = test.max_g_offset * 65536.f;
+		accel_offset_max = st.test->max_g_offset * 65536.f;
 		if(debug)
 			log_i("Accel:CRITERIA C: bias less than %7.4f\n", accel_offset_max/1.f);
 		for (i = 0; i < 3; i++) {
@@ -2332,7 +2403,7 @@ static int gyro_6500_self_test(long *bias_regular, long *bias_st, int debug)
 		if (regs[i] != 0) {
 			ct_shift_prod[i] = mpu_6500_st_tb[regs[i] - 1];
 			ct_shift_prod[i] *= 65536.f;
-			ct_shift_prod[i] /= test.gyro_sens;
+			ct_shift_prod[i] /= st.test->gyro_sens;
 		}
 		else {
 			ct_shift_prod[i] = 0;
@@ -2358,9 +2429,9 @@ static int gyro_6500_self_test(long *bias_regular, long *bias_st, int debug)
 
 			if(debug)
 				log_i("ratio=%7.4f, threshold=%7.4f\r\n", st_shift_ratio[i]/1.f,
-							test.max_gyro_var/1.f);
+							st.test->max_gyro_var/1.f);
 
-			if (fabs(st_shift_ratio[i]) < test.max_gyro_var) {
+			if (fabs(st_shift_ratio[i]) < st.test->max_gyro_var) {
 				if(debug)
 					log_i("Gyro Fail Axis = %d\n", i);
 				result |= 1 << i;	//Error condition
@@ -2369,7 +2440,7 @@ static int gyro_6500_self_test(long *bias_regular, long *bias_st, int debug)
 	}
 	else {
 		/* Self Test Pass/Fail Criteria B */
-		gyro_st_al_max = test.max_dps * 65536.f;
+		gyro_st_al_max = st.test->max_dps * 65536.f;
 
 		if(debug) {
 			log_i("GYRO:CRITERIA B\r\n");
@@ -2391,7 +2462,7 @@ static int gyro_6500_self_test(long *bias_regular, long *bias_st, int debug)
 
 	if(result == 0) {
 	/* Self Test Pass/Fail Criteria C */
-		gyro_offset_max = test.min_dps * 65536.f;
+		gyro_offset_max = st.test->min_dps * 65536.f;
 		if(debug)
 			log_i("Gyro:CRITERIA C: bias less than %7.4f\n", gyro_offset_max/1.f);
 		for (i = 0; i < 3; i++) {
@@ -2448,11 +2519,11 @@ static int get_st_6500_biases(long *gyro, long *accel, unsigned char hw_test, in
     if (hw_test)
         data[0] = st.test->reg_accel_fsr | 0xE0;
     else
-        data[0] = test.reg_accel_fsr;
+        data[0] = st.test->reg_accel_fsr;
     if (i2c_write(st.hw->addr, st.reg->accel_cfg, 1, data))
         return -1;
 
-    delay_ms(test.wait_ms);  //wait 200ms for sensors to stabilize
+    delay_ms(st.test->wait_ms);  //wait 200ms for sensors to stabilize
 
     /* Enable FIFO */
     data[0] = BIT_FIFO_EN;
@@ -2470,14 +2541,14 @@ static int get_st_6500_biases(long *gyro, long *accel, unsigned char hw_test, in
     	log_i("Starting Bias Loop Reads\n");
 
     //start reading samples
-    while (s < test.packet_thresh) {
-    	delay_ms(test.sample_wait_ms); //wait 10ms to fill FIFO
+    while (s < st.test->packet_thresh) {
+    	delay_ms(st.test->sample_wait_ms); //wait 10ms to fill FIFO
 		if (i2c_read(st.hw->addr, st.reg->fifo_count_h, 2, data))
 			return -1;
 		fifo_count = (data[0] << 8) | data[1];
 		packet_count = fifo_count / MAX_PACKET_LENGTH;
-		if ((test.packet_thresh - s) < packet_count)
-		            packet_count = test.packet_thresh - s;
+		if ((st.test->packet_thresh - s) < packet_count)
+		            packet_count = st.test->packet_thresh - s;
 		read_size = packet_count * MAX_PACKET_LENGTH;
 
 		//burst read from FIFO
@@ -2511,12 +2582,12 @@ static int get_st_6500_biases(long *gyro, long *accel, unsigned char hw_test, in
     if (i2c_write(st.hw->addr, st.reg->fifo_en, 1, data))
         return -1;
 
-    gyro[0] = (long)(((long long)gyro[0]<<16) / test.gyro_sens / s);
-    gyro[1] = (long)(((long long)gyro[1]<<16) / test.gyro_sens / s);
-    gyro[2] = (long)(((long long)gyro[2]<<16) / test.gyro_sens / s);
-    accel[0] = (long)(((long long)accel[0]<<16) / test.accel_sens / s);
-    accel[1] = (long)(((long long)accel[1]<<16) / test.accel_sens / s);
-    accel[2] = (long)(((long long)accel[2]<<16) / test.accel_sens / s);
+    gyro[0] = (long)(((long long)gyro[0]<<16) / st.test->gyro_sens / s);
+    gyro[1] = (long)(((long long)gyro[1]<<16) / st.test->gyro_sens / s);
+    gyro[2] = (long)(((long long)gyro[2]<<16) / st.test->gyro_sens / s);
+    accel[0] = (long)(((long long)accel[0]<<16) / st.test->accel_sens / s);
+    accel[1] = (long)(((long long)accel[1]<<16) / st.test->accel_sens / s);
+    accel[2] = (long)(((long long)accel[2]<<16) / st.test->accel_sens / s);
     /* remove gravity from bias calculation */
     if (accel[2] > 0L)
         accel[2] -= 65536L;
@@ -2552,9 +2623,7 @@ int mpu_run_6500_self_test(long *gyro, long *accel, unsigned char debug)
     const unsigned char tries = 2;
     long gyro_st[3], accel_st[3];
     unsigned char accel_result, gyro_result;
-#ifdef AK89xx_SECONDARY
     unsigned char compass_result;
-#endif
     int ii;
 
     int result;
@@ -2628,15 +2697,14 @@ int mpu_run_6500_self_test(long *gyro, long *accel, unsigned char debug)
     if (!accel_result)
         result |= 0x02;
 
-#ifdef AK89xx_SECONDARY
-    compass_result = compass_self_test();
-    if(debug)
-    	log_i("Compass Self Test Results: %d\n", compass_result);
-    if (!compass_result)
+    if (HAS_COMPASS) {
+        compass_result = compass_self_test();
+        if(debug)
+            log_i("Compass Self Test Results: %d\n", compass_result);
+        if (!compass_result)
+            result |= 0x04;
+    } else
         result |= 0x04;
-#else
-    result |= 0x04;
-#endif
 restore:
 	if(debug)
 		log_i("Exiting HWST\n");
@@ -2660,7 +2728,6 @@ restore:
 
 	return result;
 }
-#endif
  /*
  *  \n This function must be called with the device either face-up or face-down
  *  (z-axis is parallel to gravity).
@@ -2670,15 +2737,11 @@ restore:
  */
 int mpu_run_self_test(long *gyro, long *accel)
 {
-#ifdef MPU6050
     const unsigned char tries = 2;
     long gyro_st[3], accel_st[3];
     unsigned char accel_result, gyro_result;
-#ifdef AK89xx_SECONDARY
     unsigned char compass_result;
-#endif
     int ii;
-#endif
     int result;
     unsigned char accel_fsr, fifo_sensors, sensors_on;
     unsigned short gyro_fsr, sample_rate, lpf;
@@ -2698,8 +2761,15 @@ int mpu_run_self_test(long *gyro, long *accel)
     sensors_on = st.chip_cfg.sensors;
     mpu_get_fifo_config(&fifo_sensors);
 
+    if (IS_6500) {
+        /* For now, this function will return a "pass" result for all three sensors
+         * for compatibility with current test applications.
+         */
+        get_st_biases(gyro, accel, 0);
+        result = 0x7;
+        goto restore;
+    }
     /* For older chips, the self-test will be different. */
-#if defined MPU6050
     for (ii = 0; ii < tries; ii++)
         if (!get_st_biases(gyro, accel, 0))
             break;
@@ -2727,21 +2797,13 @@ int mpu_run_self_test(long *gyro, long *accel)
     if (!accel_result)
         result |= 0x02;
 
-#ifdef AK89xx_SECONDARY
-    compass_result = compass_self_test();
-    if (!compass_result)
-        result |= 0x04;
-#else
+    if (HAS_COMPASS) {
+        compass_result = compass_self_test();
+        if (!compass_result)
+            result |= 0x04;
+    } else
         result |= 0x04;
-#endif
 restore:
-#elif defined MPU6500
-    /* For now, this function will return a "pass" result for all three sensors
-     * for compatibility with current test applications.
-     */
-    get_st_biases(gyro, accel, 0);
-    result = 0x7;
-#endif
     /* Set to invalid values to ensure no I2C writes are skipped. */
     st.chip_cfg.gyro_fsr = 0xFF;
     st.chip_cfg.accel_fsr = 0xFF;
@@ -2923,7 +2985,6 @@ int mpu_get_dmp_state(unsigned char *enabled)
     return 0;
 }
 
-#ifdef AK89xx_SECONDARY
 /* This initialization is similar to the one in ak8975.c. */
 static int setup_compass(void)
 {
@@ -3016,16 +3077,8 @@ static int setup_compass(void)
     if (i2c_write(st.hw->addr, st.reg->i2c_delay_ctrl, 1, data))
         return -1;
 
-#ifdef MPU9150
-    /* For the MPU9150, the auxiliary I2C bus needs to be set to VDD. */
-    data[0] = BIT_I2C_MST_VDDIO;
-    if (i2c_write(st.hw->addr, st.reg->yg_offs_tc, 1, data))
-        return -1;
-#endif
-
     return 0;
 }
-#endif
 
 /**
  *  @brief      Read raw compass data.
@@ -3035,10 +3088,9 @@ static int setup_compass(void)
  */
 int mpu_get_compass_reg(short *data, unsigned long *timestamp)
 {
-#ifdef AK89xx_SECONDARY
     unsigned char tmp[9];
 
-    if (!(st.chip_cfg.sensors & INV_XYZ_COMPASS))
+    if (!HAS_COMPASS || !(st.chip_cfg.sensors & INV_XYZ_COMPASS))
         return -1;
 
 #ifdef AK89xx_BYPASS
@@ -3052,19 +3104,11 @@ int mpu_get_compass_reg(short *data, unsigned long *timestamp)
         return -1;
 #endif
 
-#if defined AK8975_SECONDARY
-    /* AK8975 doesn't have the overrun error bit. */
-    if (!(tmp[0] & AKM_DATA_READY))
-        return -2;
-    if ((tmp[7] & AKM_OVERFLOW) || (tmp[7] & AKM_DATA_ERROR))
-        return -3;
-#elif defined AK8963_SECONDARY
     /* AK8963 doesn't have the data read error bit. */
     if (!(tmp[0] & AKM_DATA_READY) || (tmp[0] & AKM_DATA_OVERRUN))
         return -2;
     if (tmp[7] & AKM_OVERFLOW)
         return -3;
-#endif
     data[0] = (tmp[2] << 8) | tmp[1];
     data[1] = (tmp[4] << 8) | tmp[3];
     data[2] = (tmp[6] << 8) | tmp[5];
@@ -3076,9 +3120,6 @@ int mpu_get_compass_reg(short *data, unsigned long *timestamp)
     if (timestamp)
         get_ms(timestamp);
     return 0;
-#else
-    return -1;
-#endif
 }
 
 /**
@@ -3088,12 +3129,27 @@ int mpu_get_compass_reg(short *data, unsigned long *timestamp)
  */
 int mpu_get_compass_fsr(unsigned short *fsr)
 {
-#ifdef AK89xx_SECONDARY
+    if (!HAS_COMPASS)
+        return -1;
     fsr[0] = st.hw->compass_fsr;
     return 0;
-#else
-    return -1;
-#endif
+}
+
+/**
+ *  @brief      Get the compass sensitivity adjustment.
+ *  Raw compass data read from EXT_SENS_DATA is scaled by (adj * data) >> 8,
+ *  as mpu_get_compass_reg does.
+ *  @param[out] adj     Adjustment of each axis, from the fuse ROM plus 128.
+ *  @return     0 if successful.
+ */
+int mpu_get_compass_sens_adj(short *adj)
+{
+    if (!HAS_COMPASS)
+        return -1;
+    adj[0] = st.chip_cfg.mag_sens_adj[0];
+    adj[1] = st.chip_cfg.mag_sens_adj[1];
+    adj[2] = st.chip_cfg.mag_sens_adj[2];
+    return 0;
 }
 
 /**
@@ -3137,14 +3193,10 @@ int mpu_get_compass_fsr(unsigned short *fsr)
 int mpu_lp_motion_interrupt(unsigned short thresh, unsigned char time,
     unsigned short lpa_freq)
 {
-
-#if defined MPU6500
     unsigned char data[3];
-#endif
-    if (lpa_freq) {
-#if defined MPU6500
-    	unsigned char thresh_hw;
+    unsigned char thresh_hw;
 
+    if (lpa_freq) {
         /* 1LSb = 4mg. */
         if (thresh > 1020)
             thresh_hw = 255;
@@ -3152,19 +3204,16 @@ int mpu_lp_motion_interrupt(unsigned short thresh, unsigned char time,
             thresh_hw = 1;
         else
             thresh_hw = thresh >> 2;
-#endif
 
         if (!time)
             /* Minimum duration must be 1ms. */
             time = 1;
 
-#if defined MPU6500
-        if (lpa_freq > 640)
+        if (IS_6500 && lpa_freq > 640)
             /* At this point, the chip has not been re-configured, so the
              * function can safely exit.
              */
             return -1;
-#endif
 
         if (!st.chip_cfg.int_motion_only) {
             /* Store current settings for later. */
@@ -3181,7 +3230,9 @@ int mpu_lp_motion_interrupt(unsigned short thresh, unsigned char time,
             mpu_get_fifo_config(&st.chip_cfg.cache.fifo_sensors);
         }
 
-#if defined MPU6500
+        if (!IS_6500)
+            goto lp_int_restore;
+
         /* Disable hardware interrupts. */
         set_int_enable(0);
 
@@ -3238,7 +3289,6 @@ int mpu_lp_motion_interrupt(unsigned short thresh, unsigned char time,
 
         st.chip_cfg.int_motion_only = 1;
         return 0;
-#endif
     } else {
         /* Don't "restore" the previous state if no state has been saved. */
         unsigned int ii;
@@ -3269,12 +3319,12 @@ lp_int_restore:
     if (st.chip_cfg.cache.dmp_on)
         mpu_set_dmp_state(1);
 
-#ifdef MPU6500
-    /* Disable motion interrupt (MPU6500 version). */
-    data[0] = 0;
-    if (i2c_write(st.hw->addr, st.reg->accel_intel, 1, data))
-        goto lp_int_restore;
-#endif
+    if (IS_6500) {
+        /* Disable motion interrupt (MPU6500 version). */
+        data[0] = 0;
+        if (i2c_write(st.hw->addr, st.reg->accel_intel, 1, data))
+            goto lp_int_restore;
+    }
 
     st.chip_cfg.int_motion_only = 0;
     return 0;
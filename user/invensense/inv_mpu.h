@@ -11,10 +11,9 @@
  *  @{
  *      @file       inv_mpu.h
  *      @brief      An I2C-based driver for Invensense gyroscopes.
- *      @details    This driver currently works for the following devices:
+ *      @details    This driver currently works for the following devices,
+ *                  selected at run time with mpu_select_chip:
  *                  MPU6050
- *                  MPU6500
- *                  MPU9150 (or MPU6050 w/ AK8975 on the auxiliary bus)
  *                  MPU9250 (or MPU6500 w/ AK8963 on the auxiliary bus)
  */
 
@@ -22,7 +21,25 @@
 #define _INV_MPU_H_
 
 #define EMPL_TARGET_STM32F4
-#define MPU9250
+
+/* Chips built into the driver, 1 to include and 0 to leave out. Leaving out
+ * the chip a board does not use drops its descriptor and register tables, and
+ * with a single chip the run time chip checks become constants, so the
+ * compiler also drops the self-test and compass code of the other chip.
+ * To measure it, add MPU_CHIP_9250=0 (or MPU_CHIP_6050=0) to the C/C++ defines
+ * in Keil and compare the inv_mpu.o row of the Image component sizes in
+ * obj/mwlib.map, or with GCC from the repository root:
+ *     arm-none-eabi-gcc -mcpu=cortex-m4 -mthumb -mfloat-abi=hard -mfpu=fpv4-sp-d16
+ *         -Os -DSTM32F40_41xxx -DUSE_STDPERIPH_DRIVER -DARM_MATH_CM4 -DMPU_CHIP_9250=0
+ *         -Iuser -Ifwlib -Icore -Iuser/invensense -c user/invensense/inv_mpu.c
+ *     arm-none-eabi-size inv_mpu.o
+ */
+#ifndef MPU_CHIP_6050
+#define MPU_CHIP_6050   (1)
+#endif
+#ifndef MPU_CHIP_9250
+#define MPU_CHIP_9250   (1)
+#endif
 
 #define INV_X_GYRO      (0x40)
 #define INV_Y_GYRO      (0x20)
@@ -61,7 +78,17 @@ struct int_param_s {
 #define MPU_INT_STATUS_DMP_4            (0x1000)
 #define MPU_INT_STATUS_DMP_5            (0x2000)
 
+/* Chip descriptors, pass one to mpu_select_chip before mpu_init. */
+struct mpu_chip_s;
+#if MPU_CHIP_6050
+extern const struct mpu_chip_s mpu_chip_6050;
+#endif
+#if MPU_CHIP_9250
+extern const struct mpu_chip_s mpu_chip_9250;
+#endif
+
 /* Set up APIs */
+int mpu_select_chip(const struct mpu_chip_s *chip);
 int mpu_init(void);
 int mpu_init_slave(void);
 int mpu_set_bypass(unsigned char bypass_on);
@@ -86,6 +113,7 @@ int mpu_get_accel_fsr(unsigned char *fsr);
 int mpu_set_accel_fsr(unsigned char fsr);
 
 int mpu_get_compass_fsr(unsigned short *fsr);
+int mpu_get_compass_sens_adj(short *adj);
 
 int mpu_get_gyro_sens(float *sens);
 int mpu_get_accel_sens(unsigned short *sens);
@@ -118,6 +146,8 @@ int mpu_read_fifo(short *gyro, short *accel, unsigned long *timestamp,
     unsigned char *sensors, unsigned char *more);
 int mpu_read_fifo_stream(unsigned short length, unsigned char *data,
     unsigned char *more);
+int mpu_read_fifo_stream_batch(unsigned short length, unsigned short max_packets,
+    unsigned char *data, unsigned short *packets, unsigned short *more);
 int mpu_reset_fifo(void);
 
 int mpu_write_mem(unsigned short mem_addr, unsigned short length,
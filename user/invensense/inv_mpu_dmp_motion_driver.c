@@ -1242,29 +1242,17 @@ int dmp_set_interrupt_mode(unsigned char mode)
 }
 
 /**
- *  @brief      Get one packet from the FIFO.
- *  If @e sensors does not contain a particular sensor, disregard the data
- *  returned to that pointer.
- *  \n @e sensors can contain a combination of the following flags:
- *  \n INV_X_GYRO, INV_Y_GYRO, INV_Z_GYRO
- *  \n INV_XYZ_GYRO
- *  \n INV_XYZ_ACCEL
- *  \n INV_WXYZ_QUAT
- *  \n If the FIFO has no new data, @e sensors will be zero.
- *  \n If the FIFO is disabled, @e sensors will be zero and this function will
- *  return a non-zero error code.
+ *  @brief      Parse one DMP packet.
+ *  @param[in]  fifo_data   Packet read from the FIFO.
  *  @param[out] gyro        Gyro data in hardware units.
  *  @param[out] accel       Accel data in hardware units.
  *  @param[out] quat        3-axis quaternion data in hardware units.
- *  @param[out] timestamp   Timestamp in milliseconds.
- *  @param[out] sensors     Mask of sensors read from FIFO.
- *  @param[out] more        Number of remaining packets.
- *  @return     0 if successful.
+ *  @param[out] sensors     Mask of sensors in the packet.
+ *  @return     0 if successful, -1 if the packet is corrupted.
  */
-int dmp_read_fifo(short *gyro, short *accel, long *quat,
-    unsigned long *timestamp, short *sensors, unsigned char *more)
+static int parse_packet(unsigned char *fifo_data, short *gyro, short *accel,
+    long *quat, short *sensors)
 {
-    unsigned char fifo_data[MAX_PACKET_LENGTH];
     unsigned char ii = 0;
 
     /* TODO: sensors[0] only changes when dmp_enable_feature is called. We can
@@ -1272,10 +1260,6 @@ int dmp_read_fifo(short *gyro, short *accel, long *quat,
      */
     sensors[0] = 0;
 
-    /* Get a packet. */
-    if (mpu_read_fifo_stream(dmp.packet_length, fifo_data, more))
-        return -1;
-
     /* Parse DMP packet. */
     if (dmp.feature_mask & (DMP_FEATURE_LP_QUAT | DMP_FEATURE_6X_LP_QUAT)) {
 #ifdef FIFO_CORRUPTION_CHECK
@@ -1308,7 +1292,6 @@ int dmp_read_fifo(short *gyro, short *accel, long *quat,
         if ((quat_mag_sq < QUAT_MAG_SQ_MIN) ||
             (quat_mag_sq > QUAT_MAG_SQ_MAX)) {
             /* Quaternion is outside of the acceptable threshold. */
-            mpu_reset_fifo();
             sensors[0] = 0;
             return -1;
         }
@@ -1337,11 +1320,98 @@ int dmp_read_fifo(short *gyro, short *accel, long *quat,
      */
     if (dmp.feature_mask & (DMP_FEATURE_TAP | DMP_FEATURE_ANDROID_ORIENT))
         decode_gesture(fifo_data + ii);
+    return 0;
+}
+
+/**
+ *  @brief      Get one packet from the FIFO.
+ *  If @e sensors does not contain a particular sensor, disregard the data
+ *  returned to that pointer.
+ *  \n @e sensors can contain a combination of the following flags:
+ *  \n INV_X_GYRO, INV_Y_GYRO, INV_Z_GYRO
+ *  \n INV_XYZ_GYRO
+ *  \n INV_XYZ_ACCEL
+ *  \n INV_WXYZ_QUAT
+ *  \n If the FIFO has no new data, @e sensors will be zero.
+ *  \n If the FIFO is disabled, @e sensors will be zero and this function will
+ *  return a non-zero error code.
+ *  @param[out] gyro        Gyro data in hardware units.
+ *  @param[out] accel       Accel data in hardware units.
+ *  @param[out] quat        3-axis quaternion data in hardware units.
+ *  @param[out] timestamp   Timestamp in milliseconds.
+ *  @param[out] sensors     Mask of sensors read from FIFO.
+ *  @param[out] more        Number of remaining packets.
+ *  @return     0 if successful.
+ */
+int dmp_read_fifo(short *gyro, short *accel, long *quat,
+    unsigned long *timestamp, short *sensors, unsigned char *more)
+{
+    unsigned char fifo_data[MAX_PACKET_LENGTH];
+
+    sensors[0] = 0;
+
+    /* Get a packet. */
+    if (mpu_read_fifo_stream(dmp.packet_length, fifo_data, more))
+        return -1;
+
+    if (parse_packet(fifo_data, gyro, accel, quat, sensors)) {
+        mpu_reset_fifo();
+        return -1;
+    }
 
     get_ms(timestamp);
     return 0;
 }
 
+/**
+ *  @brief      Get every pending packet from the FIFO, up to @e max_packets.
+ *  The FIFO count is read once and the packets are read in bursts, which
+ *  empties the FIFO in far less bus time than calling dmp_read_fifo once per
+ *  packet. Intended to be called from the MPU interrupt.
+ *  \n Packets are returned oldest first, element @e ii of each array holds
+ *  packet @e ii. @e sensors is the same for all packets.
+ *  \n An overflowed FIFO is reset and -2 is returned, the packets it held
+ *  are lost. A corrupted packet also resets the FIFO, the packets before it
+ *  are still returned along with -1.
+ *  @param[out] gyro        Gyro data in hardware units.
+ *  @param[out] accel       Accel data in hardware units.
+ *  @param[out] quat        3-axis quaternion data in hardware units.
+ *  @param[out] sensors     Mask of sensors read from FIFO.
+ *  @param[in]  max_packets Number of elements of each array, at most
+ *                          DMP_MAX_BATCH.
+ *  @param[out] packets     Number of packets read.
+ *  @param[out] more        Number of packets left in the FIFO.
+ *  @return     0 if successful.
+ */
+int dmp_read_fifo_batch(short (*gyro)[3], short (*accel)[3], long (*quat)[4],
+    short *sensors, unsigned short max_packets, unsigned short *packets,
+    unsigned short *more)
+{
+    static unsigned char fifo_data[DMP_MAX_BATCH * MAX_PACKET_LENGTH];
+    unsigned short count, ii;
+    short mask;
+    int result;
+
+    sensors[0] = 0;
+    packets[0] = 0;
+    if (max_packets > DMP_MAX_BATCH)
+        max_packets = DMP_MAX_BATCH;
+
+    result = mpu_read_fifo_stream_batch(dmp.packet_length, max_packets,
+        fifo_data, &count, more);
+    for (ii = 0; ii < count; ii++) {
+        if (parse_packet(fifo_data + ii * dmp.packet_length, gyro[ii],
+                accel[ii], quat[ii], &mask)) {
+            mpu_reset_fifo();
+            more[0] = 0;
+            return -1;
+        }
+        sensors[0] = mask;
+        packets[0] = ii + 1;
+    }
+    return result;
+}
+
 /**
  *  @brief      Register a function to be executed on a tap event.
  *  The tap direction is represented by one of the following:
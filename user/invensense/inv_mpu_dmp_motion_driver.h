@@ -92,6 +92,11 @@ int dmp_enable_gyro_cal(unsigned char enable);
  */
 int dmp_read_fifo(short *gyro, short *accel, long *quat,
     unsigned long *timestamp, short *sensors, unsigned char *more);
+/* Burst version, reads every pending packet in one go. */
+#define DMP_MAX_BATCH   (16)
+int dmp_read_fifo_batch(short (*gyro)[3], short (*accel)[3], long (*quat)[4],
+    short *sensors, unsigned short max_packets, unsigned short *packets,
+    unsigned short *more);
 
 #endif  /* #ifndef _INV_MPU_DMP_MOTION_DRIVER_H_ */
 
@@ -30,6 +30,7 @@ void RefreshHandler(int32_t position, EC11_DirectionTypedef direction)
   OledHandle.stringY = 0;
   OledHandle.stringClear = ENABLE;
   OLED_DisplayFormat(&OledHandle, "pos=%d,dir=%d", position, direction);
+  OLED_Flush();
 }
 
 /**
@@ -42,6 +43,7 @@ void KeyHandler()
   OledHandle.stringY = 4;
   OledHandle.stringClear = ENABLE;
   OLED_DisplayFormat(&OledHandle, "pressed=%d", ++count);
+  OLED_Flush();
 }
 #endif
 
@@ -1,17 +1,21 @@
 /**
  * @file    mpu6050.c
  * @author  Miaow
- * @version 0.1.2
+ * @version 0.7.0
  * @date    2018/08/31
  * @brief
  *          This file provides functions to manage the following
  *          functionalities of mpu6050:
  *              1. Initialization and setup
  *              2. Get raw data from gyroscope, accelerometer and thermometer
- *              3. DMP operations
+ *              3. DMP operations, samples drained in the interrupt into a ring buffer
+ *              4. Cache configuration registers, skip writes that change nothing
+ *              5. Timestamped samples from one burst read or batches from the FIFO
+ *              6. Attitude fusion on the MCU from raw data, without DMP
+ *              7. Self-test biases kept in the internal flash across power cycles
  * @note
  *          Minimum version of header file:
- *              0.1.0
+ *              0.6.0
  *          Pin connection:
  *               
  *               PB8SCL  XDAX
@@ -33,6 +37,9 @@
 #include "arm_math.h"
 #include "inv_mpu.h"
 #include "inv_mpu_dmp_motion_driver.h" 
+#include "bsp_iic_cache.h"
+#include "bsp_iic_sched.h"
+#include "flashkv.h"
  /**
   * @brief Ĵ
   */
@@ -99,8 +106,10 @@
 #define MPU6050_REG_FIFO_RW			      0X74 //!< FIFOдĴ
 #define MPU6050_REG_DEVICE_ID		      0X75 //!< IDĴ
 
-#define MPU6050_Q30                   1073741824.0 //!<q30ʽ
+#define MPU6050_Q30                   1073741824.0f //!<q30ʽ
 #define MPU6050_Q16                   65536.0 //!< q16ʽ
+#define MPU6050_SAMPLE_SIZE           14 //!< ٶȡ¶ȡһݵֽ, ĴFIFO˳ͬ
+#define MPU6050_FIFO_BATCH            18 //!< һδFIFOȡ, IIC_ReadRegBytesĳ
 
   /**
    * @brief Ƿ
@@ -109,6 +118,30 @@ static int8_t MPU6050_GyroOrientation[9] = { 1, 0, 0,
                                              0, 1, 0,
                                              0, 0, 1 };
 static MPU6050_DataArrivalHandler __dataArrivalHandler = NULL; //!< ⲿжϻص
+static IIC_SCHED_DeviceTypedef mpu6050Device = IIC_SCHED_DEVICE(MPU6050_ADDR, 1, 0); //!< FIFOȡ, ϲ, FIFO_RWᵯ
+static uint8_t mpu6050Registers[0x20]; //!< 0X19~0X38üĴĻ, Լ仯״̬ݺʹ㸴λλļĴ
+static IIC_CACHE_DeviceTypedef mpu6050Cache = IIC_CACHE_DEVICE(NULL, MPU6050_ADDR, 1, MPU6050_REG_SAMPLE_RATE, 0x20, mpu6050Registers);
+static uint8_t mpu6050PwrMgmt2; //!< 0X6CĴĻ, USER_CTRLPWR_MGMT1ĸλλ, ֱд
+static IIC_CACHE_DeviceTypedef mpu6050PwrCache = IIC_CACHE_DEVICE(NULL, MPU6050_ADDR, 1, MPU6050_REG_PWR_MGMT2, 1, &mpu6050PwrMgmt2);
+static uint8_t fifoBuffer[MPU6050_FIFO_BATCH * MPU6050_SAMPLE_SIZE];
+static AHRS_InfoTypeDef mpu6050Ahrs; //!< ̬ںϵ״̬
+static uint8_t fusionMode = 0; //!< 1-ⲿж̬ں; 0-ⲿжжDMP
+static uint32_t lastTimestamp; //!< һںʱ
+static float quaternion[4] = { 1.0f, 0.0f, 0.0f, 0.0f }; //!< һε̬
+static MPU6050_DmpSampleTypedef dmpRing[MPU6050_DMP_RING_SIZE]; //!< DMPλ
+static volatile uint16_t dmpRingHead = 0; //!< дλ, ֻⲿж޸
+static volatile uint16_t dmpRingTail = 0; //!< ȡλ, ֻMPU6050_ReadDmpSamples޸
+static volatile MPU6050_DmpStatusTypedef dmpStatus; //!< λļ
+
+#define MPU6050_BIAS_VERSION    1 //!< MPU6050_BiasTypedefĸʽ汾, ޸Ľṹʱ1
+
+/**
+ * @brief ڲflashеƫ, ѰDMPĸʽ
+ */
+typedef struct {
+  long gyro[3];
+  long accel[3];
+}MPU6050_BiasTypedef;
 
 /**
  * @brief 
@@ -117,7 +150,7 @@ static MPU6050_DataArrivalHandler __dataArrivalHandler = NULL; //!< 
  */
 uint8_t MPU6050_SetGyroFsr(MPU6050_GyroFsrTypedef fsr)
 {
-  return IIC_WriteRegByte(MPU6050_ADDR, MPU6050_REG_GYRO_CFG, fsr << 3);//̷Χ  
+  return IIC_CACHE_Write(&mpu6050Cache, MPU6050_REG_GYRO_CFG, fsr << 3);//̷Χ  
 }
 
 /**
@@ -127,22 +160,21 @@ uint8_t MPU6050_SetGyroFsr(MPU6050_GyroFsrTypedef fsr)
  */
 uint8_t MPU6050_SetAccelFsr(MPU6050_AccelFsrTypedef fsr)
 {
-  return IIC_WriteRegByte(MPU6050_ADDR, MPU6050_REG_ACCEL_CFG, fsr << 3);//üٶȴ̷Χ  
+  return IIC_CACHE_Write(&mpu6050Cache, MPU6050_REG_ACCEL_CFG, fsr << 3);//üٶȴ̷Χ  
 }
 
 /**
- * @brief ò(ٶFs=1KHz)
+ * @brief ݴʺֵͨ˲(ٶFs=1KHz)
  * @param rate 4~1000Hz
  * @return 0-ɹ; 1-ʧ
  */
-uint8_t MPU6050_SetSampleRate(uint16_t rate)
+static uint8_t MPU6050_StageSampleRate(uint16_t rate)
 {
   uint16_t lpf = rate >> 1;
   MPU6050_LpfTypedef data;
   if (rate > 1000 || rate < 4)
     return 1;
-  if (IIC_WriteRegByte(MPU6050_ADDR, MPU6050_REG_SAMPLE_RATE, 1000 / rate - 1))    //ֵͨ˲
-    return 1;
+  IIC_CACHE_Stage(&mpu6050Cache, MPU6050_REG_SAMPLE_RATE, 1000 / rate - 1);    //òƵʷƵ
   if (lpf >= 188)
     data = MPU6050_FILTER_188HZ;
   else if (lpf >= 98)
@@ -155,7 +187,21 @@ uint8_t MPU6050_SetSampleRate(uint16_t rate)
     data = MPU6050_FILTER_10HZ;
   else
     data = MPU6050_FILTER_5HZ;
-  return MPU6050_SetLPF(data);//LPFΪʵһ
+  IIC_CACHE_Stage(&mpu6050Cache, MPU6050_REG_CFG, data);//LPFΪʵһ
+  return 0;
+}
+
+/**
+ * @brief ò(ٶFs=1KHz)
+ * @param rate 4~1000Hz
+ * @return 0-ɹ; 1-ʧ
+ * @note ƵLPF, һд
+ */
+uint8_t MPU6050_SetSampleRate(uint16_t rate)
+{
+  if (MPU6050_StageSampleRate(rate))
+    return 1;
+  return IIC_CACHE_Flush(&mpu6050Cache);
 }
 
 /**
@@ -165,7 +211,7 @@ uint8_t MPU6050_SetSampleRate(uint16_t rate)
  */
 uint8_t MPU6050_SetLPF(MPU6050_LpfTypedef lpf)
 {
-  return IIC_WriteRegByte(MPU6050_ADDR, MPU6050_REG_CFG, lpf);//ֵͨ˲  
+  return IIC_CACHE_Write(&mpu6050Cache, MPU6050_REG_CFG, lpf);//ֵͨ˲  
 }
 
 /**
@@ -173,22 +219,34 @@ uint8_t MPU6050_SetLPF(MPU6050_LpfTypedef lpf)
  * @return 0-ɹ; 1-ʧ
  * @note ǡ2000dps, ٶȴ2g, 50Hz,
  *       жϹ, I2Cģʽ, FIFO, INTЧ, Xʱ
+ *       λĴΪ֪Ĭֵ, ֻдĬֵͬļĴ, ڵļĴһд
  */
 uint8_t MPU6050_Init()
 {
-  IIC_Init();//ʼIIC
-  IIC_WriteRegByte(MPU6050_ADDR, MPU6050_REG_PWR_MGMT1, 0X80);//λMPU6050
-  UTILS_DelayMs(100);
+  uint8_t reg, reset;
+  IIC_SCHED_Init();//FIFOĶȡ
+  UTILS_InitCycleCounter();//ʱ
+  IIC_CACHE_Invalidate(&mpu6050Cache);
+  IIC_CACHE_Invalidate(&mpu6050PwrCache);
+  reset = IIC_WriteRegByte(MPU6050_ADDR, MPU6050_REG_PWR_MGMT1, 0X80);//λMPU6050
+  UTILS_DelayMs(100);//λɺĴĬֵ
+  if (!reset)
+  {
+    for (reg = MPU6050_REG_SAMPLE_RATE; reg <= MPU6050_REG_INT_EN; reg++)
+      IIC_CACHE_Preset(&mpu6050Cache, reg, 0X00);//λPWR_MGMT1ⶼ0
+    IIC_CACHE_Preset(&mpu6050PwrCache, MPU6050_REG_PWR_MGMT2, 0X00);
+  }
   IIC_WriteRegByte(MPU6050_ADDR, MPU6050_REG_PWR_MGMT1, 0X00);//MPU6050 
-  MPU6050_SetGyroFsr(MPU6050_FSR_2000DPS);//ǡ2000dps
-  MPU6050_SetAccelFsr(MPU6050_FSR_2G);//ٶȴ2g
-  MPU6050_SetSampleRate(MPU6050_SAMPLE_RATE);//ò
-  IIC_WriteRegByte(MPU6050_ADDR, MPU6050_REG_INT_EN, 0X00);//رж
+  IIC_CACHE_Stage(&mpu6050Cache, MPU6050_REG_GYRO_CFG, MPU6050_FSR_2000DPS << 3);//ǡ2000dps
+  IIC_CACHE_Stage(&mpu6050Cache, MPU6050_REG_ACCEL_CFG, MPU6050_FSR_2G << 3);//ٶȴ2g
+  MPU6050_StageSampleRate(MPU6050_SAMPLE_RATE);//ò
+  IIC_CACHE_Stage(&mpu6050Cache, MPU6050_REG_INT_EN, 0X00);//رж
+  IIC_CACHE_Stage(&mpu6050Cache, MPU6050_REG_FIFO_EN, 0X00);//رFIFO
+  IIC_CACHE_Stage(&mpu6050Cache, MPU6050_REG_INTBP_CFG, 0X80);//INTŵ͵ƽЧ
+  IIC_CACHE_Flush(&mpu6050Cache);
   IIC_WriteRegByte(MPU6050_ADDR, MPU6050_REG_USER_CTRL, 0X00);//I2Cģʽر
-  IIC_WriteRegByte(MPU6050_ADDR, MPU6050_REG_FIFO_EN, 0X00);//رFIFO
-  IIC_WriteRegByte(MPU6050_ADDR, MPU6050_REG_INTBP_CFG, 0X80);//INTŵ͵ƽЧ
   IIC_WriteRegByte(MPU6050_ADDR, MPU6050_REG_PWR_MGMT1, 0X01);//CLKSEL XPLLΪο
-  IIC_WriteRegByte(MPU6050_ADDR, MPU6050_REG_PWR_MGMT2, 0X00);//ٶǶ
+  IIC_CACHE_Write(&mpu6050PwrCache, MPU6050_REG_PWR_MGMT2, 0X00);//ٶǶ
 
   return IIC_ReadRegByte(MPU6050_ADDR, MPU6050_REG_DEVICE_ID) != MPU6050_ADDR;
 }
@@ -227,6 +285,115 @@ uint8_t MPU6050_GetGyroscope(int16_t * gx, int16_t * gy, int16_t * gz)
   return 1;
 }
 
+/**
+ * @brief ǰȡûϵ
+ * @param accelScale ٶȼÿLSBӦg
+ * @param gyroScale ÿLSBӦdps
+ * @note ̴ӼĴж, Чʱ
+ */
+static void MPU6050_GetScales(float *accelScale, float *gyroScale)
+{
+  uint8_t accelCfg = 0, gyroCfg = 0;
+  IIC_CACHE_Read(&mpu6050Cache, MPU6050_REG_ACCEL_CFG, &accelCfg);
+  IIC_CACHE_Read(&mpu6050Cache, MPU6050_REG_GYRO_CFG, &gyroCfg);
+  *accelScale = (float)(2 << ((accelCfg >> 3) & 3)) / 32768.0f;
+  *gyroScale = (float)(250 << ((gyroCfg >> 3) & 3)) / 32768.0f;
+}
+
+/**
+ * @brief 0X3B~0X48˳14ֽתΪ
+ */
+static void MPU6050_DecodeSample(const uint8_t *data, MPU6050_SampleTypedef *sample, float accelScale, float gyroScale)
+{
+  uint8_t i;
+  for (i = 0; i < 3; i++)
+  {
+    sample->accelRaw[i] = ((uint16_t)data[2 * i] << 8) | data[2 * i + 1];
+    sample->gyroRaw[i] = ((uint16_t)data[8 + 2 * i] << 8) | data[9 + 2 * i];
+    sample->accel[i] = sample->accelRaw[i] * accelScale;
+    sample->gyro[i] = sample->gyroRaw[i] * gyroScale;
+  }
+  sample->temperatureRaw = ((uint16_t)data[6] << 8) | data[7];
+  sample->temperature = 36.53f + (float)sample->temperatureRaw / 340.0f;
+}
+
+/**
+ * @brief һ0X3B~0X48, õͬһʱ̵ļٶȡ¶Ⱥ
+ * @param sample , ʱ޸
+ * @return 0-ɹ; 1-ʧ
+ */
+uint8_t MPU6050_ReadSample(MPU6050_SampleTypedef *sample)
+{
+  uint8_t data[MPU6050_SAMPLE_SIZE];
+  float accelScale, gyroScale;
+  uint32_t timestamp = UTILS_GetCycleCount();
+  if (IIC_SCHED_ReadRegBytes(&mpu6050Device, MPU6050_REG_ACCEL_XOUTH, MPU6050_SAMPLE_SIZE, data))
+    return 1;
+  MPU6050_GetScales(&accelScale, &gyroScale);
+  MPU6050_DecodeSample(data, sample, accelScale, gyroScale);
+  sample->timestamp = timestamp;
+  return 0;
+}
+
+/**
+ * @brief FIFO, ʼÿβļٶȡ¶ȺдFIFO
+ * @return 0-ɹ; 1-ʧ
+ * @note ʹDMPʱЧ,  @ref MPU6050_SetSampleRate .
+ *       FIFOΪ1024ֽ, ɴ73, 1kHzʱÿ70msһ @ref MPU6050_ReadFifo
+ */
+uint8_t MPU6050_StartFifo()
+{
+  if (IIC_WriteRegByte(MPU6050_ADDR, MPU6050_REG_USER_CTRL, 0X00))//رFIFO
+    return 1;
+  if (IIC_WriteRegByte(MPU6050_ADDR, MPU6050_REG_USER_CTRL, 0X04))//λFIFO, λԶ
+    return 1;
+  if (IIC_CACHE_Write(&mpu6050Cache, MPU6050_REG_FIFO_EN, 0XF8))//¶, XYZ, ٶ
+    return 1;
+  return IIC_WriteRegByte(MPU6050_ADDR, MPU6050_REG_USER_CTRL, 0X40);//ʹFIFO
+}
+
+/**
+ * @brief FIFOе, MPU6050_FIFO_BATCHһδ
+ * @param samples , Ӿɵ
+ * @param maxCount samplesĳ
+ * @return ; FIFOʱݲٶ, λFIFO0
+ * @note µʱΪFIFOȵʱ, ֮ǰİǰ
+ */
+uint16_t MPU6050_ReadFifo(MPU6050_SampleTypedef *samples, uint16_t maxCount)
+{
+  uint8_t data[2], div = 0, lpf = 0;
+  uint16_t total, count, n, i, done = 0;
+  float accelScale, gyroScale;
+  uint32_t timestamp = UTILS_GetCycleCount(), period;
+  if (IIC_SCHED_ReadRegBytes(&mpu6050Device, MPU6050_REG_FIFO_CNTH, 2, data))
+    return 0;
+  count = ((uint16_t)data[0] << 8) | data[1];
+  if (count >= 1024)
+  {
+    MPU6050_StartFifo();
+    return 0;
+  }
+  total = count / MPU6050_SAMPLE_SIZE;
+  count = total > maxCount ? maxCount : total;
+  MPU6050_GetScales(&accelScale, &gyroScale);
+  IIC_CACHE_Read(&mpu6050Cache, MPU6050_REG_SAMPLE_RATE, &div);
+  IIC_CACHE_Read(&mpu6050Cache, MPU6050_REG_CFG, &lpf);
+  lpf &= 0X07;
+  period = SystemCoreClock / (lpf == 0 || lpf == 7 ? 8000 : 1000) * (div + 1);//Ƶ8kHz1kHz
+  while (done < count)
+  {
+    n = count - done < MPU6050_FIFO_BATCH ? count - done : MPU6050_FIFO_BATCH;
+    if (IIC_SCHED_ReadRegBytes(&mpu6050Device, MPU6050_REG_FIFO_RW, n * MPU6050_SAMPLE_SIZE, fifoBuffer))
+      break;
+    for (i = 0; i < n; i++, done++)
+    {
+      MPU6050_DecodeSample(fifoBuffer + i * MPU6050_SAMPLE_SIZE, &samples[done], accelScale, gyroScale);
+      samples[done].timestamp = timestamp - (total - 1 - done) * period;//ɵ, FIFOе
+    }
+  }
+  return done;
+}
+
 /**
  * @brief ʼⲿж
  * @param irqHandler ⲿжϻص
@@ -292,34 +459,62 @@ uint8_t MPU6050_GetAccelerometer(int16_t * ax, int16_t * ay, int16_t * az)
 }
 
 /**
- * @brief MPU6050Բ
+ * @brief ƫдDMP
+ */
+static inline void MPU6050_SetDmpBias(MPU6050_BiasTypedef *bias)
+{
+  dmp_set_gyro_bias(bias->gyro);
+  dmp_set_accel_bias(bias->accel);
+}
+
+/**
+ * @brief MPU6050Բ, ƫдDMP浽ڲflash
  * @return 0-ɹ; 1-ʧ
  */
 static inline uint8_t MPU6050_RunSelfTest()
 {
   int32_t result;
-  long gyro[3], accel[3];
-  result = mpu_run_self_test(gyro, accel);
+  MPU6050_BiasTypedef bias;
+  result = mpu_run_self_test(bias.gyro, bias.accel);
   if ((result & 0x03) == 0x03)
   {
     float sens;
     uint16_t accel_sens;
     mpu_get_gyro_sens(&sens);
-    gyro[0] = (long)(gyro[0] * sens);
-    gyro[1] = (long)(gyro[1] * sens);
-    gyro[2] = (long)(gyro[2] * sens);
-    dmp_set_gyro_bias(gyro);
+    bias.gyro[0] = (long)(bias.gyro[0] * sens);
+    bias.gyro[1] = (long)(bias.gyro[1] * sens);
+    bias.gyro[2] = (long)(bias.gyro[2] * sens);
     mpu_get_accel_sens(&accel_sens);
-    accel[0] *= accel_sens;
-    accel[1] *= accel_sens;
-    accel[2] *= accel_sens;
-    dmp_set_accel_bias(accel);
+    bias.accel[0] *= accel_sens;
+    bias.accel[1] *= accel_sens;
+    bias.accel[2] *= accel_sens;
+    MPU6050_SetDmpBias(&bias);
+#if MPU6050_STORE_BIAS
+    FLASHKV_Write(FLASHKV_KEY_MPU6050_BIAS, MPU6050_BIAS_VERSION, &bias, sizeof(bias));//ʧʱ´ϵԼ
+#endif
     return 0;
   }
   else
     return 1;
 }
 
+/**
+ * @brief ڲflashƫòдDMP
+ * @return 0-ɹ; 1-ûбƫ
+ */
+static inline uint8_t MPU6050_LoadBias()
+{
+#if MPU6050_STORE_BIAS
+  MPU6050_BiasTypedef bias;
+  if (FLASHKV_Read(FLASHKV_KEY_MPU6050_BIAS, MPU6050_BIAS_VERSION, &bias, sizeof(bias)))
+    return 1;
+  MPU6050_SetDmpBias(&bias);
+  return 0;
+#else
+  return 1;
+#endif
+}
+
 /**
  * @brief ת
  */
@@ -372,7 +567,14 @@ static inline uint16_t MPU6050_InvOrientationMatrix2Scalar(const int8_t * matrix
  */
 uint8_t MPU6050_InitWithDmp(MPU6050_DataArrivalHandler dataArrivalHandler)
 {
-  IIC_Init();//ʼIIC
+  fusionMode = 0;
+  dmpRingTail = dmpRingHead;
+  dmpStatus.received = dmpStatus.dropped = dmpStatus.overflows = dmpStatus.errors = 0;
+  IIC_SCHED_Init();//DMPĶд
+  UTILS_InitCycleCounter();//ʱ
+  IIC_CACHE_Invalidate(&mpu6050Cache);//mpu_*
+  IIC_CACHE_Invalidate(&mpu6050PwrCache);
+  mpu_select_chip(&mpu_chip_6050);//MPU9250user/invensenseµ
   if (!mpu_init())//ʼMPU6050
   {
     //ҪĴ
@@ -395,8 +597,8 @@ uint8_t MPU6050_InitWithDmp(MPU6050_DataArrivalHandler dataArrivalHandler)
     //DMP(󲻳200Hz)
     if (dmp_set_fifo_rate(MPU6050_FIFO_RATE))
       return 7;
-    //Լ
-    if (MPU6050_RunSelfTest())
+    //رƫ, ûʱԼ
+    if (MPU6050_LoadBias() && MPU6050_RunSelfTest())
       return 8;
     //ʹDMP
     if (mpu_set_dmp_state(1))
@@ -407,15 +609,42 @@ uint8_t MPU6050_InitWithDmp(MPU6050_DataArrivalHandler dataArrivalHandler)
 }
 
 /**
- * @brief õdmp
- * @param pitch , :0.1, Χ -90~90
- * @param pitch , :0.1, Χ -180~180
- * @param pitch , :0.1, Χ -180~180
+ * @brief Լ, DMPڲflashеƫ
+ * @return 0-ɹ; 1-ʧ
+ * @note MPU6050_InitWithDmp֮, MPU6050ˮƽֹ, оƬ;
+ *       Լڼⲿж, DMP FIFO
+ */
+uint8_t MPU6050_Recalibrate()
+{
+  uint8_t result;
+  if (fusionMode)
+    return 1;//ƫֻDMP
+  EXTI->IMR &= ~MPU6050_EXTI_LINE;//ⲿжҲҪIIC
+  result = MPU6050_RunSelfTest();
+  EXTI_ClearITPendingBit(MPU6050_EXTI_LINE);
+  EXTI->IMR |= MPU6050_EXTI_LINE;
+  return result;
+}
+
+/**
+ * @brief DMPq30ԪתΪ, Ϊһε̬
+ */
+static void MPU6050_SaveDmpQuat(const long* quat)
+{
+  quaternion[0] = quat[0] * (1.0f / MPU6050_Q30);	//q30ʽתΪ
+  quaternion[1] = quat[1] * (1.0f / MPU6050_Q30);
+  quaternion[2] = quat[2] * (1.0f / MPU6050_Q30);
+  quaternion[3] = quat[3] * (1.0f / MPU6050_Q30);
+}
+
+/**
+ * @brief DMPһq30ʽԪ, κλ
+ * @param q30 Ԫw, x, y, z, 2^30Ϊ
  * @return 0-ɹ; -ʧ
+ * @note  @ref MPU6050_GetDmpData һѯʽ
  */
-uint8_t MPU6050_GetDmpData(float* pitch, float* roll, float* yaw)
+uint8_t MPU6050_GetDmpQuaternion(int32_t q30[4])
 {
-  float q0 = 1.0f, q1 = 0.0f, q2 = 0.0f, q3 = 0.0f;
   unsigned long sensor_timestamp;
   int16_t gyro[3], accel[3], sensors;
   uint8_t more;
@@ -434,14 +663,187 @@ uint8_t MPU6050_GetDmpData(float* pitch, float* roll, float* yaw)
   **/
   if (!(sensors & INV_WXYZ_QUAT))
     return 2;
-  q0 = quat[0] / MPU6050_Q30;	//q30ʽתΪ
-  q1 = quat[1] / MPU6050_Q30;
-  q2 = quat[2] / MPU6050_Q30;
-  q3 = quat[3] / MPU6050_Q30;
-
-  *pitch = asinf(2.0f * q0 * q2 - 2.0f * q1 * q3) * 57.29577951308232286464772187173366546630859375f;
-  *roll = atan2f(2.0f * q2 * q3 + 2.0f * q0 * q1, 1.0f - 2.0f * q1 * q1 - 2.0f * q2 * q2) * 57.29577951308232286464772187173366546630859375f;
-  *yaw = atan2f(2.0f * q1 * q2 + 2.0f * q0 * q3, q0 * q0 + q1 * q1 - q2 * q2 - q3 * q3) * 57.29577951308232286464772187173366546630859375f;
+  MPU6050_SaveDmpQuat(quat);
+  q30[0] = quat[0];
+  q30[1] = quat[1];
+  q30[2] = quat[2];
+  q30[3] = quat[3];
+  return 0;
+}
+
+/**
+ * @brief õdmp
+ * @param pitch , 0.01, Χ -90~90
+ * @param pitch , 0.01, Χ -180~180
+ * @param pitch , 0.01, Χ -180~180
+ * @return 0-ɹ; -ʧ
+ * @note ÿδFIFOһݰ, ڲⲿжϵѯʽ.
+ *        @ref MPU6050_BeginReceive ⲿжϻFIFO, Ҫٵ,  @ref MPU6050_ReadDmpSamples
+ *       ŷAHRS_QuaternionToEulerȻ, Ҫŷʱ @ref MPU6050_GetDmpQuaternion
+ */
+uint8_t MPU6050_GetDmpData(float* pitch, float* roll, float* yaw)
+{
+  int32_t q30[4];
+  uint8_t result = MPU6050_GetDmpQuaternion(q30);
+  if (result)
+    return result;
+  AHRS_QuaternionToEuler(quaternion, pitch, roll, yaw);
+  return 0;
+}
+
+/**
+ * @brief DMP FIFO, д뻷λ, Ϊһε̬, ⲿже
+ * @return 0-ɹ; 1-ûж
+ * @note FIFOһ, ݰ. FIFOʱλFIFO.
+ *       λʱ, ȡ߲д.
+ */
+static uint8_t MPU6050_DrainDmp(void)
+{
+  static short gyro[DMP_MAX_BATCH][3], accel[DMP_MAX_BATCH][3];
+  static long quat[DMP_MAX_BATCH][4];
+  MPU6050_DmpSampleTypedef *sample;
+  short sensors;
+  uint16_t count, more, i, head;
+  uint32_t timestamp, period = SystemCoreClock / MPU6050_FIFO_RATE;
+  int result;
+  long* latest = NULL;
+  do
+  {
+    timestamp = UTILS_GetCycleCount();
+    result = dmp_read_fifo_batch(gyro, accel, quat, &sensors, DMP_MAX_BATCH, &count, &more);
+    if (result == -2)
+      dmpStatus.overflows++;
+    else if (result)
+      dmpStatus.errors++;
+    if (!(sensors & INV_WXYZ_QUAT))
+      count = 0;
+    head = dmpRingHead;
+    for (i = 0; i < count; i++)
+    {
+      if ((uint16_t)(head - dmpRingTail) >= MPU6050_DMP_RING_SIZE)
+      {
+        dmpStatus.dropped++;
+        continue;
+      }
+      sample = &dmpRing[head & (MPU6050_DMP_RING_SIZE - 1)];
+      sample->timestamp = timestamp - (count - 1 - i + more) * period;//FIFOԽǰԽ
+      sample->quat[0] = quat[i][0];
+      sample->quat[1] = quat[i][1];
+      sample->quat[2] = quat[i][2];
+      sample->quat[3] = quat[i][3];
+      sample->accel[0] = accel[i][0];
+      sample->accel[1] = accel[i][1];
+      sample->accel[2] = accel[i][2];
+      sample->gyro[0] = gyro[i][0];
+      sample->gyro[1] = gyro[i][1];
+      sample->gyro[2] = gyro[i][2];
+      head++;
+      dmpStatus.received++;
+    }
+    __DMB();//дƶдλ
+    dmpRingHead = head;
+    if (count > 0)
+      latest = quat[count - 1];
+  } while (result == 0 && count > 0 && more > 0);
+  if (latest == NULL)
+    return 1;
+  MPU6050_SaveDmpQuat(latest);
+  return 0;
+}
+
+/**
+ * @brief ӻλⲿжյDMP
+ * @param samples , ʱȺ
+ * @param maxCount samplesĳ
+ * @return 
+ * @note ֻһȡ, Ҫж
+ */
+uint16_t MPU6050_ReadDmpSamples(MPU6050_DmpSampleTypedef *samples, uint16_t maxCount)
+{
+  uint16_t tail = dmpRingTail, count = dmpRingHead - tail, i;
+  if (count > maxCount)
+    count = maxCount;
+  __DMB();//ȿдλ, ٶ
+  for (i = 0; i < count; i++)
+    samples[i] = dmpRing[(uint16_t)(tail + i) & (MPU6050_DMP_RING_SIZE - 1)];
+  __DMB();//ͷλ
+  dmpRingTail = tail + count;
+  return count;
+}
+
+/**
+ * @brief ȡDMPλļ
+ * @param status 
+ */
+void MPU6050_GetDmpStatus(MPU6050_DmpStatusTypedef *status)
+{
+  status->received = dmpStatus.received;
+  status->dropped = dmpStatus.dropped;
+  status->overflows = dmpStatus.overflows;
+  status->errors = dmpStatus.errors;
+}
+
+/**
+ * @brief ʹDMP, MCUںԭʼݵõ̬
+ * @param dataArrivalHandler ÿںϺĻص, ⲿже
+ * @return 0-ɹ; 1-ʧ
+ * @note MPU6050_FUSION_RATE, ǡ2000dps, ٶȡ2g, ݾʱINTߵƽ.
+ *       㷨MPU6050_FUSION_ALGORITHMѡ, ҪDMP̼.
+ *       ⲿж14ֽڲں, 400kHzʱԼ0.4ms.  @ref MPU6050_BeginReceive ʼ
+ */
+uint8_t MPU6050_InitWithFusion(MPU6050_DataArrivalHandler dataArrivalHandler)
+{
+  if (MPU6050_Init())
+    return 1;
+  fusionMode = 1;
+  lastTimestamp = 0;
+  AHRS_Init(&mpu6050Ahrs, MPU6050_FUSION_ALGORITHM);
+  IIC_CACHE_Stage(&mpu6050Cache, MPU6050_REG_INTBP_CFG, 0X10);//INTߵƽЧ, Ĵ
+  IIC_CACHE_Stage(&mpu6050Cache, MPU6050_REG_INT_EN, 0X01);//ݾж
+  if (MPU6050_StageSampleRate(MPU6050_FUSION_RATE) || IIC_CACHE_Flush(&mpu6050Cache))
+    return 1;
+  MPU6050_InitExti(dataArrivalHandler);
+  return 0;
+}
+
+/**
+ * @brief ȡһε̬Ԫ
+ * @param q Ԫw, x, y, z
+ * @note DMPMCUںַʽЧ
+ */
+void MPU6050_GetQuaternion(float q[4])
+{
+  q[0] = quaternion[0];
+  q[1] = quaternion[1];
+  q[2] = quaternion[2];
+  q[3] = quaternion[3];
+}
+
+/**
+ * @brief ȡһ̬ת
+ * @param r дŵ3x3, ѵϵתģϵ
+ * @note DMPMCUںַʽЧ
+ */
+void MPU6050_GetRotationMatrix(float r[9])
+{
+  AHRS_QuaternionToMatrix(quaternion, r);
+}
+
+/**
+ * @brief һں
+ * @return 0-ɹ; 1-ʧ
+ */
+static uint8_t MPU6050_GetFusionData(void)
+{
+  MPU6050_SampleTypedef sample;
+  float dt = 1.0f / MPU6050_FUSION_RATE;
+  if (MPU6050_ReadSample(&sample))
+    return 1;
+  if (lastTimestamp != 0)
+    dt = (float)(sample.timestamp - lastTimestamp) / SystemCoreClock;//жӳʱʵʼ
+  lastTimestamp = sample.timestamp;
+  AHRS_Update(&mpu6050Ahrs, sample.gyro, sample.accel, NULL, dt);
+  AHRS_GetQuaternion(&mpu6050Ahrs, quaternion);
   return 0;
 }
 
@@ -454,7 +856,11 @@ void MPU6050_EXTI_IRQHANDLER()
   {
     float pitch, roll, yaw;
     EXTI->PR = MPU6050_EXTI_LINE;
-    MPU6050_GetDmpData(&pitch, &roll, &yaw);
+    if (fusionMode ? MPU6050_GetFusionData() : MPU6050_DrainDmp())
+      return;
+    if (__dataArrivalHandler == NULL)
+      return;//ֻԪλʱŷ
+    AHRS_QuaternionToEuler(quaternion, &pitch, &roll, &yaw);
     __dataArrivalHandler(pitch, roll, yaw);
   }
 }
@@ -1,14 +1,17 @@
 /**
  * @file    mpu6050.c
  * @author  Miaow
- * @version 0.1.1
+ * @version 0.6.0
  * @date    2018/08/31
  * @brief   
  *          This file provides functions to manage the following 
  *          functionalities of mpu6050:
  *              1. Initialization and setup
  *              2. Get raw data from gyroscope, accelerometer and thermometer
- *              3. DMP operations
+ *              3. DMP operations, samples drained in the interrupt into a ring buffer
+ *              4. Timestamped samples from one burst read or batches from the FIFO
+ *              5. Attitude fusion on the MCU from raw data, without DMP
+ *              6. Self-test biases kept in the internal flash across power cycles
  * @note
  *          Pin connection:
  *               
@@ -33,6 +36,7 @@
 #include "bsp_iic.h"   												  	  
 #include "stm32f4xx.h"
 #include "utils.h"
+#include "ahrs.h"
 
 /**
  * @brief MPU6050INTźжض
@@ -52,6 +56,10 @@
 #define MPU6050_ADDR            0X68
 #define MPU6050_SAMPLE_RATE     200 //ʹDMPʱЧʹDMPʱ̶Ϊ200Hz
 #define MPU6050_FIFO_RATE       50
+#define MPU6050_DMP_RING_SIZE   32 //DMPλ, 2
+#define MPU6050_FUSION_RATE     1000 //MPU6050_InitWithFusionĲ, 4~1000Hz
+#define MPU6050_FUSION_ALGORITHM  AHRS_MAHONY //AHRS_MAHONYAHRS_MADGWICK
+#define MPU6050_STORE_BIAS      1 //1-Լõƫñڲflash, ϵʱֱӼ; 0-ÿϵԼ
 
 typedef enum {
     MPU6050_FSR_250DPS = 0,
@@ -78,6 +86,39 @@ typedef enum {
     MPU6050_FILTER_2100HZ_NOLPF
 }MPU6050_LpfTypedef;
 
+/**
+ * @brief ͬһʱ̵ļٶȡ¶Ⱥ
+ */
+typedef struct {
+    uint32_t timestamp;//ʱ(ںʱ), UTILS_GetCycleCount
+    int16_t accelRaw[3];//ٶȼXYZԭʼ
+    int16_t temperatureRaw;//¶ԭʼ
+    int16_t gyroRaw[3];//XYZԭʼ
+    float accel[3];//ٶ(g)
+    float temperature;//¶()
+    float gyro[3];//ٶ(dps)
+}MPU6050_SampleTypedef;
+
+/**
+ * @brief DMPһ
+ */
+typedef struct {
+    uint32_t timestamp;//ʱ(ںʱ), UTILS_GetCycleCount
+    int32_t quat[4];//Ԫw, x, y, z, q30ʽ
+    int16_t accel[3];//ٶȼԭʼ
+    int16_t gyro[3];//ԭʼ, DMPУ׼ƫ
+}MPU6050_DmpSampleTypedef;
+
+/**
+ * @brief DMPλļ, ֻⲿж
+ */
+typedef struct {
+    uint32_t received;//д뻷λ
+    uint32_t dropped;//λ
+    uint32_t overflows;//DMP FIFOλĴ, ÿζʧFIFOеȫ
+    uint32_t errors;//IICݰ𻵵Ĵ
+}MPU6050_DmpStatusTypedef;
+
 typedef void (*MPU6050_DataArrivalHandler)(float pitch, float roll, float yaw);
 
 uint8_t MPU6050_Init(void);
@@ -89,7 +130,17 @@ uint8_t MPU6050_SetLPF(MPU6050_LpfTypedef lpf);
 float MPU6050_GetTemperature(void);
 uint8_t MPU6050_GetGyroscope(int16_t *gx, int16_t *gy, int16_t *gz);
 uint8_t MPU6050_GetAccelerometer(int16_t *ax, int16_t *ay, int16_t *az);
+uint8_t MPU6050_ReadSample(MPU6050_SampleTypedef *sample);
+uint8_t MPU6050_StartFifo(void);
+uint16_t MPU6050_ReadFifo(MPU6050_SampleTypedef *samples, uint16_t maxCount);
 uint8_t MPU6050_InitWithDmp(MPU6050_DataArrivalHandler dataArrivalHandler);
 uint8_t MPU6050_GetDmpData(float *pitch, float *roll, float *yaw);
+uint8_t MPU6050_GetDmpQuaternion(int32_t q30[4]);
+uint8_t MPU6050_Recalibrate(void);
+uint16_t MPU6050_ReadDmpSamples(MPU6050_DmpSampleTypedef *samples, uint16_t maxCount);
+void MPU6050_GetDmpStatus(MPU6050_DmpStatusTypedef *status);
+uint8_t MPU6050_InitWithFusion(MPU6050_DataArrivalHandler dataArrivalHandler);
+void MPU6050_GetQuaternion(float q[4]);
+void MPU6050_GetRotationMatrix(float r[9]);
 
 #endif
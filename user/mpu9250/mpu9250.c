@@ -1,7 +1,7 @@
 /**
  * @file    mpu9250.c
  * @author  Miaow
- * @version 0.1.1
+ * @version 0.2.0
  * @date    2018/09/08
  * @brief   
  *          This file provides functions to manage the following 
@@ -9,9 +9,11 @@
  *              1. Initialization and setup
  *              2. Get raw data from gyroscope, accelerometer, magnetometer and thermometer
  *              3. DMP operations
+ *              4. 9-axis samples in one burst read, magnetometer fetched by the internal I2C master
+ *              5. 9-axis attitude fusion on the MCU, see ahrs.c
  * @note
  *          Minimum version of header file:
- *              0.1.1
+ *              0.2.0
  *          Recommanded pin connection:
  *               
  *               PB8SCL  XDAX
@@ -32,6 +34,8 @@
 #include "mpu9250.h"
 #include "inv_mpu.h"
 #include "inv_mpu_dmp_motion_driver.h" 
+#include "bsp_iic_sched.h"
+#include "ahrs.h"
 #include "math.h"
 #include "stdio.h"
 /**
@@ -142,6 +146,11 @@
 
 
 
+#define MPU9250_SAMPLE_SIZE         22      //ٶ6¶26, EXT_SENS_DATAAK8963ST16ST2
+#define AK8963_ST1_DRDY             0X01    //ST1: 
+#define AK8963_ST1_DOR              0X02    //ST1: ûͱ
+#define AK8963_ST2_HOFL             0X08    //ST2: ų
+
 //q30ʽ
 #define Q30  1073741824.0f
 //q16ʽ
@@ -156,6 +165,11 @@ static int8_t MPU9250_GyroOrientation[9] = { 1, 0, 0,
 
 static void MPU9250_InitExti(void (* irqHandler)(void));
 void (* MPU9250_IrqHandler)(void);//ⲿжϻص
+static int16_t compassAdjust[3] = {256, 256, 256};//AK8963У, Ժ8λ
+static int16_t lastCompass[3];//һЧĵ̶
+static AHRS_InfoTypeDef mpu9250Ahrs;//MCU̬ںϵ״̬
+static void (* fusionHandler)(void);//ںϺĻص
+static uint32_t lastTimestamp;//һںϵʱ
                                              
 /**
  * @brief 
@@ -272,22 +286,71 @@ static inline void MPU9250_InitExti(void (* irqHandler)(void))
 
 /**
  * @brief ʼ
- * @param irqHandler ⲿжϻص
+ * @param irqHandler ݾⲿжϻص, еMPU9250_ReadSample; NULL-ж
  * @return 0-ɹ; -1-ʧ
- * @note ǡ2000dps, ٶȴ2g, 100Hz, 
- *       жϹ, I2Cģʽ, FIFO, INTЧ, Xʱ
+ * @note ǡ2000dps, ٶȴ2g, MPU9250_SAMPLE_RATE, 
+ *       I2Cģʽ, SLV0ÿڰAK8963ST1~ST2EXT_SENS_DATA_00~07, SLV1һεβ,
+ *       100Hz, ⲿݶŲݾж, INTЧ, شⲿж, FIFO
  */
 inline int8_t MPU9250_Init(void (* irqHandler)(void))
 { 
     int8_t result;
-    IIC_Init();//ʼIIC
+    IIC_SCHED_Init();//mpu_*Ķд
+    UTILS_InitCycleCounter();//ʱ
+    mpu_select_chip(&mpu_chip_9250);//MPU6050user/invensenseµ
     result = (int8_t)(mpu_init() | 
-    mpu_set_sensors(INV_XYZ_GYRO | INV_XYZ_ACCEL | INV_XYZ_COMPASS) | 
-    mpu_set_sample_rate(MPU9250_SAMPLE_RATE));//ò
-    if(!result)
-        return 0;
-    else
+    mpu_set_sensors(INV_XYZ_GYRO | INV_XYZ_ACCEL | INV_XYZ_COMPASS) |//I2Cģʽ, ԶAK8963
+    mpu_set_sample_rate(MPU9250_SAMPLE_RATE) |//ò
+    mpu_set_compass_sample_rate(MPU9250_SAMPLE_RATE < 100 ? MPU9250_SAMPLE_RATE : 100) |//Ʋ
+    mpu_get_compass_sens_adj(compassAdjust));
+    //mpu_initsetup_compassĽ, ûҵAK8963ʱУֵΪ0, ȫΪ0
+    if(result || compassAdjust[0] < 128 || compassAdjust[1] < 128 || compassAdjust[2] < 128)
         return -1;
+    if(irqHandler != NULL)
+    {
+        if(IIC_WriteRegByte(MPU9250_ADDR, MPU9250_REG_INT_EN, 0X01))//ݾж
+            return -1;
+        MPU9250_InitExti(irqHandler);
+    }
+    return 0;
+}
+
+/**
+ * @brief һ22ֽ, õͬһʱ̵ļٶȡ¶ȡǺ͵
+ * @param sample 
+ * @return 0-ɹ; -1-ʧ
+ * @note ҪȵMPU9250_Init. ݾжеʱٶȡǶ.
+ *       ̱ȲųʱcompassUpdatedΪ0, compassһεЧֵ
+ */
+int8_t MPU9250_ReadSample(MPU9250_SampleTypedef *sample)
+{
+    uint8_t data[MPU9250_SAMPLE_SIZE];
+    uint8_t i;
+    int32_t value;
+    sample->timestamp = UTILS_GetCycleCount();
+    if(IIC_ReadRegBytes(MPU9250_ADDR, MPU9250_REG_ACCEL_XOUTH, MPU9250_SAMPLE_SIZE, data))
+        return -1;
+    for(i = 0; i < 3; i++)
+    {
+        sample->accel[i] = (int16_t)(((uint16_t)data[2 * i] << 8) | data[2 * i + 1]);
+        sample->gyro[i] = (int16_t)(((uint16_t)data[8 + 2 * i] << 8) | data[9 + 2 * i]);
+    }
+    sample->temperature = (int16_t)(((uint16_t)data[6] << 8) | data[7]);
+    //AK8963С, data[14]ST1, data[21]ST2
+    sample->compassUpdated = (data[14] & AK8963_ST1_DRDY) && !(data[21] & AK8963_ST2_HOFL);
+    if(sample->compassUpdated)
+    {
+        for(i = 0; i < 3; i++)
+        {
+            //H * ((ASA - 128) / 256 + 1), Уֵ383/256, ̸ᳬint16
+            value = ((int32_t)(int16_t)(((uint16_t)data[16 + 2 * i] << 8) | data[15 + 2 * i]) * compassAdjust[i]) >> 8;
+            lastCompass[i] = (int16_t)(value > 32767 ? 32767 : value < -32768 ? -32768 : value);
+        }
+    }
+    sample->compass[0] = lastCompass[0];
+    sample->compass[1] = lastCompass[1];
+    sample->compass[2] = lastCompass[2];
+    return 0;
 }
 
 /**
@@ -358,7 +421,7 @@ int8_t MPU9250_GetEulerFromCompass(float *yaw)
 {
     int16_t mx, my, mz;
     int8_t result = MPU9250_GetCompass(&mx, &my, &mz);
-    *yaw = atan((float)my /(float)mx) * 57.29578f;
+    *yaw = atanf((float)my /(float)mx) * 57.29578f;
     return result;
 }
 
@@ -443,9 +506,10 @@ static inline uint16_t MPU9250_OrientationMatrix2Scalar(const int8_t *matrix)
  */
 int8_t MPU9250_InitWithDmp(void (* irqHandler)(void))
 {
-	IIC_Init();//ʼIIC
+	IIC_SCHED_Init();//DMPĶд
     
     MPU9250_InitExti(irqHandler);
+    mpu_select_chip(&mpu_chip_9250);//MPU6050user/invensenseµ
 	if(!mpu_init())//ʼMPU9250
 	{
         //ҪĴ
@@ -472,49 +536,158 @@ int8_t MPU9250_InitWithDmp(void (* irqHandler)(void))
 		//ʹDMP
 		if(mpu_set_dmp_state(1))
             return 9;
+		//Ʋ, mpu_initĬֻ10Hz
+		if(mpu_set_compass_sample_rate(100))
+            return 10;
 	}
 	return 0;
 }
 
 /**
- * @brief õdmp
- * @param pitch , :0.1, Χ -90~90
- * @param pitch , :0.1, Χ -180~180
- * @param pitch , :0.1, Χ -180~180
+ * @brief DMPһq30ʽԪ, κλ
+ * @param q30 Ԫw, x, y, z, 2^30Ϊ
  * @return 0-ɹ; -ʧ
  */
-int8_t MPU9250_GetDmpData(float *pitch, float *roll, float *yaw)
+int8_t MPU9250_GetDmpQuaternion(int32_t q30[4])
 {
-	float q0 = 1.0f, q1 = 0.0f, q2 = 0.0f, q3 = 0.0f;
 	unsigned long sensor_timestamp;
 	int16_t gyro[3], accel[3], sensors;
 	uint8_t more;
 	long quat[4]; 
 	if(dmp_read_fifo(gyro, accel, quat, &sensor_timestamp, &sensors, &more))
         return 1;
-	/* Gyro and accel data are written to the FIFO by the DMP in chip frame and hardware units.
-	 * This behavior is convenient because it keeps the gyro and accel outputs of dmp_read_fifo and mpu_read_fifo consistent.
-	**/
-	/*if (sensors & INV_XYZ_GYRO )
-	send_packet(PACKET_TYPE_GYRO, gyro);
-	if (sensors & INV_XYZ_ACCEL)
-	send_packet(PACKET_TYPE_ACCEL, accel); */
 	/* Unlike gyro and accel, quaternions are written to the FIFO in the body frame, q30.
 	 * The orientation is set by the scalar passed to dmp_set_orientation during initialization. 
 	**/
 	if(!(sensors & INV_WXYZ_QUAT))
         return 2;
-    q0 = quat[0] / Q30;	//q30ʽתΪ
-    q1 = quat[1] / Q30;
-    q2 = quat[2] / Q30;
-    q3 = quat[3] / Q30; 
+    q30[0] = quat[0];
+    q30[1] = quat[1];
+    q30[2] = quat[2];
+    q30[3] = quat[3];
+	return 0;
+}
+
+/**
+ * @brief õdmp
+ * @param pitch , 0.01, Χ -90~90
+ * @param pitch , 0.01, Χ -180~180
+ * @param pitch , 0.01, Χ -180~180
+ * @return 0-ɹ; -ʧ
+ * @note ȫȸ, AHRS_QuaternionToEuler
+ */
+int8_t MPU9250_GetDmpData(float *pitch, float *roll, float *yaw)
+{
+	int32_t q30[4];
+	float q[4];
+	int8_t result = MPU9250_GetDmpQuaternion(q30);
+	if(result)
+        return result;
+    q[0] = q30[0] * (1.0f / Q30);	//q30ʽתΪ
+    q[1] = q30[1] * (1.0f / Q30);
+    q[2] = q30[2] * (1.0f / Q30);
+    q[3] = q30[3] * (1.0f / Q30);
     //õ//
-    *pitch = asin(2 * q0 * q2 - 2 * q1 * q3) * 57.3;// pitch
-    *roll = atan2(2 * q2 * q3 + 2 * q0 * q1, 1 - 2 * q1 * q1 - 2 * q2* q2) * 57.3;// roll
-    *yaw = atan2(2 * q1 * q2 + 2 * q0 * q3, q0 * q0 + q1 * q1 - q2 * q2 - q3 * q3) * 57.3;//yaw
+    AHRS_QuaternionToEuler(q, pitch, roll, yaw);
+	return 0;
+}
+
+/**
+ * @brief õdmpת
+ * @param r дŵ3x3, ѵϵתģϵ
+ * @return 0-ɹ; -ʧ
+ */
+int8_t MPU9250_GetDmpRotationMatrix(float r[9])
+{
+	int32_t q30[4];
+	float q[4];
+	int8_t result = MPU9250_GetDmpQuaternion(q30);
+	if(result)
+        return result;
+    q[0] = q30[0] * (1.0f / Q30);
+    q[1] = q30[1] * (1.0f / Q30);
+    q[2] = q30[2] * (1.0f / Q30);
+    q[3] = q30[3] * (1.0f / Q30);
+    AHRS_QuaternionToMatrix(q, r);
 	return 0;
 }
 
+/**
+ * @brief һMCUϵ̬ں, е̶ʱΪ9ں
+ * @param sample MPU9250_ReadSample
+ * @return 0-ɹ; -1-ʧ
+ * @note 㷨MPU9250_FUSION_ALGORITHMѡ, ȵMPU9250_InitWithFusion.
+ *       ûӲУ׼, дʱƫ
+ */
+int8_t MPU9250_UpdateFusion(const MPU9250_SampleTypedef *sample)
+{
+    float gyro[3], accel[3], mag[3], gyroSens, dt = 1.0f / MPU9250_SAMPLE_RATE;
+    uint8_t i;
+    if(mpu_get_gyro_sens(&gyroSens))
+        return -1;
+    for(i = 0; i < 3; i++)
+    {
+        gyro[i] = sample->gyro[i] / gyroSens;//dps
+        accel[i] = sample->accel[i];//AHRS_Updateֻ÷
+    }
+    //AK8963XYǵYXͬ, Z෴, ûЧʱȫΪ0, ֻ6ں
+    mag[0] = sample->compass[1] * MPU9250_COMPASS_SCALE;
+    mag[1] = sample->compass[0] * MPU9250_COMPASS_SCALE;
+    mag[2] = -sample->compass[2] * MPU9250_COMPASS_SCALE;
+    if(lastTimestamp != 0)
+        dt = (float)(sample->timestamp - lastTimestamp) / SystemCoreClock;//жӳʱʵʼ
+    lastTimestamp = sample->timestamp;
+    AHRS_Update(&mpu9250Ahrs, gyro, accel, mag, dt);
+    return 0;
+}
+
+/**
+ * @brief ݾжжһں
+ */
+static void MPU9250_FusionIrqHandler(void)
+{
+    MPU9250_SampleTypedef sample;
+    if(MPU9250_ReadSample(&sample) || MPU9250_UpdateFusion(&sample))
+        return;
+    if(fusionHandler != NULL)
+        fusionHandler();
+}
+
+/**
+ * @brief ʹDMP, MCUںϼٶȡǺ͵̵õ̬
+ * @param irqHandler ÿںϺĻص, ⲿже; NULL-ֻں
+ * @return 0-ɹ; -1-ʧ
+ * @note MPU9250_SAMPLE_RATE, ͬMPU9250_Init, ҪDMP̼.
+ *       MPU9250_GetFusionDataMPU9250_GetFusionQuaternion̬
+ */
+int8_t MPU9250_InitWithFusion(void (* irqHandler)(void))
+{
+    fusionHandler = irqHandler;
+    lastTimestamp = 0;
+    AHRS_Init(&mpu9250Ahrs, MPU9250_FUSION_ALGORITHM);
+    return MPU9250_Init(MPU9250_FusionIrqHandler);
+}
+
+/**
+ * @brief ȡMCUںϵ̬
+ * @param pitch , Χ -90~90
+ * @param roll , Χ -180~180
+ * @param yaw , ԴűΪ0, Χ -180~180
+ */
+void MPU9250_GetFusionData(float *pitch, float *roll, float *yaw)
+{
+    AHRS_GetEuler(&mpu9250Ahrs, pitch, roll, yaw);
+}
+
+/**
+ * @brief ȡMCUںϵ̬Ԫ
+ * @param q Ԫw, x, y, z
+ */
+void MPU9250_GetFusionQuaternion(float q[4])
+{
+    AHRS_GetQuaternion(&mpu9250Ahrs, q);
+}
+
 /**
  * @brief MPU9250ⲿжϷ
  */
@@ -1,7 +1,7 @@
 /**
  * @file    mpu9250.h
  * @author  Miaow
- * @version 0.1.1
+ * @version 0.2.0
  * @date    2018/09/08
  * @brief   
  *          This file provides functions to manage the following 
@@ -9,6 +9,8 @@
  *              1. Initialization and setup
  *              2. Get raw data from gyroscope, accelerometer, magnetometer and thermometer
  *              3. DMP operations
+ *              4. 9-axis samples in one burst read, magnetometer fetched by the internal I2C master
+ *              5. 9-axis attitude fusion on the MCU, see ahrs.c
  * @note
  *          Recommanded pin connection:
  *               
@@ -31,8 +33,8 @@
 #define __MPU9250_H
 
 #include "bsp_iic.h"   												  	  
-#include "sys.h"
-#include "delay.h"
+#include "stm32f4xx.h"
+#include "utils.h"
 #include "math.h"
 
 /**
@@ -53,6 +55,8 @@
 #define MPU9250_ADDR				0X68
 #define MPU9250_SAMPLE_RATE         200
 #define MPU9250_FIFO_RATE           200
+#define MPU9250_COMPASS_SCALE       0.15f   //16λ, ÿLSB 0.15uT
+#define MPU9250_FUSION_ALGORITHM    AHRS_MAHONY //MPU9250_InitWithFusion㷨, AHRS_MAHONYAHRS_MADGWICK
 typedef enum {
     MPU9250_FSR_250DPS = 0,
     MPU9250_FSR_500DPS,
@@ -76,6 +80,18 @@ typedef enum {
     MPU9250_FILTER_5HZ
 }MPU9250_LpfTypedef;
 
+/**
+ * @brief ͬһʱ̵ļٶȡ¶ȡǺ͵
+ */
+typedef struct {
+    uint32_t timestamp;//ȡʱ(ںʱ), UTILS_GetCycleCount
+    int16_t accel[3];//ٶȼXYZԭʼ
+    int16_t temperature;//¶ԭʼ
+    int16_t gyro[3];//XYZԭʼ
+    int16_t compass[3];//XYZ, У, MPU9250_COMPASS_SCALEΪuT, AK8963
+    uint8_t compassUpdated;//1-ڵ; 0-һεֵ
+}MPU9250_SampleTypedef;
+
 /**
  * @brief 
  * @param fsr MPU9250_FSR_XXXXDPS(MPU9250_GyroFsrTypedef)
@@ -102,12 +118,18 @@ extern inline int8_t MPU9250_SetSampleRate(uint16_t rate);
 int8_t MPU9250_SetLPF(MPU9250_LpfTypedef lpf);
 /**
  * @brief ʼ
- * @param irqHandler ⲿжϻص
- * @return 0-ɹ; 1-ʧ
- * @note ǡ2000dps, ٶȴ2g, 50Hz, 
- *       жϹ, I2Cģʽ, FIFO, INTЧ, Xʱ
+ * @param irqHandler ݾⲿжϻص, еMPU9250_ReadSample; NULL-ж
+ * @return 0-ɹ; -1-ʧ
+ * @note ǡ2000dps, ٶȴ2g, MPU9250_SAMPLE_RATE, 
+ *       I2Cģʽ, MPU9250ԶAK8963EXT_SENS_DATA, 100Hz, INTЧ, شⲿж, FIFO
  */
 extern inline int8_t MPU9250_Init(void (* irqHandler)(void));
+/**
+ * @brief һ22ֽ, õͬһʱ̵ļٶȡ¶ȡǺ͵
+ * @param sample 
+ * @return 0-ɹ; -1-ʧ
+ */
+int8_t MPU9250_ReadSample(MPU9250_SampleTypedef *sample);
 /**
  * @brief ȡ¶
  * @return ¶ֵ
@@ -145,12 +167,48 @@ int8_t MPU9250_GetAccelerometer(int16_t *ax, int16_t *ay, int16_t *az);
 int8_t MPU9250_InitWithDmp(void (* irqHandler)(void));
 /**
  * @brief õdmp
- * @param pitch , :0.1, Χ -90~90
- * @param pitch , :0.1, Χ -180~180
- * @param pitch , :0.1, Χ -180~180
+ * @param pitch , 0.01, Χ -90~90
+ * @param pitch , 0.01, Χ -180~180
+ * @param pitch , 0.01, Χ -180~180
  * @return 0-ɹ; -ʧ
  */
 int8_t MPU9250_GetDmpData(float *pitch, float *roll, float *yaw);
+/**
+ * @brief DMPһq30ʽԪ, κλ
+ * @param q30 Ԫw, x, y, z, 2^30Ϊ
+ * @return 0-ɹ; -ʧ
+ */
+int8_t MPU9250_GetDmpQuaternion(int32_t q30[4]);
+/**
+ * @brief õdmpת
+ * @param r дŵ3x3, ѵϵתģϵ
+ * @return 0-ɹ; -ʧ
+ */
+int8_t MPU9250_GetDmpRotationMatrix(float r[9]);
+/**
+ * @brief ʹDMP, MCUںϼٶȡǺ͵̵õ̬
+ * @param irqHandler ÿںϺĻص, ⲿже; NULL-ֻں
+ * @return 0-ɹ; -1-ʧ
+ */
+int8_t MPU9250_InitWithFusion(void (* irqHandler)(void));
+/**
+ * @brief һMCUϵ̬ں, е̶ʱΪ9ں
+ * @param sample MPU9250_ReadSample
+ * @return 0-ɹ; -1-ʧ
+ */
+int8_t MPU9250_UpdateFusion(const MPU9250_SampleTypedef *sample);
+/**
+ * @brief ȡMCUںϵ̬
+ * @param pitch , Χ -90~90
+ * @param roll , Χ -180~180
+ * @param yaw , ԴűΪ0, Χ -180~180
+ */
+void MPU9250_GetFusionData(float *pitch, float *roll, float *yaw);
+/**
+ * @brief ȡMCUںϵ̬Ԫ
+ * @param q Ԫw, x, y, z
+ */
+void MPU9250_GetFusionQuaternion(float q[4]);
 
 
 int8_t MPU9250_GetEulerFromCompass(float *yaw);
@@ -1,16 +1,17 @@
 /**
  * @file    mq7.c
  * @author  Miaow
- * @version 0.1.1
+ * @version 0.2.0
  * @date    2023/07/13
  * @brief   
  *          This file provides bsp functions to manage the following 
  *          functionalities of water level sensor:
  *              1. Initialization.
  *              2. Measure and get CO concentration.
+ *              3. Keep R0 in the internal flash across power cycles.
  * @note     
  *           Minimum version of header file:
- *              0.1.0
+ *              0.2.0
  *
  *          Pin connection:
  *               
@@ -30,14 +31,18 @@
 
 #include "mq7.h"
 #include "math.h"
+#include "flashkv.h"
 #define CAL_PPM 10 // У׼PPMֵ
 #define RL 10      // RLֵ
+#define R0_VERSION 1 // flashR0ĸʽ汾
 
 
 /** @addtogroup MQ7
   * @{
   */
 
+static float R0 = 8.00; // У׼ǰĬֵ
+
 /**
  * 
  * 
@@ -74,10 +79,11 @@ void MQ7_Init()
     ADC_Init(MQ7_ADCx, &ADC_InitStructure);
     ADC_RegularChannelConfig(MQ7_ADCx, MQ7_ADC_CHANNEL, 1, ADC_SampleTime_480Cycles);
     ADC_Cmd(MQ7_ADCx, ENABLE);
+#if MQ7_STORE_R0
+    FLASHKV_Read(FLASHKV_KEY_MQ7_R0, R0_VERSION, &R0, sizeof(R0)); // ûУ׼ʱĬֵ
+#endif
 }
 
-static float R0 = 8.00;
-
 /**
  * 
  * 
@@ -109,6 +115,9 @@ void MQ7_PPM_Calibration()
     Vrl = ((float)((int)((Vrl + 0.005f) * 100.0f))) / 100.0f;
     float RS = (3.3f - Vrl) / Vrl * RL;
     R0 = RS / pow(CAL_PPM / 98.322, 1 / -1.458f);
+#if MQ7_STORE_R0
+    FLASHKV_Write(FLASHKV_KEY_MQ7_R0, R0_VERSION, &R0, sizeof(R0));
+#endif
 }
 
 /**
@@ -1,16 +1,17 @@
 /**
  * @file    mq7.h
  * @author  Miaow
- * @version 0.1.0
+ * @version 0.2.0
  * @date    2021/08/01
  * @brief   
  *          This file provides bsp functions to manage the following 
  *          functionalities of water level sensor:
  *              1. Initialization.
  *              2. Measure and get CO concentration.
+ *              3. Keep R0 in the internal flash across power cycles.
  * @note     
  *           Minimum version of source file:
- *              0.1.0
+ *              0.2.0
  *
  *          Pin connection:
  *          ┌────────┐     ┌────────┐
@@ -59,6 +60,15 @@
  * @}
  */
 
+/** 
+ * @defgroup MQ7_config
+ * @{
+ */
+#define MQ7_STORE_R0 1 // 1-R0 saved by MQ7_PPM_Calibration and loaded by MQ7_Init, see flashkv.h
+/**
+ * @}
+ */
+
 void MQ7_Init(void);
 void MQ7_PPM_Calibration(void);
 float MQ7_GetPPM(void);
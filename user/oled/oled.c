@@ -10,6 +10,11 @@
  *              2. Display formatted strings, pictures and Chinese characters
  *              3. Turn on/off the screen
  *              4. Show logs
+ *              5. Send modified regions of the frame buffer in bursts
+ *              6. Non-blocking frame commit by hardware I2C and DMA
+ *              7. Draw pixels, lines, rectangles, circles and bitmaps
+ *              8. Hardware continuous scroll for tickers
+ *              9. Display text in fixed or variable width fonts, 8 or 16 pixels tall
  * @note
  *          Minimum version of header file:
  *              0.1.0
@@ -32,9 +37,14 @@
 #include "oled.h"
 #include "oled_font.h"
 #include "oled_bmp.h"
+#ifndef OLED_HOST
 #include "utils.h"
-#include "stdio.h"
+#endif
+#if OLED_USE_HARDWARE_IIC == 0
+#include "bsp_iic.h"
+#endif
 #include "stdarg.h"
+#include "string.h"
 
 #define OLED_WIDTH                  128
 #define OLED_HEIGHT                 64
@@ -43,451 +53,788 @@
 #define OLED_CHARACTER_HEIGHT       8
 #define OLED_LINES                  8
 #define OLED_CHARACTERS_ONE_LINE    21
+#define OLED_FORMAT_DIGITS          20 //!< ʽһʱַ
 
 /**
- * @brief ûнյӦźţ򷵻1.
+ * @brief Ʊλòѯ.
  */
-#define IIC_IF_NOT_ACK_RETURN_1     if(OLED_IIC_WaitAck()) {OLED_IIC_Stop(); return 1;}
+static const uint8_t tabLookUpTable[OLED_CHARACTERS_ONE_LINE + 1] = {4,4,4,4,8,8,8,8,12,12,12,12,16,16,16,16,20,20,20,20,24,24};
+static uint32_t gRamWords[OLED_PAGES][OLED_WIDTH / 4] = {0};//Դ水ִ洢, ֤ÿҳ4ֽڶ, ԰32λһδ4
+static uint8_t (* const gRam)[OLED_WIDTH] = (uint8_t (*)[OLED_WIDTH])gRamWords;//ֽڷԴ
+static uint8_t dirtyBegin[OLED_PAGES] = {0};//ÿҳҪ͵ʼ
+static uint8_t dirtyEnd[OLED_PAGES] = {0};//ÿҳҪ͵Ľ(), ʼʱʾûҪ͵
+static uint8_t topPage = 0;//ʾĻһеԴҳ, Դ水ҳѭʹ
+static __IO uint8_t startLinePending = 0;//ʾʼѸı, Ҫ´ˢʱ
+static __IO uint8_t scrollActive = 0;//OLEDӲ
+static uint8_t scrollVertical = 0;//ǰֱ
+static uint8_t scrollBeginPage = 0;//ʼҳ
+static uint8_t scrollEndPage = 0;//Ľҳ, 
 
 /**
- * @brief Ʊλòѯ.
+ * @brief Ļϵҳ(0~7)תΪԴеҳ.
  */
-static const uint8_t tabLookUpTable[OLED_CHARACTERS_ONE_LINE + 1] = {4,4,4,4,8,8,8,8,12,12,12,12,16,16,16,16,20,20,20,20,24,24};
-static __IO uint8_t gRam[OLED_PAGES][OLED_WIDTH] = {0};
+#define OLED_PAGE(y)                (((y) + topPage) & (OLED_PAGES - 1))
 
-static uint8_t OLED_WriteCommand(uint8_t command);
-static uint8_t OLED_WriteData(uint8_t data);
+/**
+ * @brief ɫ޸ԴmaskӦλ, ֽں.
+ */
+#define OLED_APPLY(target, mask, color) \
+    do{ \
+        if((color) == OLED_White) (target) |= (mask); \
+        else if((color) == OLED_Black) (target) &= ~(mask); \
+        else (target) ^= (mask); \
+    }while(0)
+
+/**
+ * @brief λͼݰɫдԴmaskӦλ.
+ */
+#define OLED_APPLY_BITMAP(target, data, mask, color) \
+    do{ \
+        if((color) == OLED_White) (target) = ((target) & ~(mask)) | (data); \
+        else if((color) == OLED_Black) (target) = ((target) & ~(mask)) | (~(data) & (mask)); \
+        else (target) ^= (data); \
+    }while(0)
+
+#if OLED_USE_STATISTICS == 1
+static OLED_StatisticsTypedef busStatistics = {0};//IICͳ
+
+/**
+ * @brief ¼һδ.
+ * @param length ַֽ֮.
+ * @note ÿֽ9ʱ(Ӧλ), ʼֹͣźŸ1ʱ.
+ */
+#define OLED_COUNT_TRANSFER(length) \
+    do{ \
+        busStatistics.transactions++; \
+        busStatistics.bytes += 1 + (length); \
+        busStatistics.clocks += 9 * (1 + (length)) + 2; \
+    }while(0)
+#else
+#define OLED_COUNT_TRANSFER(length)
+#endif
+
+static uint8_t OLED_WriteCommands(const uint8_t *commands, uint8_t length);
 static inline void OLED_ScrollUpOneLine(void);
-static void IIC_DelayUs(uint32_t us);
 
 /**
- * @brief ׼΢뼶ʱ.
+ * @brief ʽʱַĺ.
  */
-static inline void IIC_DelayUs(uint32_t us)
+typedef void (*OLED_PutCharacterHandler)(OLED_HandleTypedef *oledHandle, char character);
+
+/**
+ * @brief ԴҪ͵.
+ * @param page ҳ(0~7).
+ * @param beginX ʼ(0~127).
+ * @param endX , (1~128).
+ * @note ÿҳֻ¼һ, αȡ. 첽ˢʱIICжϻȡ, ж϶д.
+ */
+static inline void OLED_MarkDirty(uint8_t page, uint8_t beginX, uint8_t endX)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if(dirtyBegin[page] >= dirtyEnd[page])
+    {
+        dirtyBegin[page] = beginX;
+        dirtyEnd[page] = endX;
+    }
+    else
+    {
+        if(beginX < dirtyBegin[page])
+            dirtyBegin[page] = beginX;
+        if(endX > dirtyEnd[page])
+            dirtyEnd[page] = endX;
+    }
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief ҳǷӲ.
+ * @param page ҳ(0~7).
+ * @return 0-; 1-, ˢʱҳ, ֹͣٷ.
+ */
+static inline uint8_t OLED_IsPageScrolling(uint8_t page)
 {
-    while(us--);
+    if(!scrollActive)
+        return 0;
+    return scrollVertical || (page >= scrollBeginPage && page <= scrollEndPage);
 }
 
 /**
- * @brief ʼIIC.
+ * @brief ȡһҳ.
+ * @param page ҳ(0~7).
+ * @param beginX ʼ.
+ * @param endX , .
+ * @return 0-ҳû; 1-.
+ */
+static inline uint8_t OLED_TakeDirty(uint8_t page, uint8_t *beginX, uint8_t *endX)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    *beginX = dirtyBegin[page];
+    *endX = dirtyEnd[page];
+    dirtyBegin[page] = dirtyEnd[page] = 0;
+    __set_PRIMASK(primask);
+    return *beginX < *endX;
+}
+
+#if OLED_USE_HARDWARE_IIC == 1
+
+#define OLED_TX_BUFFER_SIZE         (OLED_WIDTH + 8)
+
+/**
+ * @brief ӲIIC״̬.
+ */
+typedef enum
+{
+    OLED_TransferIdle = 0,//
+    OLED_TransferSingle,//δ, 
+    OLED_TransferFlush//첽ˢ, ҳ
+}OLED_TransferStateTypedef;
+
+static uint8_t txBuffer[OLED_TX_BUFFER_SIZE];//DMAͻ, ԴеƵ﷢, ڼԴԼ޸
+static __IO OLED_TransferStateTypedef transferState = OLED_TransferIdle;
+static __IO uint8_t transferError = 0;//һδˢµĽ, 0-; 1-
+static uint8_t flushPage = 0;//첽ˢһҪҳ
+static uint8_t flushSpanPage, flushSpanBeginX, flushSpanEndX;//ڷ͵, ʱ±; ҳΪOLED_PAGESʱʾڷʾʼ
+static OLED_FlushHandler __flushHandler = NULL;
+
+/**
+ * @brief ʼIICDMA.
  */
 static inline void OLED_IIC_Init()
 {
     GPIO_InitTypeDef GPIO_InitStructure;
-    RCC_AHB1PeriphClockCmd(OLED_SCL_GPIO_CLK | OLED_SDA_GPIO_CLK, ENABLE);//ʹGPIOʱ
-    //SCL, SDAʼ
+    I2C_InitTypeDef I2C_InitStructure;
+    DMA_InitTypeDef DMA_InitStructure;
+    NVIC_InitTypeDef NVIC_InitStructure;
+    
+    //SCL, SDAÿ©
+    RCC_AHB1PeriphClockCmd(OLED_SCL_GPIO_CLK | OLED_SDA_GPIO_CLK, ENABLE);
+    GPIO_PinAFConfig(OLED_SCL_PORT, OLED_SCL_PINSOURCE, OLED_I2C_GPIO_AF);
+    GPIO_PinAFConfig(OLED_SDA_PORT, OLED_SDA_PINSOURCE, OLED_I2C_GPIO_AF);
     GPIO_InitStructure.GPIO_Pin = OLED_SCL_PIN;
-    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_OUT;//ͨģʽ
-    GPIO_InitStructure.GPIO_OType = GPIO_OType_PP;//
-    GPIO_InitStructure.GPIO_Speed = GPIO_Fast_Speed;//50MHz
-    GPIO_InitStructure.GPIO_PuPd = GPIO_PuPd_UP;//
-    GPIO_Init(OLED_SCL_PORT, &GPIO_InitStructure);//ʼ
+    GPIO_InitStructure.GPIO_Mode = GPIO_Mode_AF;
+    GPIO_InitStructure.GPIO_OType = GPIO_OType_OD;
+    GPIO_InitStructure.GPIO_Speed = GPIO_Fast_Speed;
+    GPIO_InitStructure.GPIO_PuPd = GPIO_PuPd_UP;
+    GPIO_Init(OLED_SCL_PORT, &GPIO_InitStructure);
     GPIO_InitStructure.GPIO_Pin = OLED_SDA_PIN;
-    GPIO_Init(OLED_SDA_PORT, &GPIO_InitStructure);//ʼ
-    OLED_SCL_PORT->BSRRL = OLED_SCL_PIN;//IIC_SCL=1
-    OLED_SDA_PORT->BSRRL = OLED_SDA_PIN;//IIC_SDA=1
+    GPIO_Init(OLED_SDA_PORT, &GPIO_InitStructure);
+    
+    //IIC, ģʽ
+    RCC_APB1PeriphClockCmd(OLED_I2C_CLK, ENABLE);
+    I2C_DeInit(OLED_I2C);
+    I2C_InitStructure.I2C_ClockSpeed = OLED_I2C_SPEED;
+    I2C_InitStructure.I2C_Mode = I2C_Mode_I2C;
+    I2C_InitStructure.I2C_DutyCycle = I2C_DutyCycle_2;
+    I2C_InitStructure.I2C_OwnAddress1 = 0;
+    I2C_InitStructure.I2C_Ack = I2C_Ack_Enable;
+    I2C_InitStructure.I2C_AcknowledgedAddress = I2C_AcknowledgedAddress_7bit;
+    I2C_Init(OLED_I2C, &I2C_InitStructure);
+    I2C_Cmd(OLED_I2C, ENABLE);
+    
+    //DMA, ÿδǰó
+    RCC_AHB1PeriphClockCmd(OLED_TX_DMA_CLK, ENABLE);
+    DMA_DeInit(OLED_TX_DMA_STREAM);
+    DMA_InitStructure.DMA_Channel = OLED_TX_DMA_CHANNEL;
+    DMA_InitStructure.DMA_PeripheralBaseAddr = (uint32_t)&OLED_I2C->DR;
+    DMA_InitStructure.DMA_Memory0BaseAddr = (uint32_t)txBuffer;
+    DMA_InitStructure.DMA_DIR = DMA_DIR_MemoryToPeripheral;
+    DMA_InitStructure.DMA_BufferSize = 1;
+    DMA_InitStructure.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    DMA_InitStructure.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    DMA_InitStructure.DMA_PeripheralDataSize = DMA_PeripheralDataSize_Byte;
+    DMA_InitStructure.DMA_MemoryDataSize = DMA_MemoryDataSize_Byte;
+    DMA_InitStructure.DMA_Mode = DMA_Mode_Normal;
+    DMA_InitStructure.DMA_Priority = DMA_Priority_Medium;
+    DMA_InitStructure.DMA_FIFOMode = DMA_FIFOMode_Disable;
+    DMA_InitStructure.DMA_FIFOThreshold = DMA_FIFOThreshold_Full;
+    DMA_InitStructure.DMA_MemoryBurst = DMA_MemoryBurst_Single;
+    DMA_InitStructure.DMA_PeripheralBurst = DMA_PeripheralBurst_Single;
+    DMA_Init(OLED_TX_DMA_STREAM, &DMA_InitStructure);
+    I2C_DMACmd(OLED_I2C, ENABLE);
+    
+    //¼жϺʹж
+    NVIC_InitStructure.NVIC_IRQChannel = OLED_I2C_EV_IRQ_CHANNEL;
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 3;
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStructure);
+    NVIC_InitStructure.NVIC_IRQChannel = OLED_I2C_ER_IRQ_CHANNEL;
+    NVIC_Init(&NVIC_InitStructure);
 }
 
 /**
- * @brief ʼź.
+ * @brief һδ, txBufferǰlengthֽ.
+ * @param length ֽ.
+ * @note ʼźź͵ַжϴ, DMA, һֽڷ(BTF)жвֹͣź.
  */
-static inline void OLED_IIC_Start()
+static void OLED_StartTransfer(uint16_t length)
 {
-    __disable_irq();  
-    OLED_IIC_Out(); //sda
-    OLED_SDA_PORT->BSRRL = OLED_SDA_PIN; //IIC_SDA=1      
-    OLED_SCL_PORT->BSRRL = OLED_SCL_PIN; //IIC_SCL=1
-    IIC_DelayUs(1);
-    OLED_SDA_PORT->BSRRH = OLED_SDA_PIN; //IIC_SDA=0 START:when CLK is high,DATA change form high to low 
-    IIC_DelayUs(1);
-    OLED_SCL_PORT->BSRRH = OLED_SCL_PIN; //ǯסI2Cߣ׼ͻ 
+    OLED_COUNT_TRANSFER(length);
+    DMA_ClearFlag(OLED_TX_DMA_STREAM, OLED_TX_DMA_FLAGS);
+    DMA_SetCurrDataCounter(OLED_TX_DMA_STREAM, length);
+    DMA_Cmd(OLED_TX_DMA_STREAM, ENABLE);
+    I2C_ITConfig(OLED_I2C, I2C_IT_EVT | I2C_IT_ERR, ENABLE);
+    I2C_GenerateSTART(OLED_I2C, ENABLE);
 }
 
 /**
- * @brief ֹͣź.
+ * @brief 첽ˢʱһ, ûʱˢ²ûص.
+ * @note ̺߳IICже.
  */
-static inline void OLED_IIC_Stop()
+static void OLED_FlushNext()
 {
-    OLED_IIC_Out(); //sda
-    OLED_SCL_PORT->BSRRH = OLED_SCL_PIN; //IIC_SCL=0
-    OLED_SDA_PORT->BSRRH = OLED_SDA_PIN; //IIC_SDA=0 STOP:when CLK is high DATA change form low to high
-    IIC_DelayUs(1);
-    OLED_SCL_PORT->BSRRL = OLED_SCL_PIN; //IIC_SCL=1
-    OLED_SDA_PORT->BSRRL = OLED_SDA_PIN; //IIC_SDA=1 I2C߽ź
-    IIC_DelayUs(1);
-    __enable_irq();  
+    uint8_t beginX, endX;
+    OLED_FlushHandler handler;
+    if(startLinePending && !scrollActive && flushPage == 0)
+    {
+        startLinePending = 0;
+        txBuffer[0] = 0x00;
+        txBuffer[1] = 0x40 | (topPage << 3);//ʾʼ
+        flushSpanPage = OLED_PAGES;
+        OLED_StartTransfer(2);
+        return;
+    }
+    for(; flushPage < OLED_PAGES; flushPage++)
+    {
+        if(OLED_IsPageScrolling(flushPage) || !OLED_TakeDirty(flushPage, &beginX, &endX))
+            continue;
+        txBuffer[0] = 0x80;
+        txBuffer[1] = 0xB0 | flushPage;//ҳַ
+        txBuffer[2] = 0x80;
+        txBuffer[3] = 0x10 | (beginX >> 4);//ʾλáиߵַ
+        txBuffer[4] = 0x80;
+        txBuffer[5] = 0x00 | (beginX & 0x0F);//ʾλáе͵ַ
+        txBuffer[6] = 0x40;//Ϊ
+        memcpy(txBuffer + 7, gRam[flushPage] + beginX, endX - beginX);
+        flushSpanPage = flushPage;
+        flushSpanBeginX = beginX;
+        flushSpanEndX = endX;
+        flushPage++;
+        OLED_StartTransfer(7 + endX - beginX);
+        return;
+    }
+    handler = __flushHandler;
+    __flushHandler = NULL;
+    transferState = OLED_TransferIdle;
+    if(handler != NULL)
+        handler(transferError);
 }
 
 /**
- * @brief ȴӦź.
- * @return 1-Ӧʧ; 0-Ӧɹ.
+ * @brief һδĴ.
+ * @param error 0-; 1-.
  */
-static inline uint8_t OLED_IIC_WaitAck()
+static void OLED_TransferComplete(uint8_t error)
 {
-    uint8_t ucErrTime=0;
-    OLED_IIC_In();//SDAΪ  
-    OLED_SDA_PORT->BSRRL = OLED_SDA_PIN;//IIC_SDA=1
-    IIC_DelayUs(1);       
-    OLED_SCL_PORT->BSRRL = OLED_SCL_PIN;//IIC_SCL=1
-    IIC_DelayUs(1);     
-    while(OLED_SDA_PORT->IDR & OLED_SDA_PIN)
+    uint16_t timeout = 0xFFFF;
+    while((OLED_I2C->CR1 & I2C_CR1_STOP) && --timeout);//ȴֹͣźŷٿʼ´δ
+    I2C_ITConfig(OLED_I2C, I2C_IT_EVT | I2C_IT_ERR, DISABLE);
+    if(error)
+        transferError = 1;
+    if(transferState == OLED_TransferFlush)
     {
-        ucErrTime++;
-        if(ucErrTime>250)
+        if(error)
         {
-            OLED_IIC_Stop();
-            return 1;
+            if(flushSpanPage < OLED_PAGES)
+                OLED_MarkDirty(flushSpanPage, flushSpanBeginX, flushSpanEndX);
+            else
+                startLinePending = 1;
+            flushPage = OLED_PAGES;//ٷʣµ, ´ˢ
         }
+        OLED_FlushNext();
+    }
+    else
+    {
+        transferState = OLED_TransferIdle;
+    }
+}
+
+/**
+ * @brief IIC¼ж.
+ */
+void OLED_I2C_EV_IRQ_HANDLER()
+{
+    uint16_t sr1 = OLED_I2C->SR1;
+    if(sr1 & I2C_SR1_SB)
+    {
+        I2C_Send7bitAddress(OLED_I2C, OLED_IIC_ADDRESS, I2C_Direction_Transmitter);//SR1дDRSB
+    }
+    else if(sr1 & I2C_SR1_ADDR)
+    {
+        (void)OLED_I2C->SR2;//SR1SR2ADDR, ֮DMA
+    }
+    else if((sr1 & I2C_SR1_BTF) && DMA_GetCurrDataCounter(OLED_TX_DMA_STREAM) == 0)
+    {
+        I2C_GenerateSTOP(OLED_I2C, ENABLE);
+        OLED_TransferComplete(0);
     }
-    OLED_SCL_PORT->BSRRH = OLED_SCL_PIN;//IIC_SCL=0 ʱ0        
-    return 0;  
 }
 
 /**
- * @brief Ӧź.
+ * @brief IICж, Ӧߴٲöʧʱֹδ.
  */
-static inline void OLED_IIC_Ack()
+void OLED_I2C_ER_IRQ_HANDLER()
 {
-    OLED_SCL_PORT->BSRRH = OLED_SCL_PIN;//IIC_SCL=0
-    OLED_IIC_Out();
-    OLED_SDA_PORT->BSRRH = OLED_SDA_PIN;//IIC_SDA=0
-    IIC_DelayUs(1);
-    OLED_SCL_PORT->BSRRL = OLED_SCL_PIN;//IIC_SCL=1
-    IIC_DelayUs(1);
-    OLED_SCL_PORT->BSRRH = OLED_SCL_PIN;//IIC_SCL=0
+    OLED_I2C->SR1 &= ~(I2C_SR1_AF | I2C_SR1_BERR | I2C_SR1_ARLO | I2C_SR1_OVR);
+    DMA_Cmd(OLED_TX_DMA_STREAM, DISABLE);
+    I2C_GenerateSTOP(OLED_I2C, ENABLE);
+    OLED_TransferComplete(1);
 }
 
 /**
- * @brief Ӧź.
- */           
-static inline void OLED_IIC_NAck()
+ * @brief һIICзͿֽںֽ, ŷ.
+ * @param control ֽ, 0x00-Ϊ; 0x40-Ϊ.
+ * @param header ֽڷ͵ֽ, ΪNULL.
+ * @param headerLength headerֽ.
+ * @param data ͵ֽ, ΪNULL.
+ * @param dataLength dataֽ.
+ * @return 0-; 1-.
+ * @note 첽ˢ, ȵȴˢ½. ҪȼIICжϵже.
+ */
+static uint8_t OLED_Transmit(uint8_t control, const uint8_t *header, uint8_t headerLength, const uint8_t *data, uint16_t dataLength)
 {
-    OLED_SCL_PORT->BSRRH = OLED_SCL_PIN;//IIC_SCL=0
-    OLED_IIC_Out();
-    OLED_SDA_PORT->BSRRL = OLED_SDA_PIN;//IIC_SDA=1
-    IIC_DelayUs(1);
-    OLED_SCL_PORT->BSRRL = OLED_SCL_PIN;//IIC_SCL=1
-    IIC_DelayUs(1);
-    OLED_SCL_PORT->BSRRH = OLED_SCL_PIN;//IIC_SCL=0
+    while(transferState != OLED_TransferIdle);
+    if(1 + headerLength + dataLength > OLED_TX_BUFFER_SIZE)
+        return 1;
+    txBuffer[0] = control;
+    if(headerLength)
+        memcpy(txBuffer + 1, header, headerLength);
+    if(dataLength)
+        memcpy(txBuffer + 1 + headerLength, data, dataLength);
+    transferError = 0;
+    transferState = OLED_TransferSingle;
+    OLED_StartTransfer(1 + headerLength + dataLength);
+    while(transferState != OLED_TransferIdle);
+    return transferError;
 }
 
 /**
- * @brief IICһֽ.
- * @return 1-Ack; 0-Ack.
- */      
-static inline void OLED_IIC_WriteByte(uint8_t data)
-{                        
-  uint8_t i;
-  OLED_IIC_Out();         
-  OLED_SCL_PORT->BSRRH = OLED_SCL_PIN; //IIC_SCL=0 ʱӿʼݴ
-  for (i = 0; i < 8; i++)
-  {            
-    if ((data & 0x80) >> 7)
-      OLED_SDA_PORT->BSRRL = OLED_SDA_PIN; //IIC_SDA=1
-    else
-      OLED_SDA_PORT->BSRRH = OLED_SDA_PIN; //IIC_SDA=0
-      data <<= 1;       
-      IIC_DelayUs(2); //TEA5767ʱǱ
-      OLED_SCL_PORT->BSRRL = OLED_SCL_PIN; //IIC_SCL=1
-      IIC_DelayUs(2); 
-      OLED_SCL_PORT->BSRRH = OLED_SCL_PIN; //IIC_SCL=0
-      IIC_DelayUs(2);
-  }
+ * @brief ʼں̨Դб޸Ĺ͵OLED, .
+ * @param flushHandler ɺжеõĻص, ΪNULL.
+ * @return 0-ѿʼ; 1-ϴˢ»ûн.
+ * @note ڼԼ޸Դ, ޸Ĺ´ˢʱ.
+ */
+uint8_t OLED_FlushAsync(OLED_FlushHandler flushHandler)
+{
+    __disable_irq();
+    if(transferState != OLED_TransferIdle)
+    {
+        __enable_irq();
+        return 1;
+    }
+    transferState = OLED_TransferFlush;
+    __enable_irq();
+    __flushHandler = flushHandler;
+    transferError = 0;
+    flushPage = 0;
+    OLED_FlushNext();
+    return 0;
 }
 
 /**
- * @brief 1ֽ.
- * @param ack 1-Ӧ; 0-ͷӦ.
- * @return ضȡһֽ.
- */ 
-static inline uint8_t OLED_IIC_ReadByte(uint8_t ack)
+ * @brief Ƿˢ.
+ * @return 0-; 1-ڷ.
+ */
+uint8_t OLED_IsFlushing()
 {
-  uint8_t i, receive = 0;
-  OLED_IIC_In(); //SDAΪ
-  for (i = 0; i < 8; i++)
-  {
-    OLED_SCL_PORT->BSRRH = OLED_SCL_PIN; //IIC_SCL=0 
-    IIC_DelayUs(1);
-    OLED_SCL_PORT->BSRRL = OLED_SCL_PIN; //IIC_SCL=1
-    receive <<= 1;
-    if (OLED_SDA_PORT->IDR & OLED_SDA_PIN)
-      receive++;   
-    IIC_DelayUs(1); 
-  }                     
-  if (!ack)
-    OLED_IIC_NAck(); //nACK
-  else
-    OLED_IIC_Ack(); //ACK
-  return receive;
-}
-
-/**
- * @brief IICд1ֽڵĴ.
- * @param addr ַ.
- * @param reg Ĵַ.
- * @param data Ҫд.
- * @return 0-; 1-.
+    return transferState != OLED_TransferIdle;
+}
+
+/**
+ * @brief Դб޸Ĺ͵OLED, ŷ.
+ * @return 0-; 1-, δͳɹ´εʱط.
+ * @note ʾֻ޸Դ, ñŻʾ.
+ *       ÿҳһIIC䷢.
  */
-uint8_t OLED_IIC_WriteRegByte(uint8_t addr, uint8_t reg, uint8_t data)
-{ 
-  OLED_IIC_Start(); 
-  OLED_IIC_WriteByte(addr << 1); //ַ+д	
-  if (OLED_IIC_WaitAck()) //ȴӦ
-  {
-    OLED_IIC_Stop();
-    return 1;		
-  }
-    OLED_IIC_WriteByte(reg); //дĴַ
-    OLED_IIC_WaitAck(); //ȴӦ 
-    OLED_IIC_WriteByte(data); //
-  if (OLED_IIC_WaitAck()) //ȴACK
-  {
-    OLED_IIC_Stop();
-    return 1;
-  }
-  OLED_IIC_Stop();
-  return 0;
+uint8_t OLED_Flush()
+{
+    while(OLED_FlushAsync(NULL));
+    while(transferState != OLED_TransferIdle);
+    return transferError;
 }
 
+#else
+
+/**
+ * @brief һֽ, ûнյӦźţֹͣźŲ1.
+ */
+#define OLED_IIC_WRITE_OR_RETURN_1(data)    if(IIC_BusWriteByte(&oledBus, data)) {IIC_BusStop(&oledBus); return 1;}
+
+static IIC_BusTypedef oledBus = IIC_BUS(OLED_SCL_PORT, OLED_SCL_PIN, OLED_SDA_PORT, OLED_SDA_PIN, OLED_I2C_SPEED);
+
 /**
- * @brief IIC1ֽڵĴ.
- * @param addr ַ.
- * @param reg Ĵַ.
- * @return Ҫȡ.
+ * @brief ʼIIC.
  */
-uint8_t OLED_IIC_ReadRegByte(uint8_t addr, uint8_t reg)
+static inline void OLED_IIC_Init()
 {
-  uint8_t res;
-  OLED_IIC_Start();
-  OLED_IIC_WriteByte(addr << 1); //ַ+д
-  OLED_IIC_WaitAck(); //ȴӦ
-  OLED_IIC_WriteByte(reg); //дĴַ
-  OLED_IIC_WaitAck(); //ȴӦ
-  OLED_IIC_Start();
-  OLED_IIC_WriteByte((addr << 1) | 1); //ַ+
-  OLED_IIC_WaitAck(); //ȴӦ
-  res = OLED_IIC_ReadByte(0); //ȡ,nACK
-  OLED_IIC_Stop(); //һֹͣ
-  return res;		
+    IIC_InitBus(&oledBus);
 }
 
 /**
- * @brief IICд.
- * @param addr ַ.
- * @param reg Ĵַ.
- * @param len дֽ.
- * @param data Ҫд.
+ * @brief һIICзͿֽںֽ.
+ * @param control ֽ, 0x00-Ϊ; 0x40-Ϊ.
+ * @param header ֽڷ͵ֽ, ΪNULL.
+ * @param headerLength headerֽ.
+ * @param data ͵ֽ, ΪNULL.
+ * @param dataLength dataֽ.
  * @return 0-; 1-.
  */
-uint8_t OLED_IIC_WriteRegBytes(uint8_t addr, uint8_t reg, uint8_t len, uint8_t *data)
+static uint8_t OLED_Transmit(uint8_t control, const uint8_t *header, uint8_t headerLength, const uint8_t *data, uint16_t dataLength)
 {
-  uint8_t i;
-  OLED_IIC_Start();
-  OLED_IIC_WriteByte(addr << 1); //ַ+д
-  if (OLED_IIC_WaitAck()) //ȴӦ
-  {
-    OLED_IIC_Stop();
-    return 1;
-  }
-  OLED_IIC_WriteByte(reg); //дĴַ
-  OLED_IIC_WaitAck(); //ȴӦ
-  for (i = 0; i < len; i++)
-  {
-    OLED_IIC_WriteByte(data[i]); //
-    if (OLED_IIC_WaitAck()) //ȴACK
+    OLED_COUNT_TRANSFER(1 + headerLength + dataLength);
+    IIC_BusStart(&oledBus);
+    OLED_IIC_WRITE_OR_RETURN_1(OLED_IIC_ADDRESS)//Slave address,SA0=0
+    OLED_IIC_WRITE_OR_RETURN_1(control)
+    while(headerLength--)
     {
-      OLED_IIC_Stop();
-      return 1;
+        OLED_IIC_WRITE_OR_RETURN_1(*header++)
     }
-  }
-  OLED_IIC_Stop();
-  return 0;    
+    while(dataLength--)
+    {
+        OLED_IIC_WRITE_OR_RETURN_1(*data++)
+    }
+    IIC_BusStop(&oledBus);
+    return 0;
 }
 
 /**
- * @brief IIC.
- * @param addr ַ.
- * @param reg Ĵַ.
- * @param len ȡֽ.
- * @param data Ҫȡ.
+ * @brief һҳеһԴдOLED.
+ * @param page ҳ(0~7).
+ * @param beginX ʼ(0~127).
+ * @param endX , (1~128).
  * @return 0-; 1-.
+ * @note ֽ0x80ʾֻһֽ, 3ݿԷͬһδ.
  */
-uint8_t OLED_IIC_ReadRegBytes(uint8_t addr, uint8_t reg, uint8_t len, uint8_t *data)
+static uint8_t OLED_WriteSpan(uint8_t page, uint8_t beginX, uint8_t endX)
 {
-  OLED_IIC_Start();
-  OLED_IIC_WriteByte(addr << 1); //ַ+д
-  if (OLED_IIC_WaitAck()) //ȴӦ
-  {
-    OLED_IIC_Stop();
-    return 1;
-  }
-  OLED_IIC_WriteByte(reg); //дĴַ
-  OLED_IIC_WaitAck(); //ȴӦ
-  OLED_IIC_Start();
-  OLED_IIC_WriteByte((addr << 1) | 1); //ַ+
-  OLED_IIC_WaitAck(); //ȴӦ
-  while (len)
-  {
-    if (len == 1)
-      *data=OLED_IIC_ReadByte(0); //,nACK
-    else
-      *data=OLED_IIC_ReadByte(1); //,ACK
-    len--;
-    data++;
-  }
-  OLED_IIC_Stop(); //һֹͣ
-  return 0;
+    uint8_t header[6];
+    header[0] = 0xB0 | page;//ҳַ
+    header[1] = 0x80;
+    header[2] = 0x10 | (beginX >> 4);//ʾλáиߵַ
+    header[3] = 0x80;
+    header[4] = 0x00 | (beginX & 0x0F);//ʾλáе͵ַ
+    header[5] = 0x40;//Ϊ
+    return OLED_Transmit(0x80, header, sizeof(header), gRam[page] + beginX, endX - beginX);
+}
+
+/**
+ * @brief Դб޸Ĺ͵OLED.
+ * @return 0-; 1-, δͳɹ´εʱط.
+ * @note ʾֻ޸Դ, ñŻʾ.
+ *       ÿҳһIIC䷢.
+ */
+uint8_t OLED_Flush()
+{
+    uint8_t m, beginX, endX, command, result = 0;
+    if(startLinePending && !scrollActive)
+    {
+        startLinePending = 0;
+        command = 0x40 | (topPage << 3);//ʾʼ
+        if(OLED_WriteCommands(&command, 1))
+        {
+            startLinePending = 1;
+            result = 1;
+        }
+    }
+    for(m = 0; m < OLED_PAGES; m++)
+    {
+        if(OLED_IsPageScrolling(m) || !OLED_TakeDirty(m, &beginX, &endX))
+            continue;
+        if(OLED_WriteSpan(m, beginX, endX))
+        {
+            OLED_MarkDirty(m, beginX, endX);
+            result = 1;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief ʼԴб޸Ĺ͵OLED.
+ * @param flushHandler ɺõĻص, ΪNULL.
+ * @return 0-ѿʼ; 1-ϴˢ»ûн.
+ * @note ģIICʱŷ, ǰûص.
+ */
+uint8_t OLED_FlushAsync(OLED_FlushHandler flushHandler)
+{
+    uint8_t result = OLED_Flush();
+    if(flushHandler != NULL)
+        flushHandler(result);
+    return 0;
 }
 
+/**
+ * @brief Ƿˢ.
+ * @return ģIICʱ0.
+ */
+uint8_t OLED_IsFlushing()
+{
+    return 0;
+}
+
+#endif
+
+#if OLED_USE_STATISTICS == 1
+/**
+ * @brief ȡIICͳ.
+ * @param statistics ͳ,  @ref OLED_StatisticsTypedef.
+ * @note ĳĿ: ȵOLED_ResetStatistics, ٵøúOLED_Flush, Ȼȡͳ.
+ */
+void OLED_GetStatistics(OLED_StatisticsTypedef *statistics)
+{
+    __disable_irq();//첽ˢʱжиͳ
+    *statistics = busStatistics;
+    __enable_irq();
+    statistics->busTimeUs = (uint32_t)((uint64_t)statistics->clocks * 1000000 / OLED_I2C_SPEED);
+}
+
+/**
+ * @brief ͳ.
+ */
+void OLED_ResetStatistics()
+{
+    __disable_irq();
+    memset(&busStatistics, 0, sizeof(busStatistics));
+    __enable_irq();
+}
+#endif
+
 /**
  * @brief ʼOLED, .
  * @param oledHandle oled,  @ref OLED_HandleTypedef.
  */
 void OLED_Init(OLED_HandleTypedef *oledHandle)
 {
+    static const uint8_t initCommands[] = {
+        0xAE,//--display off
+        0x2E,//--deactivate scroll
+        0x00,//---set low column address
+        0x10,//---set high column address
+        0x40,//--set start line address  
+        0xB0,//--set page address
+        0x81, OLED_BRIGHTNESS,//contract control
+        0xA1,//set segment remap 
+        0xA6,//--normal / reverse
+        0xA8, 0x3F,//--set multiplex ratio(1 to 64)
+        0xC8,//Com scan direction
+        0xD3, 0x00,//-set display offset
+        0xD5, 0x80,//set osc division
+        0xD8, 0x05,//set area color mode off
+        0xD9, 0xF1,//Set Pre-Charge Period
+        0xDA, 0x12,//set com pin configuartion
+        0xDB, 0x30,//set Vcomh
+        0x8D, 0x14,//set charge pump enable
+        0xAF//--turn on oled panel
+    };
     OLED_IIC_Init();
     UTILS_DelayMs(150);
-    OLED_WriteCommand(0xAE);//--display off
-    OLED_WriteCommand(0x00);//---set low column address
-    OLED_WriteCommand(0x10);//---set high column address
-    OLED_WriteCommand(0x40);//--set start line address  
-    OLED_WriteCommand(0xB0);//--set page address
-    OLED_WriteCommand(0x81);//contract control
-    OLED_WriteCommand(OLED_BRIGHTNESS);//--256
-    OLED_WriteCommand(0xA1);//set segment remap 
-    OLED_WriteCommand(0xA6);//--normal / reverse
-    OLED_WriteCommand(0xA8);//--set multiplex ratio(1 to 64)
-    OLED_WriteCommand(0x3F);//--1/32 duty
-    OLED_WriteCommand(0xC8);//Com scan direction
-    OLED_WriteCommand(0xD3);//-set display offset
-    OLED_WriteCommand(0x00);
-    OLED_WriteCommand(0xD5);//set osc division
-    OLED_WriteCommand(0x80);
-    OLED_WriteCommand(0xD8);//set area color mode off
-    OLED_WriteCommand(0x05);
-    OLED_WriteCommand(0xD9);//Set Pre-Charge Period
-    OLED_WriteCommand(0xF1);
-    OLED_WriteCommand(0xDA);//set com pin configuartion
-    OLED_WriteCommand(0x12);
-    OLED_WriteCommand(0xDB);//set Vcomh
-    OLED_WriteCommand(0x30);
-    OLED_WriteCommand(0x8D);//set charge pump enable
-    OLED_WriteCommand(0x14);
-    OLED_WriteCommand(0xAF);//--turn on oled panel
+    OLED_WriteCommands(initCommands, sizeof(initCommands));
+    topPage = 0;//ʼеʾʼһ
+    scrollActive = 0;
     OLED_Clear(oledHandle);
+    OLED_Flush();
 }
 
 /**
- * @brief д.
- * @param command .
+ * @brief һIICд.
+ * @param commands .
+ * @param length ֽ.
  * @return 0-; 1-.
  */
-static uint8_t OLED_WriteCommand(uint8_t command)
+static uint8_t OLED_WriteCommands(const uint8_t *commands, uint8_t length)
 {
-    OLED_IIC_Start();
-    OLED_IIC_WriteByte(OLED_IIC_ADDRESS);//Slave address,SA0=0
-    if(OLED_IIC_WaitAck())//ȴӦ
-    {
-        OLED_IIC_Stop();         
-        return 1;        
-    }
-    OLED_IIC_WriteByte(0x00);//write command
-    if(OLED_IIC_WaitAck())//ȴӦ
-    {
-        OLED_IIC_Stop();         
-        return 1;        
-    }
-    OLED_IIC_WriteByte(command); 
-    if(OLED_IIC_WaitAck())//ȴӦ
-    {
-        OLED_IIC_Stop();         
-        return 1;        
-    }
-    OLED_IIC_Stop();
-    return 0;
+    return OLED_Transmit(0x00, commands, length, NULL, 0);
 }
 
 /**
- * @brief д.
- * @param data .
- * @return 0-; 1-.
+ * @brief ָһҳеһԴ.
+ * @param page ҳ(0~7).
+ * @param beginX ʼ(0~127).
+ * @param endX , (1~128).
+ * @param fillData Ҫ.
  */
-static uint8_t OLED_WriteData(uint8_t data)
+static inline void OLED_FillSpan(uint8_t page, uint8_t beginX, uint8_t endX, uint8_t fillData)
 {
-    OLED_IIC_Start();
-    OLED_IIC_WriteByte(OLED_IIC_ADDRESS);//D/C#=0; R/W#=0
-    if(OLED_IIC_WaitAck())//ȴӦ
-    {
-        OLED_IIC_Stop();         
-        return 1;        
-    }
-    OLED_IIC_WriteByte(0x40);//write data
-    if(OLED_IIC_WaitAck())//ȴӦ
-    {
-        OLED_IIC_Stop();         
-        return 1;        
-    }
-    OLED_IIC_WriteByte(data);
-    if(OLED_IIC_WaitAck())//ȴӦ
-    {
-        OLED_IIC_Stop();         
-        return 1;        
-    }
-    OLED_IIC_Stop();
-    return 0;
+    if(beginX >= endX)
+        return;
+    memset(gRam[page] + beginX, fillData, endX - beginX);
+    OLED_MarkDirty(page, beginX, endX);
 }
 
-
 /**
  * @brief ȫ.
  * @param fillData Ҫ.
  */
 void OLED_FillScreen(uint8_t fillData)
 {
-    uint8_t m, n;
+    uint8_t m;
     for(m = 0; m < OLED_PAGES; m++)
+        OLED_FillSpan(m, 0, OLED_WIDTH, fillData);
+}
+
+/**
+ * @brief OLED.
+ */
+void OLED_TurnOn()
+{
+    static const uint8_t commands[] = {
+        0X8D,//SET DCDC
+        0X14,//DCDC ON
+        0XAF//DISPLAY ON
+    };
+    OLED_WriteCommands(commands, sizeof(commands));
+}
+
+/**
+ * @brief رOLED.
+ */  
+void OLED_TurnOff()
+{
+    static const uint8_t commands[] = {
+        0X8D,//SET DCDC
+        0X10,//DCDC OFF
+        0XAE//DISPLAY OFF
+    };
+    OLED_WriteCommands(commands, sizeof(commands));
+}
+
+/**
+ * @brief Դ0ҳӦĻһ, ʾʼй㲢ȫط.
+ * @note ӲҳΧOLEDԴҳַ, ʼйĻҳһ.
+ */
+static void OLED_ResetTopPage()
+{
+    uint8_t row[OLED_WIDTH];
+    uint8_t m;
+    if(topPage == 0)
+        return;
+    while(OLED_IsFlushing());//첽ˢжжԴ, ƶ
+    for(; topPage; topPage--)
     {
-        OLED_WriteCommand(0xb0 + m);//page0-page1
-        OLED_WriteCommand(0x00);//low column start address
-        OLED_WriteCommand(0x10);//high column start address
-        for(n = 0; n < OLED_WIDTH; n++)
-        {
-            OLED_WriteData(fillData);
-            gRam[m][n] = fillData;
-        }
+        memcpy(row, gRam[0], OLED_WIDTH);
+        memmove(gRam[0], gRam[1], (OLED_PAGES - 1) * OLED_WIDTH);
+        memcpy(gRam[OLED_PAGES - 1], row, OLED_WIDTH);
     }
+    for(m = 0; m < OLED_PAGES; m++)
+        OLED_MarkDirty(m, 0, OLED_WIDTH);
+    startLinePending = 1;
 }
 
 /**
- * @brief .
- * @param x (0~127).
- * @param y ҳ(0~7).
+ * @brief ʼӲĹ.
+ * @param beginY ʼҳ(0~7).
+ * @param endY ҳ(0~7), .
+ * @param commands , .
+ * @param length ֽ.
+ * @param vertical Ƿֱ.
+ * @return 0-; 1-.
  */
-static inline void OLED_SetPosition(uint8_t x, uint8_t y)
-{     
-    OLED_WriteCommand(0xb0 + y);
-    OLED_WriteCommand(((x & 0xf0) >> 4) | 0x10);
-    OLED_WriteCommand((x & 0x0f));
+static uint8_t OLED_StartScrollCommands(uint8_t beginY, uint8_t endY, const uint8_t *commands, uint8_t length, uint8_t vertical)
+{
+    static const uint8_t activate = 0x2F;
+    if(scrollActive)
+        OLED_StopScroll();
+    OLED_ResetTopPage();
+    if(OLED_Flush())//ʼǰԴѾȫ
+        return 1;
+    scrollBeginPage = beginY;
+    scrollEndPage = endY;
+    scrollVertical = vertical;
+    if(OLED_WriteCommands(commands, length) || OLED_WriteCommands(&activate, 1))
+        return 1;
+    scrollActive = 1;
+    return 0;
 }
 
 /**
- * @brief OLED.
+ * @brief ʼˮƽ, OLEDԼƶ, ռCPUIIC.
+ * @param beginY ʼҳ(0~7).
+ * @param endY ҳ(beginY~7), .
+ * @param direction ,  @ref OLED_ScrollDirectionTypedef.
+ * @param interval ÿƶһм֡,  @ref OLED_ScrollIntervalTypedef.
+ * @return 0-; 1-.
+ * @note ȰҪʾٵ. ʼǰԴȫˢµOLED.
+ *       ڼ޸ĹԴ治ʾ, ֹͣˢʱŷ.
+ *       ڼ䲻ҪOLED_DisplayLog, ֮ƶ.
  */
-void OLED_TurnOn()
+uint8_t OLED_StartScroll(uint8_t beginY, uint8_t endY, OLED_ScrollDirectionTypedef direction, OLED_ScrollIntervalTypedef interval)
 {
-    OLED_WriteCommand(0X8D);//SET DCDC
-    OLED_WriteCommand(0X14);//DCDC ON
-    OLED_WriteCommand(0XAF);//DISPLAY ON
+    uint8_t commands[] = {
+        0x2E,//ֹͣ޸
+        direction == OLED_ScrollLeft ? 0x27 : 0x26,//ˮƽ
+        0x00,
+        beginY,//ʼҳ
+        interval,//֡
+        endY,//ҳ
+        0x00,
+        0xFF
+    };
+    if(beginY > endY || endY >= OLED_PAGES)
+        return 1;
+    return OLED_StartScrollCommands(beginY, endY, commands, sizeof(commands), 0);
 }
 
 /**
- * @brief رOLED.
- */  
-void OLED_TurnOff()
+ * @brief ʼб, ָҳˮƽƶ, ͬʱĻֱƶ.
+ * @param beginY ˮƽʼҳ(0~7).
+ * @param endY ˮƽĽҳ(beginY~7), .
+ * @param direction ˮƽ,  @ref OLED_ScrollDirectionTypedef.
+ * @param interval ÿƶ֡,  @ref OLED_ScrollIntervalTypedef.
+ * @param verticalOffset ÿֱƶ(1~63).
+ * @return 0-; 1-.
+ * @note ͬ @ref OLED_StartScroll, ڼĻˢ.
+ */
+uint8_t OLED_StartDiagonalScroll(uint8_t beginY, uint8_t endY, OLED_ScrollDirectionTypedef direction, OLED_ScrollIntervalTypedef interval, uint8_t verticalOffset)
+{
+    uint8_t commands[] = {
+        0x2E,//ֹͣ޸
+        0xA3, 0x00, OLED_HEIGHT,//ֱΪĻ
+        direction == OLED_ScrollLeft ? 0x2A : 0x29,//ֱˮƽ
+        0x00,
+        beginY,//ʼҳ
+        interval,//֡
+        endY,//ҳ
+        verticalOffset//ֱƫ
+    };
+    if(beginY > endY || endY >= OLED_PAGES || verticalOffset == 0 || verticalOffset >= OLED_HEIGHT)
+        return 1;
+    return OLED_StartScrollCommands(beginY, endY, commands, sizeof(commands), 1);
+}
+
+/**
+ * @brief ֹͣӲ.
+ * @return 0-; 1-.
+ * @note ֹͣOLEDԴеĹѾλ, ΪҪط,
+ *       OLED_FlushָΪǰĻϹڼ޸.
+ */
+uint8_t OLED_StopScroll()
+{
+    static const uint8_t deactivate = 0x2E;
+    uint8_t m;
+    if(!scrollActive)
+        return 0;
+    if(OLED_WriteCommands(&deactivate, 1))
+        return 1;
+    for(m = 0; m < OLED_PAGES; m++)
+    {
+        if(OLED_IsPageScrolling(m))
+            OLED_MarkDirty(m, 0, OLED_WIDTH);
+    }
+    if(scrollVertical)
+        startLinePending = 1;//ֱıʾʼ
+    scrollActive = 0;
+    return 0;
+}
+
+/**
+ * @brief ǷӲ.
+ * @return 0-; 1-.
+ */
+uint8_t OLED_IsScrolling()
 {
-    OLED_WriteCommand(0X8D);//SET DCDC
-    OLED_WriteCommand(0X10);//DCDC OFF
-    OLED_WriteCommand(0XAE);//DISPLAY OFF
+    return scrollActive;
 }
 
 /**
@@ -497,18 +844,7 @@ void OLED_TurnOff()
  */
 void OLED_Clear(OLED_HandleTypedef *oledHandle)
 {  
-    uint8_t m, n;            
-    for(m = 0; m < OLED_PAGES; m++)  
-    {  
-        OLED_WriteCommand(0xb0 + m);//ҳַ0~7
-        OLED_WriteCommand(0x00);//ʾλáе͵ַ
-        OLED_WriteCommand(0x10);//ʾλáиߵַ   
-        for(n = 0; n < OLED_WIDTH; n++)
-        {
-            OLED_WriteData(0);
-            gRam[m][n] = 0;
-        }
-    } //ʾ
+    OLED_FillScreen(0);
     oledHandle->stringX = 0;
     oledHandle->stringY = 0;
 }
@@ -519,18 +855,7 @@ void OLED_Clear(OLED_HandleTypedef *oledHandle)
  */
 void OLED_Blank()
 {  
-    uint8_t m,n;            
-    for(m = 0; m < OLED_PAGES; m++)  
-    {  
-        OLED_WriteCommand(0xb0 + m);//ҳַ0~7
-        OLED_WriteCommand(0x00);//ʾλáе͵ַ
-        OLED_WriteCommand(0x10);//ʾλáиߵַ   
-        for(n = 0; n < OLED_WIDTH; n++)
-        {
-            OLED_WriteData(1);
-            gRam[m][n] = 1;
-        }
-    } //ʾ
+    OLED_FillScreen(0xFF);
 }
 
 /**
@@ -543,62 +868,327 @@ void OLED_Blank()
 static inline void OLED_DisplayCharacter(uint8_t positionX, uint8_t positionY, uint8_t character, uint8_t characterSize)
 {
     uint32_t characterOffset = (uint32_t)(character - ' ');//õƫƺֵ
-    uint8_t i;
-    OLED_SetPosition(positionX, positionY);
+    uint8_t i, page = OLED_PAGE(positionY);
     for(i = 0; i < OLED_CHARACTER_WIDTH; i++)
-    {
-        OLED_WriteData(F6x8[characterOffset][i]);
-        gRam[positionY][positionX + i] = F6x8[characterOffset][i];
-    }
-    
+        gRam[page][positionX + i] = F6x8[characterOffset][i];
+    OLED_MarkDirty(page, positionX, positionX + OLED_CHARACTER_WIDTH);
 }
 
 static inline void OLED_ClearString(uint8_t beginX, uint8_t beginY, uint8_t endX, uint8_t endY)
 {
-    uint8_t i, j;
+    uint8_t j;
     beginX = (beginX << 1) + (beginX << 2);
     endX = (endX << 1) + (endX << 2);
+    if(endY > OLED_PAGES - 1)
+    {
+        endY = OLED_PAGES - 1;
+        endX = OLED_WIDTH;
+    }
+    if(beginY > endY)
+        return;
     if(endY != beginY)
     {
-        OLED_WriteCommand(0xb0 | beginY);//ҳַ
-        OLED_WriteCommand(0x00 | (beginX & 0x0F));//ʾλáе͵ַ
-        OLED_WriteCommand(0x10 | (beginX >> 4));//ʾλáиߵַ   
-        for(j = beginX; j < 128; j++)
+        OLED_FillSpan(OLED_PAGE(beginY), beginX, OLED_WIDTH, 0);
+        for(j = beginY + 1; j < endY; j++)
+            OLED_FillSpan(OLED_PAGE(j), 0, OLED_WIDTH, 0);
+        OLED_FillSpan(OLED_PAGE(endY), 0, endX, 0);
+    }
+    else
+    {
+        OLED_FillSpan(OLED_PAGE(beginY), beginX, endX, 0);
+    }
+}
+
+/**
+ * @brief ޷תΪַ, Ӻǰ뻺.
+ * @param p ĩβ.
+ * @param value Ҫת.
+ * @param base , 1016.
+ * @param upperCase 16ʱǷôдĸ.
+ * @return һַλ.
+ */
+static char *OLED_FormatUnsigned(char *p, uint32_t value, uint8_t base, uint8_t upperCase)
+{
+    const char *digits = upperCase ? "0123456789ABCDEF" : "0123456789abcdef";
+    do
+    {
+        *--p = digits[value % base];
+        value /= base;
+    }while(value);
+    return p;
+}
+
+/**
+ * @brief Ѷ򸡵תΪַ, Ӻǰ뻺.
+ * @param p ĩβ.
+ * @param integer .
+ * @param fraction Сֳ10precisionη.
+ * @param precision Сλ.
+ * @return һַλ.
+ */
+static char *OLED_FormatDecimal(char *p, uint32_t integer, uint32_t fraction, uint8_t precision)
+{
+    if(precision)
+    {
+        while(precision--)
         {
-            OLED_WriteData(0);
-            gRam[beginY][j] = 0;
+            *--p = '0' + fraction % 10;
+            fraction /= 10;
         }
-        for(j = beginY + 1; j < endY; j++)
+        *--p = '.';
+    }
+    return OLED_FormatUnsigned(p, integer, 10, 0);
+}
+
+/**
+ * @brief ʽַputCharacter, ַ.
+ * @param oledHandle oled, putCharacter.
+ * @param putCharacter ÿַĺ.
+ * @param format ʽַ, ֧%c %s %d %i %u %x %X %q %f %%,
+ *               ־'-' '0' '+' ' ', , , '*', hl(32λƽ̨Ϻ).
+ *               %qQ16.16ʽint32_t, Ĭ4λ, 4λ.
+ *               %fҪOLED_FORMAT_FLOATΪ1, float, Ĭ6λ, 6λ; '?'.
+ * @param aptr б.
+ */
+static void OLED_Format(OLED_HandleTypedef *oledHandle, OLED_PutCharacterHandler putCharacter, const char *format, va_list aptr)
+{
+    static const uint32_t powersOf10[] = {1, 10, 100, 1000, 10000, 100000, 1000000};
+    char digits[OLED_FORMAT_DIGITS];//һַ, Ӻǰ
+    char *p;
+    const char *string;
+    char sign, pad;
+    uint8_t leftAlign;
+    int32_t width, precision, length, signedValue;
+    uint32_t value, fraction;
+#if OLED_FORMAT_FLOAT == 1
+    float floatValue;
+#endif
+
+    for(; *format != '\0'; format++)
+    {
+        if(*format != '%')
+        {
+            putCharacter(oledHandle, *format);
+            continue;
+        }
+        //־
+        leftAlign = 0;
+        pad = ' ';
+        sign = 0;
+        for(format++; ; format++)
         {
-            OLED_WriteCommand(0xb0 | j);//ҳַ
-            OLED_WriteCommand(0x00);//ʾλáе͵ַ
-            OLED_WriteCommand(0x10);//ʾλáиߵַ   
-            for(i = 0; i < OLED_WIDTH; i++)
+            if(*format == '-')
+                leftAlign = 1;
+            else if(*format == '0')
+                pad = '0';
+            else if(*format == '+')
+                sign = '+';
+            else if(*format == ' ' && sign != '+')
+                sign = ' ';
+            else
+                break;
+        }
+        //
+        width = 0;
+        if(*format == '*')
+        {
+            width = va_arg(aptr, int);
+            if(width < 0)
             {
-                OLED_WriteData(0);
-                gRam[j][i] = 0;
+                leftAlign = 1;
+                width = -width;
             }
+            format++;
         }
-        OLED_WriteCommand(0xb0 | endY);//ҳַ
-        OLED_WriteCommand(0x00);//ʾλáе͵ַ
-        OLED_WriteCommand(0x10);//ʾλáиߵַ   
-        for(j = 0; j <= endX; j++)
+        else
         {
-            OLED_WriteData(0);
-            gRam[endY][j] = 0;
+            while(*format >= '0' && *format <= '9')
+                width = width * 10 + (*format++ - '0');
         }
-    }
-    else
-    {
-        OLED_WriteCommand(0xb0 | beginY);//ҳַ
-        OLED_WriteCommand(0x00 | (beginX & 0x0F));//ʾλáе͵ַ
-        OLED_WriteCommand(0x10 | (beginX >> 4));//ʾλáиߵַ   
-        for(j = beginX; j <= endX; j++)
+        //
+        precision = -1;
+        if(*format == '.')
+        {
+            precision = 0;
+            if(*++format == '*')
+            {
+                precision = va_arg(aptr, int);
+                format++;
+            }
+            else
+            {
+                while(*format >= '0' && *format <= '9')
+                    precision = precision * 10 + (*format++ - '0');
+            }
+        }
+        //
+        while(*format == 'h' || *format == 'l')
+            format++;
+        
+        p = digits + sizeof(digits);
+        string = p;
+        switch(*format)
+        {
+            case '\0':
+                return;
+            case 'c':
+                *--p = (char)va_arg(aptr, int);
+                sign = 0;
+                break;
+            case 's':
+                string = va_arg(aptr, const char *);
+                if(string == NULL)
+                    string = "(null)";
+                for(length = 0; string[length] != '\0' && (precision < 0 || length < precision); length++);
+                sign = 0;
+                pad = ' ';
+                break;
+            case 'd':
+            case 'i':
+                signedValue = va_arg(aptr, int32_t);
+                if(signedValue < 0)
+                    sign = '-';
+                p = OLED_FormatUnsigned(p, signedValue < 0 ? -(uint32_t)signedValue : (uint32_t)signedValue, 10, 0);
+                break;
+            case 'u':
+            case 'x':
+            case 'X':
+                value = va_arg(aptr, uint32_t);
+                p = OLED_FormatUnsigned(p, value, *format == 'u' ? 10 : 16, *format == 'X');
+                sign = 0;
+                break;
+            case 'q':
+                signedValue = va_arg(aptr, int32_t);
+                if(signedValue < 0)
+                    sign = '-';
+                value = signedValue < 0 ? -(uint32_t)signedValue : (uint32_t)signedValue;
+                if(precision < 0 || precision > 4)
+                    precision = 4;
+                fraction = ((value & 0xFFFF) * powersOf10[precision] + 0x8000) >> 16;//
+                value >>= 16;
+                if(fraction >= powersOf10[precision])
+                {
+                    fraction -= powersOf10[precision];
+                    value++;
+                }
+                p = OLED_FormatDecimal(p, value, fraction, precision);
+                precision = -1;
+                break;
+            case 'f':
+#if OLED_FORMAT_FLOAT == 1
+                floatValue = (float)va_arg(aptr, double);
+                if(floatValue != floatValue)
+                {
+                    string = "nan";
+                }
+                else
+                {
+                    if(floatValue < 0)
+                    {
+                        sign = '-';
+                        floatValue = -floatValue;
+                    }
+                    if(floatValue >= 4294967040.0f)//uint32_tΧ
+                    {
+                        string = "inf";
+                        break;
+                    }
+                    if(precision < 0 || precision > 6)
+                        precision = 6;
+                    value = (uint32_t)floatValue;
+                    fraction = (uint32_t)((floatValue - (float)value) * (float)powersOf10[precision] + 0.5f);
+                    if(fraction >= powersOf10[precision])
+                    {
+                        fraction -= powersOf10[precision];
+                        value++;
+                    }
+                    p = OLED_FormatDecimal(p, value, fraction, precision);
+                    precision = -1;
+                }
+#else
+                (void)va_arg(aptr, double);
+                *--p = '?';
+                sign = 0;
+#endif
+                break;
+            default://%%
+                *--p = *format;
+                sign = 0;
+                break;
+        }
+        if(string == digits + sizeof(digits))//
+        {
+            while(digits + sizeof(digits) - p < precision && p > digits)//ľȱʾλ
+                *--p = '0';
+            string = p;
+            length = digits + sizeof(digits) - p;
+        }
+        else if(*format != 's')//nan, inf
         {
-            OLED_WriteData(0);
-            gRam[beginY][j] = 0;
+            length = 3;
+            pad = ' ';
         }
+        width -= length + (sign != 0);
+        if(!leftAlign && pad == ' ')
+            for(; width > 0; width--)
+                putCharacter(oledHandle, ' ');
+        if(sign)
+            putCharacter(oledHandle, sign);
+        if(!leftAlign)
+            for(; width > 0; width--)
+                putCharacter(oledHandle, '0');
+        while(length--)
+            putCharacter(oledHandle, *string++);
+        for(; width > 0; width--)
+            putCharacter(oledHandle, ' ');
+    }
+}
+
+/**
+ * @brief OLED_DisplayFormatʾַ.
+ * @param oledHandle oled,  @ref OLED_HandleTypedef.
+ * @param character Ҫʾַ, ֧\r \n \t.
+ */
+static void OLED_FormatPutCharacter(OLED_HandleTypedef *oledHandle, char character)
+{
+    static uint8_t needYPlus = 1;//βԶ\r\nظִֻһλ 0-\r\n
+    uint8_t x = oledHandle->__stringX;//ǰ(0~20)
+    uint8_t y = oledHandle->__stringY;//ǰ(0~7)
+    switch(character)
+    {
+        case '\r':
+            x = 0;//س\rǻص
+            break;
+        case '\n':
+            if(needYPlus)//ʱ++y\n
+                y++;
+            needYPlus = 1;//ٺ´λ
+            break;
+        case '\t':
+            needYPlus = 1;//β\tٺ\n, Ϊʱѵһ
+            x = tabLookUpTable[x];//ҵҪλ
+            if(x >= OLED_CHARACTERS_ONE_LINE - 1)//\t󳬹ұ߽
+            {
+                x = 0;
+                y++;
+            }
+            break;
+        default://ǿַ, Ҫӡַ
+            needYPlus = 1;//βӡһַٺ\n, Ϊӡѵһ
+
+            //(x << 1) + (x << 2)x * 6, һַ6
+            OLED_DisplayCharacter((x << 1) + (x << 2), y > 7 ? 7 : y, character, 8);
+            
+            if(++x == OLED_CHARACTERS_ONE_LINE)//βԶвһ\nз
+            {
+                x = 0;
+                y++;
+                needYPlus = 0;
+            }
+            break;
     }
+    oledHandle->__stringX = x;
+    oledHandle->__stringY = y;
 }
 
 /**
@@ -606,15 +1196,13 @@ static inline void OLED_ClearString(uint8_t beginX, uint8_t beginY, uint8_t endX
  * @param oledHandle oled,  @ref OLED_HandleTypedef.
  * @param positionX (0~127).
  * @param positionY ҳ(0~7).
- * @param format ʽַ.
+ * @param format ʽַ,  @ref OLED_Format.
  * @param ... 㶮.
+ * @note ߸ʽдԴ, ַ.
+ *       ֻ޸Դ, OLED_Flushʾ.
  */
 void OLED_DisplayFormat(OLED_HandleTypedef *oledHandle, const char *format, ...)
 {
-    static uint8_t needYPlus = 1;//βԶ\r\nظִֻһλ 0-\r\n
-    uint8_t x = 0;//ǰ(0~20)
-    uint8_t y = 0;//ǰ(0~7)
-    uint8_t i = 0;
     va_list aptr;
  
     if(oledHandle == NULL)
@@ -627,224 +1215,536 @@ void OLED_DisplayFormat(OLED_HandleTypedef *oledHandle, const char *format, ...)
         oledHandle->stringClear = DISABLE;
     }
     
-    va_start(aptr, format);
-    vsprintf(oledHandle->__string, format, aptr);
-    va_end(aptr);
-    
     if(oledHandle->stringContinuous == ENABLE)
     {
-        x = oledHandle->__stringLastEndX;
-        y = oledHandle->__stringLastEndY;
+        oledHandle->__stringX = oledHandle->__stringLastEndX;
+        oledHandle->__stringY = oledHandle->__stringLastEndY;
     }
     else
     {
-        x = oledHandle->stringX;
-        y = oledHandle->stringY;
+        oledHandle->__stringX = oledHandle->stringX;
+        oledHandle->__stringY = oledHandle->stringY;
     }
-    oledHandle->__stringLastBeignX = x;
-    oledHandle->__stringLastBeignY = y;
-    while (oledHandle->__string[i] != '\0')
-    { 
-        switch(oledHandle->__string[i])
-        {
-            case '\r':
-                x = 0;//س\rǻص
-                break;
-            case '\n':
-                if(needYPlus)//ʱ++y\n
-                    y++;
-                needYPlus = 1;//ٺ´λ
-                break;
-            case '\t':
-                needYPlus = 1;//β\tٺ\n, Ϊʱѵһ
-                x = tabLookUpTable[x];//ҵҪλ
-                if(x >= OLED_CHARACTERS_ONE_LINE - 1)//\t󳬹ұ߽
-                {
-                    x = 0;
-                    y++;
-                }
-                break;
-            default://ǿַ, Ҫӡַ
-                needYPlus = 1;//βӡһַٺ\n, Ϊӡѵһ
-
-                //(x << 1) + (x << 2)x * 6, һַ6
-                OLED_DisplayCharacter((x << 1) + (x << 2), y > 7 ? 7 : y, oledHandle->__string[i], 8);
-                
-                if(++x == OLED_CHARACTERS_ONE_LINE)//βԶвһ\nз
-                {
-                    x = 0;
-                    y++;
-                    needYPlus = 0;
-                }
-                break;
-        }
-        i++;
-    }
-    oledHandle->__stringLastEndX = x;
-    oledHandle->__stringLastEndY = y;
+    oledHandle->__stringLastBeignX = oledHandle->__stringX;
+    oledHandle->__stringLastBeignY = oledHandle->__stringY;
+    
+    va_start(aptr, format);
+    OLED_Format(oledHandle, OLED_FormatPutCharacter, format, aptr);
+    va_end(aptr);
+    
+    oledHandle->__stringLastEndX = oledHandle->__stringX;
+    oledHandle->__stringLastEndY = oledHandle->__stringY;
 }
 
 /**
- * @brief һ.
- * @param lineIndex 0ʼ.
+ * @brief Ļһ
  * @note һмһҳ߶, 8.
+ *       ԭһеԴҳΪµһ, ޸ʾʼ,
+ *       ˢʱֻ跢һµһҳ.
  */
-static inline void OLED_ClearLine(uint8_t lineIndex)
+static inline void OLED_ScrollUpOneLine()
 {
-    uint8_t n;
-    OLED_WriteCommand(0xb0 + lineIndex);//page0-page1
-    OLED_WriteCommand(0x00);//low column start address
-    OLED_WriteCommand(0x10);//high column start address
-    for(n = 0; n < OLED_WIDTH; n++)
-    {
-        OLED_WriteData(0);
-        gRam[lineIndex][n] = 0;
-    }
+    OLED_FillSpan(topPage, 0, OLED_WIDTH, 0);
+    topPage = (topPage + 1) & (OLED_PAGES - 1);
+    startLinePending = 1;
 }
 
 /**
- * @brief Ļһ
- * @note һмһҳ߶, 8
+ * @brief OLED_DisplayLogʾַ.
+ * @param oledHandle oled,  @ref OLED_HandleTypedef.
+ * @param character Ҫʾַ, ֧\r \n \t.
  */
-static inline void OLED_ScrollUpOneLine()
+static void OLED_LogPutCharacter(OLED_HandleTypedef *oledHandle, char character)
 {
-    uint8_t m, n;
-    for(m = 0; m < OLED_LINES - 1; m++)  
-    {  
-        OLED_WriteCommand(0xb0 + m);//ҳַ0~6
-        OLED_WriteCommand(0x00);//ʾλáе͵ַ
-        OLED_WriteCommand(0x10);//ʾλáиߵַ   
-        for(n = 0; n < OLED_WIDTH; n++)
-        {
-            gRam[m][n] = gRam[m + 1][n];
-            OLED_WriteData(gRam[m][n]);
-        }
-    } //ʾ
-    OLED_ClearLine(7);
+    static uint8_t linesScrollUp = 0;//ԭҪϹ
+    static uint8_t needYPlus = 1;//βԶ\r\nظִֻһλ 0-\r\n
+    uint8_t x = oledHandle->__stringX;//ǰ(0~20)
+    uint8_t y = oledHandle->__stringY;//ǰ(0~7)
+    switch(character)
+    {
+        case '\r':
+            x = 0;//س\rǻص
+            break;
+        case '\n':
+            if(needYPlus && (++y > OLED_LINES - 1))//ʱ++y\n
+                linesScrollUp++;//к󳬳Ļײ, ϶һ
+            needYPlus = 1;//ٺ´λ
+            break;
+        case '\t':
+            needYPlus = 1;//β\tٺ\n, Ϊʱѵһ
+            x = tabLookUpTable[x];//ҵҪλ
+            if((x >= OLED_CHARACTERS_ONE_LINE - 1) && (x = 0, ++y > OLED_LINES - 1))//\t󳬹ұ߽
+                linesScrollUp++;//к󳬳Ļײ, ϶һ
+            break;
+        default://ǿַ, Ҫӡַ
+            needYPlus = 1;//βӡһַٺ\n, Ϊӡѵһ
+            while(linesScrollUp)//ϹҪ
+            {
+                OLED_ScrollUpOneLine();
+                linesScrollUp--;
+            }
+            //(x << 1) + (x << 2)x * 6, һַ6
+            OLED_DisplayCharacter((x << 1) + (x << 2), y > (OLED_LINES - 1) ? (y = (OLED_LINES - 1)) : y, character, 8);
+            if((++x == OLED_CHARACTERS_ONE_LINE) && (x = needYPlus = 0, ++y > (OLED_LINES - 1)))//ס, βԶвһ\nз
+                linesScrollUp++;//к󳬳Ļײ, ϶һ
+            break;
+    }
+    oledHandle->__stringX = x;
+    oledHandle->__stringY = y;
 }
 
 /**
  * @brief ʾϢ.
  * @param oledHandle oled,  @ref OLED_HandleTypedef.
- * @param format ʽַ, ַֿ֧.
+ * @param format ʽַ, ַֿ֧,  @ref OLED_Format.
  * @param ... 㶮.
  * @note ʾ, ϸַһ׿ʼӡ; ָλÿʼ.
- *       Ϣʾʱԭʾһ,  CPUռø.
+ *       Ϣʾʱԭʾһ, Դ水ҳѭʹ, ÿһֻдһҳ.
  *       ֧Զ, ֶзwindowsͬ(crlf).
+ *       ֻ޸Դ, OLED_Flushʾ.
  */
 void OLED_DisplayLog(OLED_HandleTypedef *oledHandle, const char *format, ...)
 {
-    uint8_t x = 0;//ǰ(0~20)
-    uint16_t y = 0;//ǰ(0~7)
-    static uint8_t linesScrollUp = 0;//ԭҪϹ
-    static uint8_t needYPlus = 1;//βԶ\r\nظִֻһλ 0-\r\n
-    uint16_t i = 0;
     va_list aptr;
     
     if(oledHandle == NULL)
         return;
     
-    va_start(aptr, format);
-    vsprintf(oledHandle->__string, format, aptr);
-    va_end(aptr);
-
     if(oledHandle->stringContinuous == ENABLE)
     {
-        x = oledHandle->__stringLastEndX;
-        y = oledHandle->__stringLastEndY;
+        oledHandle->__stringX = oledHandle->__stringLastEndX;
+        oledHandle->__stringY = oledHandle->__stringLastEndY;
     }
     else
     {
-        x = oledHandle->stringX;
-        y = oledHandle->stringY;
+        oledHandle->__stringX = oledHandle->stringX;
+        oledHandle->__stringY = oledHandle->stringY;
     }
     
-    while (oledHandle->__string[i] != '\0')
-    { 
-        switch(oledHandle->__string[i])
+    va_start(aptr, format);
+    OLED_Format(oledHandle, OLED_LogPutCharacter, format, aptr);
+    va_end(aptr);
+    
+    oledHandle->__stringLastEndX = oledHandle->__stringX;
+    oledHandle->__stringLastEndY = oledHandle->__stringY;
+}
+
+
+/**
+ * @brief ȡ6x8.
+ */
+static uint8_t OLED_GetGlyph6x8(const OLED_FontTypedef *font, uint32_t code, OLED_GlyphTypedef *glyph)
+{
+    (void)font;//岻Ҫ
+    if(code < ' ' || code - ' ' >= sizeof(F6x8) / sizeof(F6x8[0]))
+        return 1;
+    glyph->width = 6;
+    glyph->height = 8;
+    glyph->columns = F6x8[code - ' '];
+    return 0;
+}
+
+/**
+ * @brief ȡ8x16.
+ */
+static uint8_t OLED_GetGlyph8x16(const OLED_FontTypedef *font, uint32_t code, OLED_GlyphTypedef *glyph)
+{
+    (void)font;
+    if(code < ' ' || code - ' ' >= sizeof(F8X16) / 16)
+        return 1;
+    glyph->width = 8;
+    glyph->height = 16;
+    glyph->columns = F8X16 + ((code - ' ') << 4);
+    return 0;
+}
+
+const OLED_FontTypedef OLED_Font6x8 = {8, OLED_GetGlyph6x8};//ASCII, 6x8
+const OLED_FontTypedef OLED_Font8x16 = {16, OLED_GetGlyph8x16};//ASCII, 8x16
+
+/**
+ * @brief ַнһַ.
+ * @param text ַ.
+ * @param code ַ, GBK˫ַֽΪ(ֽ << 8 | βֽ), UTF-8ַΪUnicode.
+ * @return һַλ.
+ * @note  @ref OLED_TEXT_ENCODING . Ķֽаֽڴ.
+ */
+static const char *OLED_DecodeCharacter(const char *text, uint32_t *code)
+{
+    const uint8_t *p = (const uint8_t *)text;
+#if OLED_TEXT_ENCODING == OLED_TEXT_ENCODING_UTF8
+    uint8_t length, i;
+    if(p[0] < 0x80)
+        length = 1, *code = p[0];
+    else if((p[0] & 0xE0) == 0xC0)
+        length = 2, *code = p[0] & 0x1F;
+    else if((p[0] & 0xF0) == 0xE0)
+        length = 3, *code = p[0] & 0x0F;
+    else if((p[0] & 0xF8) == 0xF0)
+        length = 4, *code = p[0] & 0x07;
+    else
+        length = 1, *code = p[0];
+    for(i = 1; i < length; i++)
+    {
+        if((p[i] & 0xC0) != 0x80)
         {
-            case '\r':
-                x = 0;//س\rǻص
-                break;
-            case '\n':
-                if(needYPlus && (++y > OLED_LINES - 1))//ʱ++y\n
-                    linesScrollUp++;//к󳬳Ļײ, ϶һ
-                needYPlus = 1;//ٺ´λ
-                break;
-            case '\t':
-                needYPlus = 1;//β\tٺ\n, Ϊʱѵһ
-                x = tabLookUpTable[x];//ҵҪλ
-                if((x >= OLED_CHARACTERS_ONE_LINE - 1) && (x = 0, ++y > OLED_LINES - 1))//\t󳬹ұ߽
-                    linesScrollUp++;//к󳬳Ļײ, ϶һ
-                break;
-            default://ǿַ, Ҫӡַ
-                needYPlus = 1;//βӡһַٺ\n, Ϊӡѵһ
-                while(linesScrollUp)//ϹҪ
-                {
-                    OLED_ScrollUpOneLine();
-                    linesScrollUp--;
-                }
-                //(x << 1) + (x << 2)x * 6, һַ6
-                OLED_DisplayCharacter((x << 1) + (x << 2), y > (OLED_LINES - 1) ? (y = (OLED_LINES - 1)) : y, oledHandle->__string[i], 8);
-                if((++x == OLED_CHARACTERS_ONE_LINE) && (x = needYPlus = 0, ++y > (OLED_LINES - 1)))//ס, βԶвһ\nз
-                    linesScrollUp++;//к󳬳Ļײ, ϶һ
-                break;
+            *code = p[0];
+            return text + 1;
         }
-        i++;
-    }
-    oledHandle->__stringLastEndX = x;
-    oledHandle->__stringLastEndY = y;
-}
-
-
-///**
-// * @brief ָλʾ
-// * @param positionX (0~127)
-// * @param positionY ҳ(0~7)
-// * @param number 
-// */
-//void OLED_DisplayChinese(uint8_t positionX, uint8_t positionY, uint8_t number)
-//{                      
-//    uint8_t i, address=0;
-//    OLED_SetPosition(positionX, positionY);    
-//    for(i = 0; i < 22; i++)
-//    {
-//        OLED_WriteData(Hzk[number << 1][i]);
-//        gRam[positionY][positionX + i] = Hzk[(number << 1) + 1][i];
-//        address += 1;
-//    }    
-//    OLED_SetPosition(positionX, positionY + 1);    
-//    for(i = 0; i < 16; i++)
-//    {    
-//        OLED_WriteData(Hzk[(number << 1) + 1][i]);
-//        gRam[positionY + 1][positionX + i] = Hzk[(number << 1) + 1][i];
-//        address += 1;
-//    }                    
-//}
+        *code = (*code << 6) | (p[i] & 0x3F);
+    }
+    return text + length;
+#else
+    if(p[0] >= 0x81 && p[1] >= 0x40)
+    {
+        *code = ((uint32_t)p[0] << 8) | p[1];
+        return text + 2;
+    }
+    *code = p[0];
+    return text + 1;
+#endif
+}
+
+/**
+ * @brief ָλʾַ.
+ * @param x ϽǺ, Ϊ.
+ * @param y Ͻ, Ϊ, 8ı.
+ * @param font ,  @ref OLED_Font6x8, @ref OLED_Font8x16 SD򿪵.
+ * @param text ַ,  @ref OLED_TEXT_ENCODING. '\n'һ, صʼ.
+ * @param color ɫ,  @ref OLED_DrawBitmap.
+ * @return һַ֮ĺ, ڽʾ.
+ * @note ûеַʾΪ'?', '?'Ҳûʱ. Ļַֻοǰ, .
+ *       ֻ޸Դ, OLED_Flushʾ.
+ */
+int16_t OLED_DisplayText(int16_t x, int16_t y, const OLED_FontTypedef *font, const char *text, OLED_ColorTypedef color)
+{
+    OLED_GlyphTypedef glyph;
+    uint32_t code;
+    int16_t beginX = x;
+    while(*text)
+    {
+        text = OLED_DecodeCharacter(text, &code);
+        if(code == '\n')
+        {
+            x = beginX;
+            y += font->height;
+            continue;
+        }
+        if(font->getGlyph(font, code, &glyph) && font->getGlyph(font, '?', &glyph))
+            continue;
+        if(x < OLED_WIDTH && y < OLED_HEIGHT && y + font->height > 0)
+            OLED_DrawBitmap(x, y, glyph.width, glyph.height, glyph.columns, color);
+        x += glyph.width;
+    }
+    return x;
+}
 
 /**
  * @brief ָλʾͼƬ
  * @param positionX (0~127)
  * @param positionY ҳ(0~7)
  * @param width ͼƬ()
- * @param width ͼƬ߶()
+ * @param height ͼƬ߶()
  * @param picture ҪʾͼƬ
+ * @note ĻĲֱõ. ֻ޸Դ, OLED_Flushʾ.
  */
 void OLED_DisplayPicture(uint8_t positionX, uint8_t positionY, uint8_t width, uint8_t height, uint8_t picture[])
 {     
-  uint32_t j = 0;
-  uint8_t x, y;
-  height += (positionY >> 3);
-  uint8_t endY = !(height % 8) ?  (height >> 3) : ((height >> 3) + 1) + positionY;
+  uint8_t y;
+  uint8_t endY = positionY + ((height + 7) >> 3);
   uint8_t endX = positionX + width;
+  if(positionX >= OLED_WIDTH)
+    return;
+  if(endY > OLED_PAGES)
+    endY = OLED_PAGES;
+  if(endX > OLED_WIDTH || endX < positionX)
+    endX = OLED_WIDTH;
   for(y = positionY; y < endY; y++)
   {
-    OLED_SetPosition(positionX, y);
-    for(x = positionX; x < endX; x++)
+    memcpy(gRam[OLED_PAGE(y)] + positionX, picture, endX - positionX);
+    OLED_MarkDirty(OLED_PAGE(y), positionX, endX);
+    picture += width;
+  }
+}
+
+/**
+ * @brief һҳһеͬĲ.
+ * @param page Դеҳ(0~7).
+ * @param beginX ʼ(0~127).
+ * @param endX , (1~128).
+ * @param mask Ҫ, ÿλӦһ.
+ * @param color ɫ,  @ref OLED_ColorTypedef.
+ * @note мĲÿδ4.
+ */
+static void OLED_ApplyMask(uint8_t page, uint8_t beginX, uint8_t endX, uint8_t mask, OLED_ColorTypedef color)
+{
+    uint32_t wordMask = mask * 0x01010101U;
+    uint32_t *word;
+    uint8_t x = beginX;
+    if(beginX >= endX || !mask)
+        return;
+    for(; x < endX && (x & 3); x++)
+        OLED_APPLY(gRam[page][x], mask, color);
+    for(word = &gRamWords[page][x >> 2]; x + 4 <= endX; x += 4, word++)
+        OLED_APPLY(*word, wordMask, color);
+    for(; x < endX; x++)
+        OLED_APPLY(gRam[page][x], mask, color);
+    OLED_MarkDirty(page, beginX, endX);
+}
+
+/**
+ * @brief һ.
+ * @param x (0~127), Ļʱ.
+ * @param y (0~63), Ļʱ.
+ * @param color ɫ,  @ref OLED_ColorTypedef.
+ * @note ֻ޸Դ, OLED_Flushʾ.
+ */
+void OLED_DrawPixel(int16_t x, int16_t y, OLED_ColorTypedef color)
+{
+    uint8_t page;
+    if(x < 0 || x >= OLED_WIDTH || y < 0 || y >= OLED_HEIGHT)
+        return;
+    page = OLED_PAGE(y >> 3);
+    OLED_APPLY(gRam[page][x], 1 << (y & 7), color);
+    OLED_MarkDirty(page, x, x + 1);
+}
+
+/**
+ * @brief ȡԴһ.
+ * @param x (0~127).
+ * @param y (0~63).
+ * @return 0-򳬳Ļ; 1-.
+ */
+uint8_t OLED_GetPixel(int16_t x, int16_t y)
+{
+    if(x < 0 || x >= OLED_WIDTH || y < 0 || y >= OLED_HEIGHT)
+        return 0;
+    return (gRam[OLED_PAGE(y >> 3)][x] >> (y & 7)) & 1;
+}
+
+/**
+ * @brief .
+ * @param x ϽǺ.
+ * @param y Ͻ.
+ * @param width ().
+ * @param height ߶().
+ * @param color ɫ,  @ref OLED_ColorTypedef.
+ * @note ĻĲֱõ. ֻ޸Դ, OLED_Flushʾ.
+ */
+void OLED_FillRectangle(int16_t x, int16_t y, int16_t width, int16_t height, OLED_ColorTypedef color)
+{
+    int16_t endX = x + width, endY = y + height;
+    uint8_t page, endPage, mask;
+    if(x < 0)
+        x = 0;
+    if(y < 0)
+        y = 0;
+    if(endX > OLED_WIDTH)
+        endX = OLED_WIDTH;
+    if(endY > OLED_HEIGHT)
+        endY = OLED_HEIGHT;
+    if(x >= endX || y >= endY)
+        return;
+    endPage = (endY - 1) >> 3;
+    for(page = y >> 3; page <= endPage; page++)
     {
-      OLED_WriteData(picture[j]);
-      gRam[y][x] = picture[j];
-      j++;
+        mask = 0xFF;
+        if(page == (y >> 3))
+            mask &= 0xFF << (y & 7);
+        if(page == endPage)
+            mask &= 0xFF >> (7 - ((endY - 1) & 7));
+        OLED_ApplyMask(OLED_PAGE(page), x, endX, mask, color);
+    }
+}
+
+/**
+ * @brief .
+ * @param x0 .
+ * @param y0 .
+ * @param x1 յ.
+ * @param y1 յ.
+ * @param color ɫ,  @ref OLED_ColorTypedef.
+ * @note ˮƽߺֱ߰, Bresenham㷨㻭.
+ *       ĻĲֱõ. ֻ޸Դ, OLED_Flushʾ.
+ */
+void OLED_DrawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, OLED_ColorTypedef color)
+{
+    int16_t dx, dy, stepX, stepY, error, error2;
+    if(y0 == y1 || x0 == x1)
+    {
+        OLED_FillRectangle(x0 < x1 ? x0 : x1, y0 < y1 ? y0 : y1,
+                           (x0 < x1 ? x1 - x0 : x0 - x1) + 1, (y0 < y1 ? y1 - y0 : y0 - y1) + 1, color);
+        return;
+    }
+    dx = x1 > x0 ? x1 - x0 : x0 - x1;
+    dy = y1 > y0 ? y0 - y1 : y1 - y0;//dyȡֵ
+    stepX = x0 < x1 ? 1 : -1;
+    stepY = y0 < y1 ? 1 : -1;
+    error = dx + dy;
+    for(;;)
+    {
+        OLED_DrawPixel(x0, y0, color);
+        if(x0 == x1 && y0 == y1)
+            break;
+        error2 = error << 1;
+        if(error2 >= dy)
+        {
+            error += dy;
+            x0 += stepX;
+        }
+        if(error2 <= dx)
+        {
+            error += dx;
+            y0 += stepY;
+        }
+    }
+}
+
+/**
+ * @brief α߿.
+ * @param x ϽǺ.
+ * @param y Ͻ.
+ * @param width ().
+ * @param height ߶().
+ * @param color ɫ,  @ref OLED_ColorTypedef.
+ * @note ĻĲֱõ. ֻ޸Դ, OLED_Flushʾ.
+ */
+void OLED_DrawRectangle(int16_t x, int16_t y, int16_t width, int16_t height, OLED_ColorTypedef color)
+{
+    if(width <= 0 || height <= 0)
+        return;
+    OLED_FillRectangle(x, y, width, 1, color);
+    if(height > 1)
+        OLED_FillRectangle(x, y + height - 1, width, 1, color);
+    if(height > 2)
+    {
+        OLED_FillRectangle(x, y + 1, 1, height - 2, color);
+        if(width > 1)
+            OLED_FillRectangle(x + width - 1, y + 1, 1, height - 2, color);
+    }
+}
+
+/**
+ * @brief ԲϹԲĶԳƵ4, غϵĵֻһ.
+ */
+static inline void OLED_DrawCirclePoints(int16_t centerX, int16_t centerY, int16_t x, int16_t y, OLED_ColorTypedef color)
+{
+    OLED_DrawPixel(centerX + x, centerY + y, color);
+    if(x)
+        OLED_DrawPixel(centerX - x, centerY + y, color);
+    if(y)
+        OLED_DrawPixel(centerX + x, centerY - y, color);
+    if(x && y)
+        OLED_DrawPixel(centerX - x, centerY - y, color);
+}
+
+/**
+ * @brief Բ.
+ * @param centerX Բĺ.
+ * @param centerY Բ.
+ * @param radius 뾶().
+ * @param color ɫ,  @ref OLED_ColorTypedef.
+ * @note е㻭Բ㷨, ÿֻһ, ɫʱҲȷ.
+ *       ĻĲֱõ. ֻ޸Դ, OLED_Flushʾ.
+ */
+void OLED_DrawCircle(int16_t centerX, int16_t centerY, int16_t radius, OLED_ColorTypedef color)
+{
+    int16_t x = 0, y = radius, d = 1 - radius;
+    if(radius < 0)
+        return;
+    while(x <= y)
+    {
+        OLED_DrawCirclePoints(centerX, centerY, x, y, color);
+        if(x != y)
+            OLED_DrawCirclePoints(centerX, centerY, y, x, color);
+        x++;
+        if(d < 0)
+        {
+            d += (x << 1) + 1;
+        }
+        else
+        {
+            y--;
+            d += ((x - y) << 1) + 1;
+        }
+    }
+}
+
+/**
+ * @brief Բ.
+ * @param centerX Բĺ.
+ * @param centerY Բ.
+ * @param radius 뾶().
+ * @param color ɫ,  @ref OLED_ColorTypedef.
+ * @note ֱ߶, ÿֻһ.
+ *       ĻĲֱõ. ֻ޸Դ, OLED_Flushʾ.
+ */
+void OLED_FillCircle(int16_t centerX, int16_t centerY, int16_t radius, OLED_ColorTypedef color)
+{
+    int32_t limit = (int32_t)radius * radius + radius;//radiusʹԵԲ
+    int16_t x, h = radius;
+    if(radius < 0)
+        return;
+    for(x = 0; x <= radius; x++)
+    {
+        while((int32_t)h * h + (int32_t)x * x > limit)
+            h--;
+        OLED_FillRectangle(centerX + x, centerY - h, 1, (h << 1) + 1, color);
+        if(x)
+            OLED_FillRectangle(centerX - x, centerY - h, 1, (h << 1) + 1, color);
+    }
+}
+
+/**
+ * @brief λʾλͼ.
+ * @param x ϽǺ, Ϊ.
+ * @param y Ͻ, Ϊ, 8ı.
+ * @param width λͼ().
+ * @param height λͼ߶().
+ * @param bitmap λͼ, ʽ @ref OLED_DisplayPicture ͬ: ҳ, ÿֽΪһ8, λ.
+ * @param color OLED_White-ʾ; OLED_Black-ɫʾ; OLED_Invert-ԭ.
+ * @note ĻĲֱõ. ֻ޸Դ, OLED_Flushʾ.
+ */
+void OLED_DrawBitmap(int16_t x, int16_t y, uint8_t width, uint8_t height, const uint8_t bitmap[], OLED_ColorTypedef color)
+{
+    uint8_t sourcePage, sourcePages = (height + 7) >> 3;
+    uint8_t sourceMask, shift, data, mask, page;
+    int16_t destinationY, destinationPage, column, beginColumn, endColumn;
+    const uint8_t *source;
+    
+    beginColumn = x < 0 ? -x : 0;
+    endColumn = x + width > OLED_WIDTH ? OLED_WIDTH - x : width;
+    if(beginColumn >= endColumn)
+        return;
+    for(sourcePage = 0; sourcePage < sourcePages; sourcePage++)
+    {
+        sourceMask = (height - (sourcePage << 3)) >= 8 ? 0xFF : (0xFF >> (8 - (height - (sourcePage << 3))));
+        destinationY = y + (sourcePage << 3);
+        destinationPage = destinationY < 0 ? -((7 - destinationY) >> 3) : destinationY >> 3;//ȡ
+        shift = destinationY - (destinationPage << 3);
+        source = bitmap + (uint16_t)sourcePage * width;
+        
+        //λͼһҳԴһҳҳ
+        if(destinationPage >= 0 && destinationPage < OLED_PAGES)
+        {
+            page = OLED_PAGE(destinationPage);
+            mask = sourceMask << shift;
+            for(column = beginColumn; column < endColumn; column++)
+            {
+                data = (source[column] & sourceMask) << shift;
+                OLED_APPLY_BITMAP(gRam[page][x + column], data, mask, color);
+            }
+            OLED_MarkDirty(page, x + beginColumn, x + endColumn);
+        }
+        if(shift && destinationPage + 1 >= 0 && destinationPage + 1 < OLED_PAGES)
+        {
+            page = OLED_PAGE(destinationPage + 1);
+            mask = sourceMask >> (8 - shift);
+            for(column = beginColumn; column < endColumn; column++)
+            {
+                data = (source[column] & sourceMask) >> (8 - shift);
+                OLED_APPLY_BITMAP(gRam[page][x + column], data, mask, color);
+            }
+            OLED_MarkDirty(page, x + beginColumn, x + endColumn);
+        }
     }
-  }
 }
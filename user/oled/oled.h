@@ -10,15 +10,32 @@
  *              2. Display formatted strings, pictures and Chinese characters
  *              3. Turn on/off the screen
  *              4. Show logs
+ *              5. Send modified regions of the frame buffer in bursts
+ *              6. Non-blocking frame commit by hardware I2C and DMA
+ *              7. Draw pixels, lines, rectangles, circles and bitmaps
+ *              8. Hardware continuous scroll for tickers
+ *              9. Display text in fixed or variable width fonts, 8 or 16 pixels tall
  * @note
  *          Minimum version of source file:
  *              0.1.0
- *          Pin connection:
+ *          Pin connection(OLED_USE_HARDWARE_IIC = 0, default):
  *               
  *              PC10SCL     
  *              PC11SDA     
  *               
  *          STM32F407      0.96" OLED
+ *          Pin connection(OLED_USE_HARDWARE_IIC = 1):
+ *               
+ *               PA8SCL     
+ *               PC9SDA     
+ *               
+ *          STM32F407      0.96" OLED
+ *          I2C3 has no other SDA pin on STM32F407VE, so the hardware mode
+ *          needs the OLED rewired from PC10/PC11 to PA8/PC9.
+ *          PC9~PC11 are also SDIO D1~D3: with the SD card, set
+ *          SD_USE_4BIT_BUS to 0 in sd.h, which leaves them to the OLED.
+ *          Define OLED_HOST and IIC_HOST to build oled.c on PC against an
+ *          emulated SSD1306, see tools/oled_emu.c.
  *          
  *          The source code repository is available on GitHub:
  *              https://github.com/3703781
@@ -32,19 +49,58 @@
 #ifndef __OLED_H
 #define __OLED_H
 
+#ifndef OLED_HOST
 #include "stm32f4xx.h" 
+#else
+#include "host_stm32.h"
+#endif
+
+#define OLED_USE_HARDWARE_IIC       0 //!< 1-ӲIIC+DMA, ĽPA8/PC9; 0-ģIIC
+#ifdef OLED_HOST
+#undef OLED_USE_HARDWARE_IIC
+#define OLED_USE_HARDWARE_IIC       0 //PCֻGPIOģ
+#endif
 
+#if OLED_USE_HARDWARE_IIC == 1
+#define OLED_I2C                    I2C3
+#define OLED_I2C_CLK                RCC_APB1Periph_I2C3
+#define OLED_I2C_SPEED              400000 //!< SCLƵ(Hz), 400kHz
+#define OLED_I2C_GPIO_AF            GPIO_AF_I2C3
+#define OLED_I2C_EV_IRQ_CHANNEL     I2C3_EV_IRQn
+#define OLED_I2C_EV_IRQ_HANDLER     I2C3_EV_IRQHandler
+#define OLED_I2C_ER_IRQ_CHANNEL     I2C3_ER_IRQn
+#define OLED_I2C_ER_IRQ_HANDLER     I2C3_ER_IRQHandler
+#define OLED_SCL_PORT               GPIOA
+#define OLED_SCL_PIN                GPIO_Pin_8
+#define OLED_SCL_PINSOURCE          GPIO_PinSource8
+#define OLED_SCL_GPIO_CLK           RCC_AHB1Periph_GPIOA
+#define OLED_SDA_PORT               GPIOC
+#define OLED_SDA_PIN                GPIO_Pin_9
+#define OLED_SDA_PINSOURCE          GPIO_PinSource9
+#define OLED_SDA_GPIO_CLK           RCC_AHB1Periph_GPIOC
+#define OLED_TX_DMA_CLK             RCC_AHB1Periph_DMA1
+#define OLED_TX_DMA_CHANNEL         DMA_Channel_3
+#define OLED_TX_DMA_STREAM          DMA1_Stream4
+#define OLED_TX_DMA_FLAGS           (DMA_FLAG_TCIF4 | DMA_FLAG_HTIF4 | DMA_FLAG_TEIF4 | DMA_FLAG_DMEIF4 | DMA_FLAG_FEIF4)
+#else
+#define OLED_I2C_SPEED              400000 //!< SCLƵ(Hz), 400kHz
 #define OLED_SCL_PORT               GPIOC
 #define OLED_SCL_PIN                GPIO_Pin_10
-#define OLED_SCL_GPIO_CLK           RCC_AHB1Periph_GPIOC
 #define OLED_SDA_PORT               GPIOC
 #define OLED_SDA_PIN                GPIO_Pin_11
-#define OLED_SDA_GPIO_CLK           RCC_AHB1Periph_GPIOC
-#define OLED_IIC_In()               OLED_SDA_PORT->MODER &= ~0x00C00000;OLED_SDA_PORT->MODER |= 0x00000000//ģʽ
-#define OLED_IIC_Out()              OLED_SDA_PORT->MODER &= ~0x00C00000;OLED_SDA_PORT->MODER |= 0x00400000//ģʽ
+#endif
 
 #define OLED_IIC_ADDRESS            0x78
 #define	OLED_BRIGHTNESS             255
+#define OLED_FORMAT_FLOAT           1 //!< 1-ʽַ֧%f; 0-֧, Ӹ
+#define OLED_USE_STATISTICS         0 //!< 1-ͳIICֽʱ, ڱȽ; 0-ͳ, ûκο
+#ifdef OLED_HOST
+#undef OLED_USE_STATISTICS
+#define OLED_USE_STATISTICS         1 //tools/oled_emu.cȶ
+#endif
+#define OLED_TEXT_ENCODING_GBK      0
+#define OLED_TEXT_ENCODING_UTF8     1
+#define OLED_TEXT_ENCODING          OLED_TEXT_ENCODING_GBK //!< OLED_DisplayTextַ, Դļһ
 
 
 /**
@@ -64,16 +120,111 @@ typedef struct {
     uint8_t __stringLastBeignY;//ϴδӡַʼλ
     uint8_t __stringLastEndX;//ϴδӡַλ
     uint8_t __stringLastEndY;//ϴδӡַλ
-    char __string[100];//ʵʴӡַ
 }OLED_HandleTypedef;
 
+/**
+ * @brief ͼɫ.
+ */
+typedef enum
+{
+    OLED_Black = 0,//Ϩ
+    OLED_White = 1,//
+    OLED_Invert = 2//ɫ
+}OLED_ColorTypedef;
+
+/**
+ * @brief IICͳ,  @ref OLED_USE_STATISTICS.
+ */
+typedef struct
+{
+    uint32_t transactions;//, ÿΪһʼźŵֹͣź
+    uint32_t bytes;//ֽ, ַͿֽ
+    uint32_t clocks;//SCLʱ, ʼֹͣźźӦλ
+    uint32_t busTimeUs;//OLED_I2C_SPEEDʱ(us)
+}OLED_StatisticsTypedef;
+
+/**
+ * @brief .
+ * @note ݸʽ @ref OLED_DisplayPicture ͬ: ҳ, ÿҳwidthֽ, ÿֽΪһ8, λ.
+ */
+typedef struct
+{
+    uint8_t width;//(), Ҳʾǰľ
+    uint8_t height;//߶(), 816
+    const uint8_t *columns;//
+}OLED_GlyphTypedef;
+
+typedef struct OLED_FontStruct OLED_FontTypedef;
+
+/**
+ * @brief .
+ * @note ȿͲȿ嶼ͨgetGlyphȡ, οԼ.
+ */
+struct OLED_FontStruct
+{
+    uint8_t height;//ָ(), 816
+    uint8_t (*getGlyph)(const OLED_FontTypedef *font, uint32_t code, OLED_GlyphTypedef *glyph);//ȡ, 0-ɹ; 1-ûиַ. ´εǰЧ
+};
+
+/**
+ * @brief Ӳˮƽ.
+ */
+typedef enum
+{
+    OLED_ScrollRight = 0,//
+    OLED_ScrollLeft = 1//
+}OLED_ScrollDirectionTypedef;
+
+/**
+ * @brief Ӳÿƶ֡, ȡֵΪSSD1306.
+ */
+typedef enum
+{
+    OLED_Scroll2Frames = 7,
+    OLED_Scroll3Frames = 4,
+    OLED_Scroll4Frames = 5,
+    OLED_Scroll5Frames = 0,
+    OLED_Scroll25Frames = 6,
+    OLED_Scroll64Frames = 1,
+    OLED_Scroll128Frames = 2,
+    OLED_Scroll256Frames = 3
+}OLED_ScrollIntervalTypedef;
+
+/**
+ * @brief 첽ˢʱõĻص.
+ * @param result 0-; 1-, δͳɹ´ˢ.
+ */
+typedef void (*OLED_FlushHandler)(uint8_t result);
+
+extern const OLED_FontTypedef OLED_Font6x8;
+extern const OLED_FontTypedef OLED_Font8x16;
 
 void OLED_Init(OLED_HandleTypedef *oledHandle);
 void OLED_TurnOn(void);
 void OLED_TurnOff(void);
 void OLED_Clear(OLED_HandleTypedef *oledHandle);
 void OLED_Blank(void);
+uint8_t OLED_Flush(void);
+uint8_t OLED_FlushAsync(OLED_FlushHandler flushHandler);
+uint8_t OLED_IsFlushing(void);
+#if OLED_USE_STATISTICS == 1
+void OLED_GetStatistics(OLED_StatisticsTypedef *statistics);
+void OLED_ResetStatistics(void);
+#endif
+uint8_t OLED_StartScroll(uint8_t beginY, uint8_t endY, OLED_ScrollDirectionTypedef direction, OLED_ScrollIntervalTypedef interval);
+uint8_t OLED_StartDiagonalScroll(uint8_t beginY, uint8_t endY, OLED_ScrollDirectionTypedef direction, OLED_ScrollIntervalTypedef interval, uint8_t verticalOffset);
+uint8_t OLED_StopScroll(void);
+uint8_t OLED_IsScrolling(void);
 void OLED_DisplayFormat(OLED_HandleTypedef *oledHandle, const char *format, ...);
 void OLED_DisplayLog(OLED_HandleTypedef *oledHandle, const char *format, ...);
 void OLED_DisplayPicture(uint8_t positionX, uint8_t positionY, uint8_t width, uint8_t height, uint8_t picture[]);
+int16_t OLED_DisplayText(int16_t x, int16_t y, const OLED_FontTypedef *font, const char *text, OLED_ColorTypedef color);
+void OLED_DrawPixel(int16_t x, int16_t y, OLED_ColorTypedef color);
+uint8_t OLED_GetPixel(int16_t x, int16_t y);
+void OLED_DrawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, OLED_ColorTypedef color);
+void OLED_DrawRectangle(int16_t x, int16_t y, int16_t width, int16_t height, OLED_ColorTypedef color);
+void OLED_FillRectangle(int16_t x, int16_t y, int16_t width, int16_t height, OLED_ColorTypedef color);
+void OLED_DrawCircle(int16_t centerX, int16_t centerY, int16_t radius, OLED_ColorTypedef color);
+void OLED_FillCircle(int16_t centerX, int16_t centerY, int16_t radius, OLED_ColorTypedef color);
+void OLED_DrawBitmap(int16_t x, int16_t y, uint8_t width, uint8_t height, const uint8_t bitmap[], OLED_ColorTypedef color);
 #endif 
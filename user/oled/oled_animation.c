@@ -0,0 +1,302 @@
+/**
+ * @file    oled_animation.c
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2019/08/12
+ * @brief   
+ *          This file provides functions to play compressed animations
+ *          stored on SD card:
+ *              1. Open & close animation files through FatFs
+ *              2. Decode frames into the frame buffer at a fixed frame rate
+ *              3. Playback statistics
+ * @note
+ *          Minimum version of header file:
+ *              0.1.0
+ *
+ *          The source code repository is available on GitHub:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+//    
+//    ֡ݰСֿ, ߶߽, ֻѱ仯ֽдԴ沢, ˢʱֻЩ
+//    ʱÿһ, һ֡ԤʱŽ, ʱ뼸֡һˢ
+
+#include "oled_animation.h"
+#include "sd.h"
+#include "utils.h"
+#include "string.h"
+
+#if SD_USE_4BIT_BUS == 1
+#error "SDIO D1~D3 (PC9~PC11) clash with the OLED pins, set SD_USE_4BIT_BUS to 0 in sd.h"
+#endif
+
+#define OLED_ANIMATION_HEADER_SIZE      8
+#define OLED_ANIMATION_FRAME_SIZE       1024 //!< һֽ֡, 128 x 8ҳ
+#define OLED_ANIMATION_END_OF_FRAME     0xFF
+
+static __IO uint32_t animationMs = 0;//ſʼĺ
+
+/**
+ * @brief ʱж, ÿһ.
+ */
+void OLED_ANIMATION_TIM_IRQ_HANDLER()
+{
+    if(OLED_ANIMATION_TIM->SR & TIM_IT_Update)
+    {
+        OLED_ANIMATION_TIM->SR = (uint16_t)~TIM_IT_Update;
+        animationMs++;
+    }
+}
+
+/**
+ * @brief ʼ1kHzʱ.
+ */
+static void OLED_InitAnimationTimer()
+{
+    TIM_TimeBaseInitTypeDef TIM_TimeBaseInitStructure;
+    NVIC_InitTypeDef NVIC_InitStructure;
+    uint32_t clock = (Apb1Clock == AhbClock) ? Apb1Clock : (Apb1Clock << 1);//APB1ƵʱʱʱӼӱ
+    
+    RCC_APB1PeriphClockCmd(OLED_ANIMATION_TIM_CLK, ENABLE);
+    TIM_DeInit(OLED_ANIMATION_TIM);
+    TIM_TimeBaseInitStructure.TIM_Prescaler = clock / 10000 - 1;//10kHz
+    TIM_TimeBaseInitStructure.TIM_Period = 10 - 1;//1kHz
+    TIM_TimeBaseInitStructure.TIM_ClockDivision = TIM_CKD_DIV1;
+    TIM_TimeBaseInitStructure.TIM_CounterMode = TIM_CounterMode_Up;
+    TIM_TimeBaseInitStructure.TIM_RepetitionCounter = 0;
+    TIM_TimeBaseInit(OLED_ANIMATION_TIM, &TIM_TimeBaseInitStructure);
+    TIM_ClearITPendingBit(OLED_ANIMATION_TIM, TIM_IT_Update);
+    TIM_ITConfig(OLED_ANIMATION_TIM, TIM_IT_Update, ENABLE);
+    
+    NVIC_InitStructure.NVIC_IRQChannel = OLED_ANIMATION_TIM_IRQ_CHANNEL;
+    NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 3;
+    NVIC_InitStructure.NVIC_IRQChannelSubPriority = 3;
+    NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+    NVIC_Init(&NVIC_InitStructure);
+}
+
+/**
+ * @brief ȡһֽ, ʱļһ.
+ * @return ֽ; -1-ļ.
+ */
+static inline int16_t OLED_ReadAnimationByte(OLED_AnimationTypedef *animation)
+{
+    UINT readLength;
+    if(animation->bufferIndex >= animation->bufferLength)
+    {
+        if(f_read(&animation->file, animation->buffer, OLED_ANIMATION_CHUNK_SIZE, &readLength) != FR_OK || readLength == 0)
+            return -1;
+        animation->bufferLength = readLength;
+        animation->bufferIndex = 0;
+    }
+    animation->statistics.bytes++;
+    return animation->buffer[animation->bufferIndex++];
+}
+
+/**
+ * @brief صһ֡, Դ.
+ * @return 0-; 1-.
+ */
+static uint8_t OLED_RewindAnimation(OLED_AnimationTypedef *animation)
+{
+    animation->bufferLength = 0;
+    animation->bufferIndex = 0;
+    animation->frameIndex = 0;
+    OLED_FillRectangle(0, 0, 128, 64, OLED_Black);//һ֡ڿհĻ
+    return f_lseek(&animation->file, OLED_ANIMATION_HEADER_SIZE) != FR_OK;
+}
+
+/**
+ * @brief һ֡Դ.
+ * @return 0-; 1-ݴļ.
+ */
+static uint8_t OLED_DecodeAnimationFrame(OLED_AnimationTypedef *animation)
+{
+    uint8_t data[64];
+    uint16_t position = 0;
+    int16_t operation, value;
+    uint8_t count, i, length;
+    for(;;)
+    {
+        operation = OLED_ReadAnimationByte(animation);
+        if(operation < 0)
+            return 1;
+        if(operation == OLED_ANIMATION_END_OF_FRAME)
+            break;
+        count = (operation & 0x3F) + 1;
+        switch(operation & 0xC0)
+        {
+            case 0x00://ûб仯ֽ
+                position += count;
+                continue;
+            case 0xC0:
+                position += (uint16_t)count << 6;
+                continue;
+            case 0x80://ظֽ
+                value = OLED_ReadAnimationByte(animation);
+                if(value < 0)
+                    return 1;
+                memset(data, value, count);
+                break;
+            default://ԭֽ
+                for(i = 0; i < count; i++)
+                {
+                    value = OLED_ReadAnimationByte(animation);
+                    if(value < 0)
+                        return 1;
+                    data[i] = value;
+                }
+                break;
+        }
+        if(position + count > OLED_ANIMATION_FRAME_SIZE)
+            return 1;
+        for(i = 0; i < count; i += length)//һҳ
+        {
+            length = 128 - ((position + i) & 127);
+            if(length > count - i)
+                length = count - i;
+            OLED_DisplayPicture((position + i) & 127, (position + i) >> 7, length, 8, data + i);
+        }
+        position += count;
+    }
+    animation->frameIndex++;
+    return 0;
+}
+
+/**
+ * @brief SDϵĶļ.
+ * @param animation , ڼһֱЧ.
+ * @param path ļ·, Ѿf_mount.
+ * @return 0-; 1-ʧܻʽ.
+ */
+uint8_t OLED_OpenAnimation(OLED_AnimationTypedef *animation, const char *path)
+{
+    uint8_t header[OLED_ANIMATION_HEADER_SIZE];
+    UINT readLength;
+    memset(animation, 0, sizeof(OLED_AnimationTypedef));
+    if(f_open(&animation->file, path, FA_READ) != FR_OK)
+        return 1;
+    if(f_read(&animation->file, header, sizeof(header), &readLength) != FR_OK || readLength != sizeof(header) || memcmp(header, "MWA1", 4))
+    {
+        f_close(&animation->file);
+        return 1;
+    }
+    animation->frameCount = header[4] | (header[5] << 8);
+    animation->fps = header[6];
+    return 0;
+}
+
+/**
+ * @brief رնļ, ڲʱֹͣ.
+ * @param animation .
+ */
+void OLED_CloseAnimation(OLED_AnimationTypedef *animation)
+{
+    OLED_StopAnimation(animation);
+    f_close(&animation->file);
+}
+
+/**
+ * @brief ӵһ֡ʼ.
+ * @param animation .
+ * @param fps ֡, 0-ʹļе֡; @ref OLED_ANIMATION_FPS_UNLIMITED -֡.
+ * @param loop 0-һ; 1-ѭ.
+ * @return 0-; 1-.
+ * @note ʹ @ref OLED_ANIMATION_TIM ʱ, ͬһʱֻܲһ.
+ *       ֮ѭз @ref OLED_UpdateAnimation.
+ */
+uint8_t OLED_StartAnimation(OLED_AnimationTypedef *animation, uint8_t fps, uint8_t loop)
+{
+    if(animation->frameCount == 0)
+        return 1;
+    animation->playFps = fps ? fps : animation->fps;
+    if(animation->playFps == 0)
+        return 1;
+    animation->loop = loop;
+    animation->nextFrameTime = 0;
+    memset(&animation->statistics, 0, sizeof(OLED_AnimationStatisticsTypedef));
+    if(OLED_RewindAnimation(animation))
+        return 1;
+    OLED_InitAnimationTimer();
+    animationMs = 0;
+    TIM_Cmd(OLED_ANIMATION_TIM, ENABLE);
+    animation->playing = 1;
+    return 0;
+}
+
+/**
+ * @brief ֹͣ, Դ汣һ֡.
+ * @param animation .
+ */
+void OLED_StopAnimation(OLED_AnimationTypedef *animation)
+{
+    if(!animation->playing)
+        return;
+    TIM_Cmd(OLED_ANIMATION_TIM, DISABLE);
+    animation->statistics.elapsedMs = animationMs;
+    animation->playing = 0;
+}
+
+/**
+ * @brief Ԥʱʱһ֡ʼˢ, ѭз.
+ * @param animation .
+ * @return 0-ڲ; 1-Ѳꡢֹͣ.
+ * @note ˢ @ref OLED_FlushAsync ں̨, ֻһ֡ͬ.
+ *       ֡ʱ뼸֡һˢ, ֲٶȲ.
+ */
+uint8_t OLED_UpdateAnimation(OLED_AnimationTypedef *animation)
+{
+    uint8_t decoded = 0, result = 0;
+    if(!animation->playing)
+        return 1;
+    while(animation->playFps == OLED_ANIMATION_FPS_UNLIMITED || (int32_t)(animationMs * animation->playFps - animation->nextFrameTime) >= 0)//ֵȽ, Ȼȷ
+    {
+        if(decoded)
+            animation->statistics.lateFrames++;
+        if(OLED_DecodeAnimationFrame(animation))
+        {
+            result = 1;
+            break;
+        }
+        decoded = 1;
+        animation->statistics.frames++;
+        animation->nextFrameTime += 1000;
+        if(animation->frameIndex >= animation->frameCount)
+        {
+            if(!animation->loop)
+            {
+                result = 1;
+                break;
+            }
+            if(OLED_RewindAnimation(animation))
+            {
+                result = 1;
+                break;
+            }
+        }
+        if(animation->playFps == OLED_ANIMATION_FPS_UNLIMITED)
+            break;
+    }
+    if(decoded)
+        while(OLED_FlushAsync(NULL));//һ֡ٿʼһ֡
+    animation->statistics.elapsedMs = animationMs;
+    if(result)
+        OLED_StopAnimation(animation);
+    return result;
+}
+
+/**
+ * @brief ȡͳ.
+ * @param animation .
+ * @param statistics ͳ,  @ref OLED_AnimationStatisticsTypedef.
+ */
+void OLED_GetAnimationStatistics(OLED_AnimationTypedef *animation, OLED_AnimationStatisticsTypedef *statistics)
+{
+    if(animation->playing)
+        animation->statistics.elapsedMs = animationMs;
+    *statistics = animation->statistics;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file    oled_animation.h
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2019/08/12
+ * @brief   
+ *          This file provides functions to play compressed animations
+ *          stored on SD card:
+ *              1. Open & close animation files through FatFs
+ *              2. Decode frames into the frame buffer at a fixed frame rate
+ *              3. Playback statistics
+ * @note
+ *          Minimum version of source file:
+ *              0.1.0
+ *
+ *          Animation files are made from PBM/PGM image sequences by tools/oled_animconv.c.
+ *          File format:
+ *              0   "MWA1"
+ *              4   uint16_t frameCount, little-endian
+ *              6   uint8_t  fps
+ *              7   uint8_t  reserved
+ *              8   frames, each is a sequence of operations on the 1024-byte
+ *                  frame buffer (page by page, column by column) compared
+ *                  with the previous frame, the first frame is compared
+ *                  with a blank screen:
+ *                  00nnnnnn            skip n + 1 unchanged bytes
+ *                  01nnnnnn d0 .. dn   n + 1 literal bytes
+ *                  10nnnnnn d          n + 1 copies of byte d
+ *                  11nnnnnn            skip (n + 1) * 64 unchanged bytes, n < 63
+ *                  11111111            end of frame
+ *          The OLED pins (PC10/PC11, or PC9 in hardware mode) are SDIO D1~D3,
+ *          so the SD card must run with SD_USE_4BIT_BUS = 0 in sd.h.
+ *
+ *          The source code repository is available on GitHub:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#ifndef __OLED_ANIMATION_H
+#define __OLED_ANIMATION_H
+
+#include "stm32f4xx.h"
+#include "oled.h"
+#include "ff.h"
+
+#define OLED_ANIMATION_CHUNK_SIZE       512 //!< ÿδSDȡֽ, СͬʱFatFsֱӶ뻺
+#define OLED_ANIMATION_FPS_UNLIMITED    0xFF //!< ֡, ÿεOLED_UpdateAnimationһ֡, ڲ֡
+
+#define OLED_ANIMATION_TIM              TIM7
+#define OLED_ANIMATION_TIM_CLK          RCC_APB1Periph_TIM7
+#define OLED_ANIMATION_TIM_IRQ_CHANNEL  TIM7_IRQn
+#define OLED_ANIMATION_TIM_IRQ_HANDLER  TIM7_IRQHandler
+
+/**
+ * @brief ͳ.
+ * @note ֡Ϊframes * 1000 / elapsedMs, ÿֽ֡Ϊbytes / frames,
+ *       ʵ͵Ļϵ֡Ϊframes - lateFrames.
+ */
+typedef struct
+{
+    uint32_t frames;//ѽ֡, һ֡ϲˢµ֡
+    uint32_t bytes;//ѽѹֽ
+    uint32_t lateFrames;//ʾһ֡ϲˢµ֡
+    uint32_t elapsedMs;//ӿʼžʱ
+}OLED_AnimationStatisticsTypedef;
+
+/**
+ * @brief .
+ */
+typedef struct
+{
+    FIL file;//ļ
+    uint8_t buffer[OLED_ANIMATION_CHUNK_SIZE];//ȡ
+    uint16_t bufferLength;//еֽ
+    uint16_t bufferIndex;//һҪֽ
+    uint16_t frameCount;//֡
+    uint16_t frameIndex;//һҪ֡
+    uint8_t fps;//ļе֡
+    uint8_t playFps;//֡,  @ref OLED_ANIMATION_FPS_UNLIMITED
+    uint8_t loop;//Ƿͷʼ
+    uint8_t playing;//ڲ
+    uint32_t nextFrameTime;//һ֡Ԥʾʱ, λΪ1/playFps
+    OLED_AnimationStatisticsTypedef statistics;//ͳ
+}OLED_AnimationTypedef;
+
+
+uint8_t OLED_OpenAnimation(OLED_AnimationTypedef *animation, const char *path);
+void OLED_CloseAnimation(OLED_AnimationTypedef *animation);
+uint8_t OLED_StartAnimation(OLED_AnimationTypedef *animation, uint8_t fps, uint8_t loop);
+void OLED_StopAnimation(OLED_AnimationTypedef *animation);
+uint8_t OLED_UpdateAnimation(OLED_AnimationTypedef *animation);
+void OLED_GetAnimationStatistics(OLED_AnimationTypedef *animation, OLED_AnimationStatisticsTypedef *statistics);
+#endif
@@ -0,0 +1,252 @@
+/**
+ * @file    oled_fontfile.c
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2019/08/10
+ * @brief   
+ *          This file provides functions to manage fonts stored on SD card:
+ *              1. Open & close font files through FatFs
+ *              2. Keep recently used glyphs in a LRU cache
+ * @note
+ *          Minimum version of header file:
+ *              0.1.0
+ *
+ *          The source code repository is available on GitHub:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+//    λ
+//    (, ), δʱ滻ûʹõ, SD
+//    ûеַҲ, ʾʱͬSD
+
+#include "oled_fontfile.h"
+#include "sd.h"
+#include "string.h"
+
+#if SD_USE_4BIT_BUS == 1
+#error "SDIO D1~D3 (PC9~PC11) clash with the OLED pins, set SD_USE_4BIT_BUS to 0 in sd.h"
+#endif
+
+#define OLED_FONTFILE_HEADER_SIZE   16
+#define OLED_FONTFILE_RANGE_SIZE    12
+
+/**
+ * @brief .
+ */
+typedef struct
+{
+    const OLED_FontFileTypedef *fontFile;//, NULL-
+    uint32_t code;//ַ
+    uint32_t lastUsed;//ʹʱļ
+    uint8_t width;//ο, 0-ûиַ
+    uint8_t columns[OLED_FONTFILE_MAX_WIDTH * 2];//
+}OLED_GlyphCacheItemTypedef;
+
+static OLED_GlyphCacheItemTypedef glyphCache[OLED_FONTFILE_CACHE_SIZE];
+static uint32_t useCount = 0;
+static OLED_GlyphCacheStatisticsTypedef cacheStatistics = {0};
+
+/**
+ * @brief С˶ȡ32λ.
+ */
+static inline uint32_t OLED_GetUint32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * @brief ļָλöȡֽ.
+ * @return 0-; 1-.
+ */
+static uint8_t OLED_ReadFontFile(OLED_FontFileTypedef *fontFile, uint32_t offset, void *buffer, UINT length)
+{
+    UINT readLength;
+    if(f_lseek(&fontFile->file, offset) != FR_OK)
+        return 1;
+    if(f_read(&fontFile->file, buffer, length, &readLength) != FR_OK || readLength != length)
+        return 1;
+    return 0;
+}
+
+/**
+ * @brief ַӦ.
+ * @param fontFile .
+ * @param code ַ.
+ * @param glyphIndex , ûиַʱΪglyphCount.
+ * @return 0-; 1-ļ.
+ * @note Ȳϴе, жֲ.
+ */
+static uint8_t OLED_FindGlyph(OLED_FontFileTypedef *fontFile, uint32_t code, uint32_t *glyphIndex)
+{
+    uint8_t range[OLED_FONTFILE_RANGE_SIZE];
+    uint32_t low = 0, high = fontFile->rangeCount, middle, firstCode, count;
+    *glyphIndex = fontFile->glyphCount;
+    if(fontFile->lastCount && code - fontFile->lastFirstCode < fontFile->lastCount)
+    {
+        *glyphIndex = fontFile->lastFirstGlyph + code - fontFile->lastFirstCode;
+        return 0;
+    }
+    while(low < high)
+    {
+        middle = (low + high) >> 1;
+        if(OLED_ReadFontFile(fontFile, OLED_FONTFILE_HEADER_SIZE + middle * OLED_FONTFILE_RANGE_SIZE, range, sizeof(range)))
+            return 1;
+        firstCode = OLED_GetUint32(range);
+        count = OLED_GetUint32(range + 4);
+        if(code < firstCode)
+        {
+            high = middle;
+        }
+        else if(code - firstCode >= count)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            fontFile->lastFirstCode = firstCode;
+            fontFile->lastCount = count;
+            fontFile->lastFirstGlyph = OLED_GetUint32(range + 8);
+            *glyphIndex = fontFile->lastFirstGlyph + code - firstCode;
+            return 0;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief SDȡε.
+ * @return 0-, ûиַʱwidthΪ0; 1-ļ.
+ */
+static uint8_t OLED_LoadGlyph(OLED_FontFileTypedef *fontFile, uint32_t code, OLED_GlyphCacheItemTypedef *item)
+{
+    uint8_t pages = fontFile->font.height >> 3;
+    uint32_t glyphIndex, slotSize = 1 + (uint32_t)fontFile->maxWidth * pages;
+    uint8_t slot[1 + OLED_FONTFILE_MAX_WIDTH * 2];
+    uint8_t page;
+    item->width = 0;
+    if(OLED_FindGlyph(fontFile, code, &glyphIndex))
+        return 1;
+    if(glyphIndex >= fontFile->glyphCount)
+        return 0;
+    if(OLED_ReadFontFile(fontFile, fontFile->dataOffset + glyphIndex * slotSize, slot, slotSize))
+        return 1;
+    if(slot[0] > fontFile->maxWidth)
+        return 1;
+    item->width = slot[0];
+    for(page = 0; page < pages; page++)//۰, 水ʵʿ
+        memcpy(item->columns + page * item->width, slot + 1 + page * fontFile->maxWidth, item->width);
+    return 0;
+}
+
+/**
+ * @brief ȡļе, Ϊ @ref OLED_FontTypedef getGlyph.
+ */
+static uint8_t OLED_GetFileGlyph(const OLED_FontTypedef *font, uint32_t code, OLED_GlyphTypedef *glyph)
+{
+    OLED_FontFileTypedef *fontFile = (OLED_FontFileTypedef *)font;
+    OLED_GlyphCacheItemTypedef *item = NULL, *oldest = &glyphCache[0];
+    uint8_t i;
+    for(i = 0; i < OLED_FONTFILE_CACHE_SIZE; i++)
+    {
+        if(glyphCache[i].fontFile == fontFile && glyphCache[i].code == code)
+        {
+            item = &glyphCache[i];
+            break;
+        }
+        if(glyphCache[i].lastUsed < oldest->lastUsed)
+            oldest = &glyphCache[i];
+    }
+    if(item != NULL)
+    {
+        cacheStatistics.hits++;
+    }
+    else
+    {
+        cacheStatistics.misses++;
+        item = oldest;
+        item->fontFile = NULL;
+        if(OLED_LoadGlyph(fontFile, code, item))
+        {
+            item->lastUsed = 0;//, ´ض
+            return 1;
+        }
+        item->fontFile = fontFile;
+        item->code = code;
+    }
+    item->lastUsed = ++useCount;
+    if(!item->width)
+        return 1;
+    glyph->width = item->width;
+    glyph->height = font->height;
+    glyph->columns = item->columns;
+    return 0;
+}
+
+/**
+ * @brief SDϵļ.
+ * @param fontFile , ڼһֱЧ.
+ * @param path ļ·, Ѿf_mount.
+ * @return 0-; 1-ʧܻʽ.
+ */
+uint8_t OLED_OpenFontFile(OLED_FontFileTypedef *fontFile, const char *path)
+{
+    uint8_t header[OLED_FONTFILE_HEADER_SIZE];
+    uint8_t height;
+    memset(fontFile, 0, sizeof(OLED_FontFileTypedef));
+    if(f_open(&fontFile->file, path, FA_READ) != FR_OK)
+        return 1;
+    if(OLED_ReadFontFile(fontFile, 0, header, sizeof(header)) || memcmp(header, "MWF1", 4))
+        goto error;
+    height = header[4];
+    fontFile->maxWidth = header[5];
+    fontFile->rangeCount = header[6] | (header[7] << 8);
+    fontFile->glyphCount = OLED_GetUint32(header + 8);
+    fontFile->dataOffset = OLED_GetUint32(header + 12);
+    if((height != 8 && height != 16) || fontFile->maxWidth == 0 || fontFile->maxWidth > OLED_FONTFILE_MAX_WIDTH)
+        goto error;
+#if FF_USE_FASTSEEK
+    //, ֮f_lseekش
+    fontFile->linkMap[0] = OLED_FONTFILE_LINKMAP_SIZE;
+    fontFile->file.cltbl = fontFile->linkMap;
+    if(f_lseek(&fontFile->file, CREATE_LINKMAP) != FR_OK)
+        fontFile->file.cltbl = NULL;
+#endif
+    fontFile->font.height = height;
+    fontFile->font.getGlyph = OLED_GetFileGlyph;
+    return 0;
+error:
+    f_close(&fontFile->file);
+    return 1;
+}
+
+/**
+ * @brief رļ, 仺.
+ * @param fontFile .
+ */
+void OLED_CloseFontFile(OLED_FontFileTypedef *fontFile)
+{
+    uint8_t i;
+    for(i = 0; i < OLED_FONTFILE_CACHE_SIZE; i++)
+    {
+        if(glyphCache[i].fontFile == fontFile)
+        {
+            glyphCache[i].fontFile = NULL;
+            glyphCache[i].lastUsed = 0;
+        }
+    }
+    f_close(&fontFile->file);
+    fontFile->font.getGlyph = NULL;
+}
+
+/**
+ * @brief ȡλͳ.
+ * @param statistics ͳ,  @ref OLED_GlyphCacheStatisticsTypedef.
+ */
+void OLED_GetGlyphCacheStatistics(OLED_GlyphCacheStatisticsTypedef *statistics)
+{
+    *statistics = cacheStatistics;
+}
@@ -0,0 +1,80 @@
+/**
+ * @file    oled_fontfile.h
+ * @author  Miaow
+ * @version 0.1.0
+ * @date    2019/08/10
+ * @brief   
+ *          This file provides functions to manage fonts stored on SD card:
+ *              1. Open & close font files through FatFs
+ *              2. Keep recently used glyphs in a LRU cache
+ * @note
+ *          Minimum version of source file:
+ *              0.1.0
+ *
+ *          Font files are made from BDF fonts by tools/oled_fontconv.c.
+ *          File format (little-endian):
+ *              0   "MWF1"
+ *              4   uint8_t  height, 8 or 16
+ *              5   uint8_t  maxWidth, width of every glyph slot
+ *              6   uint16_t rangeCount
+ *              8   uint32_t glyphCount
+ *              12  uint32_t dataOffset
+ *              16  ranges sorted by code, 12 bytes each:
+ *                  uint32_t firstCode, uint32_t count, uint32_t firstGlyph
+ *              dataOffset  glyph slots, (1 + maxWidth * height / 8) bytes each:
+ *                  uint8_t width, then columns in the format of OLED_DisplayPicture
+ *          The OLED pins (PC10/PC11, or PC9 in hardware mode) are SDIO D1~D3,
+ *          so the SD card must run with SD_USE_4BIT_BUS = 0 in sd.h.
+ *
+ *          The source code repository is available on GitHub:
+ *              https://github.com/3703781
+ *          Your pull requests will be welcome.
+ *          Here are the guidelines for your pull requests:
+ *              1. Respect my coding style.
+ *              2. Avoid to commit several features in one commit.
+ *              3. Make your modification compact - don't reformat source code in your request.
+ */
+
+#ifndef __OLED_FONTFILE_H
+#define __OLED_FONTFILE_H
+
+#include "stm32f4xx.h"
+#include "oled.h"
+#include "ff.h"
+
+#define OLED_FONTFILE_CACHE_SIZE    32 //!< θ, ļ
+#define OLED_FONTFILE_MAX_WIDTH     16 //!< ()
+#define OLED_FONTFILE_LINKMAP_SIZE  16 //!< ٶλ, ļƬʱ, ˻Ϊͨλ
+
+/**
+ * @brief SDϵ.
+ * @note 򿪺&fontFile->fontΪ崫 @ref OLED_DisplayText.
+ */
+typedef struct
+{
+    OLED_FontTypedef font;//ǵһԱ
+    FIL file;//ļ
+    DWORD linkMap[OLED_FONTFILE_LINKMAP_SIZE];//FatFsٶλ
+    uint8_t maxWidth;//ÿβ۵Ŀ
+    uint16_t rangeCount;//
+    uint32_t glyphCount;//θ
+    uint32_t dataOffset;//ļеƫ
+    uint32_t lastFirstCode;//ϴеı
+    uint32_t lastCount;//ϴеı, 0-
+    uint32_t lastFirstGlyph;//ϴеı
+}OLED_FontFileTypedef;
+
+/**
+ * @brief λͳ.
+ */
+typedef struct
+{
+    uint32_t hits;//д
+    uint32_t misses;//δд, SDĴ
+}OLED_GlyphCacheStatisticsTypedef;
+
+
+uint8_t OLED_OpenFontFile(OLED_FontFileTypedef *fontFile, const char *path);
+void OLED_CloseFontFile(OLED_FontFileTypedef *fontFile);
+void OLED_GetGlyphCacheStatistics(OLED_GlyphCacheStatisticsTypedef *statistics);
+#endif
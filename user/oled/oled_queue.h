@@ -1,17 +1,17 @@
 /**
- * @file    bsp_iic.c
+ * @file    oled_queue.h
  * @author  Miaow
- * @version 0.1.0
+ * @version 0.2.0
  * @date    2018/10/04
  * @brief   
  *          This file provides functions to manage a queue implemented by
- *          the single linked list:
+ *          a fixed-capacity lock-free single-producer/single-consumer ring:
  *              1. Initialization & deinitialization
  *              2. Insert & delete
  *              3. Traverse
  * @note
- *          Minimum version of header file:
- *              0.1.0
+ *          Minimum version of source file:
+ *              0.2.0
  *
  *          The source code repository is not available on GitHub now:
  *              https://github.com/3703781
@@ -27,33 +27,29 @@
 
 #include "stm32f4xx.h"
 
-
-
-/**
- * @brief 节点结构
- */
-typedef struct OLED_Node{
-    char* item;//数据域
-    struct OLED_Node * Next;
-}node, *pNode;
+#define OLED_QUEUE_SIZE     16 //!< 队列容量, 必须是2的幂
 
 /**
  * @brief 队列结构体
+ * @note 只允许一个生产者(如一个中断)入队, 一个消费者(如主循环)出队, 两者之间不需要关中断.
+ *       有多个可能互相打断的生产者时, 每个生产者使用一个队列.
  */
 typedef struct {
-    pNode front;//队列头
-    pNode rear;//队列尾
+    char *items[OLED_QUEUE_SIZE];//数据域
+    __IO uint32_t front;//队列头, 只由消费者修改
+    __IO uint32_t rear;//队列尾, 只由生产者修改
 }queue, *pQueue;
 
 
 
-uint8_t OLED_InitQueue(pQueue);
-inline uint8_t OLED_IsEmptyQueue(pQueue);
+uint8_t OLED_InitQueue(pQueue queue);
+uint8_t OLED_IsEmptyQueue(pQueue queue);
+uint8_t OLED_IsFullQueue(pQueue queue);
 uint8_t OLED_InsertQueueItem(pQueue queue, char* item);
-uint8_t OLED_DeleteQueueItem(pQueue queue, __IO char* item);
-void OLED_DestroyQueue(pQueue);
+uint8_t OLED_DeleteQueueItem(pQueue queue, char** item);
+void OLED_DestroyQueue(pQueue queue);
 uint8_t OLED_TraverseQueue(pQueue queue, void (*callback)(char *item));
-void OLED_ClearQueue(pQueue);
+void OLED_ClearQueue(pQueue queue);
 
 
 #endif
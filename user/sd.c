@@ -1,7 +1,7 @@
 /**
  * @file    sd.c
  * @author  Miaow
- * @version 1.0.0
+ * @version 1.1.0
  * @date    2021/08/01
  * @brief
  *          This file provides functions to manage the following 
@@ -11,17 +11,19 @@
  *              3. Read in the unit of sector
  * @note
  *          Minimum version of header file:
- *              1.0.0
+ *              0.3.0
  *          Pin connection:
  *               
  *               PC8D0      
  *               PC9D1      
- *               PC9D2      
+ *              PC10D2      
  *              PC11D3      
  *              PC12SCK     
  *              PD2 CMD     
  *               
  *          STM32F407       SD/TF Card
+ *          D1~D3 are only used when SD_USE_4BIT_BUS is 1. In the default
+ *          1-bit mode PC9~PC11 are left to other modules, e.g. the OLED.
  *          
  *          The source code repository is available on GitHub:
  *              https://github.com/3703781
@@ -1088,7 +1090,11 @@ uint8_t SD_Init()
 
   //GPIO
   RCC_AHB1PeriphClockCmd(RCC_AHB1Periph_GPIOC | RCC_AHB1Periph_GPIOD, ENABLE);
+#if SD_USE_4BIT_BUS == 1
   GPIO_InitStructure.GPIO_Pin = GPIO_Pin_8 | GPIO_Pin_9 | GPIO_Pin_10 | GPIO_Pin_11 | GPIO_Pin_12;
+#else
+  GPIO_InitStructure.GPIO_Pin = GPIO_Pin_8 | GPIO_Pin_12;
+#endif
   GPIO_InitStructure.GPIO_Mode = GPIO_Mode_AF;
   GPIO_InitStructure.GPIO_Speed = GPIO_High_Speed;
   GPIO_InitStructure.GPIO_OType = GPIO_OType_PP;
@@ -1099,9 +1105,11 @@ uint8_t SD_Init()
 
   //GPIO AF
   GPIO_PinAFConfig(GPIOC, GPIO_PinSource8, GPIO_AF_SDIO);
+#if SD_USE_4BIT_BUS == 1
   GPIO_PinAFConfig(GPIOC, GPIO_PinSource9, GPIO_AF_SDIO);
   GPIO_PinAFConfig(GPIOC, GPIO_PinSource10, GPIO_AF_SDIO);
   GPIO_PinAFConfig(GPIOC, GPIO_PinSource11, GPIO_AF_SDIO);
+#endif
   GPIO_PinAFConfig(GPIOC, GPIO_PinSource12, GPIO_AF_SDIO);
   GPIO_PinAFConfig(GPIOD, GPIO_PinSource2, GPIO_AF_SDIO);
 
@@ -1150,8 +1158,10 @@ uint8_t SD_Init()
       clockDivision = (uint8_t)ceilf((float)Apb2Clock / maxClock - 2.0f);
     }
 
+#if SD_USE_4BIT_BUS == 1
     if (result == SD_OK)
       result = SD_SetWideBusMode(SDIO_BusWide_4b);
+#endif
 
     //Set the card clock.
     tmpReg = SDIO->CLKCR;
@@ -1,7 +1,7 @@
 /**
  * @file    sd.h
  * @author  Miaow
- * @version 0.2.0
+ * @version 0.3.0
  * @date    2019/08/01
  * @brief
  *          This file provides functions to manage the following 
@@ -11,17 +11,19 @@
  *              3. Read in the unit of sector
  * @note
  *          Minimum version of source file:
- *              0.2.0
+ *              1.1.0
  *          Pin connection:
  *               
  *               PC8D0      
  *               PC9D1      
- *               PC9D2      
+ *              PC10D2      
  *              PC11D3      
  *              PC12SCK     
  *              PD2 CMD     
  *               
  *          STM32F407       SD/TF Card
+ *          D1~D3 are only used when SD_USE_4BIT_BUS is 1. In the default
+ *          1-bit mode PC9~PC11 are left to other modules, e.g. the OLED.
  *          
  *          The source code repository is available on GitHub:
  *              https://github.com/3703781
@@ -50,6 +52,7 @@
  */
 #define SD_INIT_CLK        400000.0f //!< The card shall operate in clock rate less than 400kHz when initializing.
 #define SD_TRANSFER_CLK    25000000.0f //!< Maximum clock rate when transferring.
+#define SD_USE_4BIT_BUS    0 //!< 1-4-bit bus on PC8~PC11; 0-1-bit bus on PC8, PC9~PC11 are not touched.
 /**
  * @}
  */
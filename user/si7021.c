@@ -1,22 +1,27 @@
 /**
  * @file    si7021.c
  * @author  Miaow
- * @version 0.1.0
+ * @version 0.3.0
  * @date    2019/11/16
  * @brief   
  *          This file provides bsp functions to manage the following 
  *          functionalities of si7021:
  *              1. Initialization
  *              2. Measurement
+ *              3. Temperature and humidity from one conversion, No Hold Master
+ *                 polling and CRC check
  * @note
  *          Minimum version of header file:
- *              0.1.0
+ *              0.3.0
  *          Pin connection:
  *                    
  *                   PB8SCL    
  *                   PB9SDA    
  *                    
  *               STM32F407      SI7021
+ *          With IIC_USE_HARDWARE = 1 in bsp_iic.h, PB8/PB9 belong to I2C1
+ *          and the SI7021 goes through the IIC_* functions, sharing the bus
+ *          with the other IIC_* devices. SI7021_*_PORT/PIN are then unused.
  *  
  *          The source code repository is available on GitHub:
  *              https://github.com/3703781
@@ -32,193 +37,117 @@
  * @{
  */
  
-#define SI7021_ADDRESS          0x80
-#define SI7021_WRITE_ADDRESS    SI7021_ADDRESS
-#define SI7021_READ_ADDRESS     (SI7021_ADDRESS | 0x01)
+#define SI7021_ADDRESS          0x40 //!< 7λַ
+#define SI7021_TIMEOUT_MS       30 //!< תʱʱ, ʪתһ¶ת, Լ23ms
 
-/**
- * @brief ׼ʱ
- */
-static inline void SI7021_DelayUs(uint32_t us)
-{
-  __IO uint32_t tmp = us;
-  tmp <<= 2;
-  while (tmp--);
-}
+#if IIC_USE_HARDWARE == 1
+//PB8/PB9ӲI2C1, ͨIIC_*, ٳʼΪIIC
+#define SI7021_WRITE(data, len)     IIC_Write(SI7021_ADDRESS, data, len)
+#define SI7021_READ(data, len)      IIC_Read(SI7021_ADDRESS, data, len)
+#else
+static IIC_BusTypedef si7021Bus = IIC_BUS(SI7021_SCL_PORT, SI7021_SCL_PIN, SI7021_SDA_PORT, SI7021_SDA_PIN, SI7021_IIC_SPEED);
+#define SI7021_WRITE(data, len)     IIC_BusWrite(&si7021Bus, SI7021_ADDRESS, data, len)
+#define SI7021_READ(data, len)      IIC_BusRead(&si7021Bus, SI7021_ADDRESS, data, len)
+#endif
+static uint8_t measuring = 0;//1-ѷͲ, ȴת
+static uint32_t measureStart;//Ͳʱ(ںʱ)
 
 /**
- * @brief ʼź
+ * @brief CRC, ʽx^8+x^5+x^4+1, ֵ0.
  */
-static void SI7021_Start()
+static uint8_t SI7021_Crc(const uint8_t *data, uint8_t len)
 {
-  SI7021_Out();
-  SI7021_SDA_PORT->BSRRL = SI7021_SDA_PIN; 
-  SI7021_SCL_PORT->BSRRL = SI7021_SCL_PIN;
-  SI7021_DelayUs(1);
-  SI7021_SDA_PORT->BSRRH = SI7021_SDA_PIN;
-  SI7021_DelayUs(1);
-  SI7021_SCL_PORT->BSRRH = SI7021_SCL_PIN;
+  uint8_t i, crc = 0;
+  while (len--)
+  {
+    crc ^= *data++;
+    for (i = 0; i < 8; i++)
+      crc = crc & 0x80 ? (crc << 1) ^ 0x31 : crc << 1;
+  }
+  return crc;
 }
 
 /**
- * @brief ֹͣź
+ * @brief No Hold MasterģʽĲ, ȴת.
+ * @param command 0xF3-¶; 0xF5-ʪ(ͬʱת¶).
+ * @return SI7021_OK; SI7021_ERROR.
  */
-static void SI7021_Stop()
+static uint8_t SI7021_Start(uint8_t command)
 {
-  SI7021_Out();
-  SI7021_SCL_PORT->BSRRH = SI7021_SCL_PIN;
-  SI7021_SDA_PORT->BSRRH = SI7021_SDA_PIN;
-  SI7021_DelayUs(1);
-  SI7021_SCL_PORT->BSRRL = SI7021_SCL_PIN;
-  SI7021_DelayUs(1);
-  SI7021_SDA_PORT->BSRRL = SI7021_SDA_PIN;
-  SI7021_DelayUs(1);
+  measuring = 0;
+  if (SI7021_WRITE(&command, 1))
+    return SI7021_ERROR;
+  measureStart = UTILS_GetCycleCount();
+  measuring = 1;
+  return SI7021_OK;
 }
 
 /**
- * @brief ȴӦź
- * @return 1-Ӧʧ; 0-Ӧɹ
+ * @brief ѯתǷ, УCRC.
+ * @param result 16λԭʼֵ.
+ * @return SI7021_OK; SI7021_ERROR-ʱ; SI7021_BUSY-תδ.
+ * @note תδʱӦַ, ߲ᱻʱչռ.
  */
-static uint8_t SI7021_WaitAck()
+static uint8_t SI7021_Poll(uint16_t *result)
 {
-  __IO uint8_t ucErrTime = 0;
-  SI7021_In();
-  SI7021_SDA_PORT->BSRRL = SI7021_SDA_PIN;
-  SI7021_SCL_PORT->BSRRL = SI7021_SCL_PIN;
-  SI7021_DelayUs(1);
-  while (SI7021_SDA_PORT->IDR & SI7021_SDA_PIN)
+  uint8_t data[3];
+  if (!measuring)
+    return SI7021_ERROR;
+  if (SI7021_READ(data, 3))
   {
-    ucErrTime++;
-    if (ucErrTime > 250)
-    {
-      SI7021_Stop();
-      return 1;
-    }
+    if (UTILS_GetCycleCount() - measureStart < SystemCoreClock / 1000 * SI7021_TIMEOUT_MS)
+      return SI7021_BUSY;
+    measuring = 0;
+    return SI7021_ERROR;
   }
-  SI7021_SCL_PORT->BSRRH = SI7021_SCL_PIN;     
-  return 0;
-}
-/**
- * @brief Ӧź
- */
-static void SI7021_Ack()
-{
-  SI7021_SCL_PORT->BSRRH = SI7021_SCL_PIN;
-  SI7021_Out();
-  SI7021_SDA_PORT->BSRRH = SI7021_SDA_PIN;
-  SI7021_DelayUs(1);
-  SI7021_SCL_PORT->BSRRL = SI7021_SCL_PIN;
-  SI7021_DelayUs(1);
-  SI7021_SCL_PORT->BSRRH = SI7021_SCL_PIN;
-}
-/**
- * @brief Ӧź
- */
-static void SI7021_NAck()
-{
-  __IO uint32_t j;
-  SI7021_SCL_PORT->BSRRH = SI7021_SCL_PIN;
-  SI7021_Out();
-  SI7021_SDA_PORT->BSRRL = SI7021_SDA_PIN;
-  SI7021_DelayUs(1);
-  SI7021_SCL_PORT->BSRRL = SI7021_SCL_PIN;
-  SI7021_DelayUs(1);
-  SI7021_SCL_PORT->BSRRH = SI7021_SCL_PIN;
+  measuring = 0;
+  if (SI7021_Crc(data, 2) != data[2])
+    return SI7021_ERROR;
+  *result = ((uint16_t)data[0] << 8) | data[1];
+  return SI7021_OK;
 }
 
 /**
- * @brief IICһֽ
+ * @brief Ͳ, ѯתɺ.
+ * @param command 0xF3-¶; 0xF5-ʪ.
+ * @param result 16λԭʼֵ.
+ * @return SI7021_OK; SI7021_ERROR.
  */
-static void SI7021_WriteByte(uint8_t data)
+static uint8_t SI7021_Convert(uint8_t command, uint16_t *result)
 {
-  uint8_t i;
-  __IO uint32_t j;
-  SI7021_Out();
-  SI7021_SCL_PORT->BSRRH = SI7021_SCL_PIN;
-  for (i = 0; i < 8; i++)
-  {
-    SI7021_DelayUs(5);
-    if ((data & 0x80) >> 7)
-      SI7021_SDA_PORT->BSRRL = SI7021_SDA_PIN;
-    else
-      SI7021_SDA_PORT->BSRRH = SI7021_SDA_PIN;
-    data <<= 1;
-    SI7021_DelayUs(1);
-    SI7021_SCL_PORT->BSRRL = SI7021_SCL_PIN;
-    SI7021_DelayUs(1);
-    SI7021_SCL_PORT->BSRRH = SI7021_SCL_PIN;
-  }
+  uint8_t status;
+  if (SI7021_Start(command))
+    return SI7021_ERROR;
+  while ((status = SI7021_Poll(result)) == SI7021_BUSY)
+    UTILS_DelayUs(500);
+  return status;
 }
+
 /**
- * @brief 1ֽ
- * @param ack
- *          1-Ӧ
- *          0-ͷӦ
- * @return ضȡһֽ
+ * @brief ԭʼֵתΪ¶().
  */
-static uint8_t SI7021_ReadByte(uint8_t ack)
+static float SI7021_ToTemperature(uint16_t code)
 {
-  uint8_t i, receive = 0;
-  __IO uint32_t j;
-  SI7021_In();
-  for (i = 0; i < 8; i++)
-  {
-    SI7021_DelayUs(5);
-    SI7021_SCL_PORT->BSRRH = SI7021_SCL_PIN;
-    SI7021_DelayUs(1);
-    SI7021_SCL_PORT->BSRRL = SI7021_SCL_PIN;
-    receive <<= 1;
-    SI7021_DelayUs(1);
-    if (SI7021_SDA_PORT->IDR & SI7021_SDA_PIN)
-      receive++;
-  }
-  if (!ack)
-    SI7021_NAck();
-  else
-    SI7021_Ack();
-  return receive;
+  return 175.72f * (float)code / 65536.0f - 46.85f;
 }
 
 void SI7021_Init()
 {
-  GPIO_InitTypeDef GPIO_InitStructure;
-  RCC_AHB1PeriphClockCmd(SI7021_SCL_GPIO_CLK | SI7021_SDA_GPIO_CLK, ENABLE);//ʹGPIOʱ
-  //SCL, SDAʼ
-  GPIO_InitStructure.GPIO_Pin = SI7021_SCL_PIN;
-  GPIO_InitStructure.GPIO_Mode = GPIO_Mode_OUT;//ͨģʽ
-  GPIO_InitStructure.GPIO_OType = GPIO_OType_PP;//
-  GPIO_InitStructure.GPIO_Speed = GPIO_High_Speed;
-  GPIO_InitStructure.GPIO_PuPd = GPIO_PuPd_UP;//
-  GPIO_Init(SI7021_SCL_PORT, &GPIO_InitStructure);//ʼ
-  GPIO_InitStructure.GPIO_Pin = SI7021_SDA_PIN;
-  GPIO_Init(SI7021_SDA_PORT, &GPIO_InitStructure);//ʼ
-  SI7021_SCL_PORT->BSRRL = SI7021_SCL_PIN;//IIC_SCL=1
-  SI7021_SDA_PORT->BSRRL = SI7021_SDA_PIN;//IIC_SDA=1
+#if IIC_USE_HARDWARE == 1
+  IIC_Init();
+  UTILS_InitCycleCounter();//תʱʱ
+#else
+  IIC_InitBus(&si7021Bus);
+#endif
 }
 
 uint8_t SI7021_GetTempature(float* tempature)
 {
   uint16_t result;
-  SI7021_Start();
-  SI7021_WriteByte(SI7021_WRITE_ADDRESS);
-  if (SI7021_WaitAck() != 0)
+  if (SI7021_Convert(0xF3, &result))
     return 1;
-  SI7021_WriteByte(0xF3);
-  if (SI7021_WaitAck() != 0)
-    return 1;
-  
-  UTILS_DelayMs(18);
-  SI7021_Start();
-  SI7021_WriteByte(SI7021_READ_ADDRESS);
-  if (SI7021_WaitAck() != 0)
-    return 1;
-  
-  result = (uint16_t)SI7021_ReadByte(1) << 8;
-  result |= (uint16_t)SI7021_ReadByte(0);
-  SI7021_Stop();
 
-  // Swap the bytes and clear the status bits 
-  *tempature = 175.72f * (float)result / 65536.0f - 46.85f;
+  *tempature = SI7021_ToTemperature(result);
 
   return 0;
 }
@@ -226,29 +155,62 @@ uint8_t SI7021_GetTempature(float* tempature)
 uint8_t SI7021_GetHumidity(uint8_t* humidity)
 {
   uint16_t result;
-  SI7021_Start();
-  SI7021_WriteByte(SI7021_WRITE_ADDRESS);
-  if (SI7021_WaitAck() != 0)
-    return 1;
-  SI7021_WriteByte(0xF5);
-  if (SI7021_WaitAck() != 0)
+  if (SI7021_Convert(0xF5, &result))
     return 1;
-  
-  UTILS_DelayMs(18);
-  SI7021_Start();
-  SI7021_WriteByte(SI7021_READ_ADDRESS);
-  if (SI7021_WaitAck() != 0)
-    return 1;
-  
-  result = (uint16_t)SI7021_ReadByte(1) << 8;
-  result |= (uint16_t)SI7021_ReadByte(0);
-  SI7021_Stop();
 
-  // Swap the bytes and clear the status bits 
   *humidity = (125 * result >> 16) - 6;
 
   return 0;
 }
+
+/**
+ * @brief ʼһʪת, ,  @ref SI7021_PollMeasurement ȡý.
+ * @return SI7021_OK; SI7021_ERROR.
+ */
+uint8_t SI7021_StartMeasurement()
+{
+  return SI7021_Start(0xF5);
+}
+
+/**
+ * @brief ѯ @ref SI7021_StartMeasurement ʼת, ʪȺͬһת¶.
+ * @param temperature ¶().
+ * @param humidity ʪ(%), 0~100.
+ * @return SI7021_OK; SI7021_ERROR-ʱCRC; SI7021_BUSY-תδ, Ժٲѯ.
+ * @note ʪתʱת¶, 0xE0¶, Ҫתһ.
+ */
+uint8_t SI7021_PollMeasurement(float *temperature, float *humidity)
+{
+  uint8_t data[2], command = 0xE0, status;
+  uint16_t result;
+  float rh;
+  status = SI7021_Poll(&result);
+  if (status != SI7021_OK)
+    return status;
+  if (SI7021_WRITE(&command, 1) || SI7021_READ(data, 2))
+    return SI7021_ERROR;//0xE0¶ûCRC
+  rh = 125.0f * (float)result / 65536.0f - 6.0f;
+  *humidity = rh < 0.0f ? 0.0f : rh > 100.0f ? 100.0f : rh;
+  *temperature = SI7021_ToTemperature(((uint16_t)data[0] << 8) | data[1]);
+  return SI7021_OK;
+}
+
+/**
+ * @brief һת¶Ⱥʪ, תɺŷ.
+ * @param temperature ¶().
+ * @param humidity ʪ(%), 0~100.
+ * @return SI7021_OK; SI7021_ERROR.
+ * @note ȷֱ @ref SI7021_GetTempature  @ref SI7021_GetHumidity һ¶ת.
+ */
+uint8_t SI7021_Measure(float *temperature, float *humidity)
+{
+  uint8_t status;
+  if (SI7021_StartMeasurement())
+    return SI7021_ERROR;
+  while ((status = SI7021_PollMeasurement(temperature, humidity)) == SI7021_BUSY)
+    UTILS_DelayUs(500);
+  return status;
+}
 /**
  * @}
  */
@@ -1,22 +1,27 @@
 /**
  * @file    si7021.h
  * @author  Miaow
- * @version 0.1.0
+ * @version 0.3.0
  * @date    2019/11/16
  * @brief   
  *          This file provides bsp functions to manage the following 
  *          functionalities of si7021:
  *              1. Initialization
  *              2. Measurement
+ *              3. Temperature and humidity from one conversion, No Hold Master
+ *                 polling and CRC check
  * @note
- *          Minimum version of header file:
- *              0.1.0
+ *          Minimum version of source file:
+ *              0.3.0
  *          Pin connection:
  *                    
  *                   PB8SCL    
  *                   PB9SDA    
  *                    
  *               STM32F407      SI7021
+ *          With IIC_USE_HARDWARE = 1 in bsp_iic.h, PB8/PB9 belong to I2C1
+ *          and the SI7021 goes through the IIC_* functions, sharing the bus
+ *          with the other IIC_* devices. SI7021_*_PORT/PIN are then unused.
  *  
  *          The source code repository is available on GitHub:
  *              https://github.com/3703781
@@ -30,6 +35,7 @@
 #define __SI7021_H
 
 #include "utils.h"
+#include "bsp_iic.h"
 
 /** 
  * @defgroup SI7021
@@ -42,19 +48,30 @@
  */
 #define SI7021_SCL_PORT         GPIOB
 #define SI7021_SCL_PIN          GPIO_Pin_8
-#define SI7021_SCL_GPIO_CLK     RCC_AHB1Periph_GPIOB
 #define SI7021_SDA_PORT         GPIOB
 #define SI7021_SDA_PIN          GPIO_Pin_9
-#define SI7021_SDA_GPIO_CLK     RCC_AHB1Periph_GPIOB
-#define SI7021_In()             SI7021_SDA_PORT->MODER &= ~0x000C0000;SI7021_SDA_PORT->MODER |= 0x00000000
-#define SI7021_Out()            SI7021_SDA_PORT->MODER &= ~0x000C0000;SI7021_SDA_PORT->MODER |= 0x00040000
+#define SI7021_IIC_SPEED        400000 //!< SCLƵ(Hz), 400kHz
 /**
  * @}
  */
  
+/** 
+ * @defgroup SI7021_return_status
+ * @{
+ */
+#define SI7021_OK               0
+#define SI7021_ERROR            1
+#define SI7021_BUSY             2 //!< תδ
+/**
+ * @}
+ */
+
 void SI7021_Init(void);
 uint8_t SI7021_GetTempature(float* tempature);
 uint8_t SI7021_GetHumidity(uint8_t* humidity);
+uint8_t SI7021_StartMeasurement(void);
+uint8_t SI7021_PollMeasurement(float *temperature, float *humidity);
+uint8_t SI7021_Measure(float *temperature, float *humidity);
 /**
  * @}
  */
@@ -8,6 +8,7 @@
  *              1. Delay functions
  *              2. Serialport on UART1. Functions from stdio.h are avaliable.
  *              3. Real time clock functions.
+ *              4. Core clock cycle counter.
  * @note
  *          Minimum version of header file:
  *              2.0.0
@@ -194,6 +195,19 @@ void UTILS_InitDelay()
   fac_ms = fac_us * 1000.0f;
 }
 
+/**
+ * @brief Start the DWT cycle counter, see @ref UTILS_GetCycleCount.
+ * @note A running counter is left untouched, so it is safe to call from every driver.
+ */
+void UTILS_InitCycleCounter()
+{
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  if (DWT->CTRL & DWT_CTRL_CYCCNTENA_Msk)
+    return;
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
 /**
  * @brief Delay in microsecond.
  * @param time  Time in us.
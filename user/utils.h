@@ -8,6 +8,7 @@
  *              1. Delay functions
  *              2. Serialport on UART1. Functions from stdio.h are avaliable.
  *              3. Real time clock functions.
+ *              4. Core clock cycle counter.
  * @note
  *          Minimum version of source file:
  *              2.0.0
@@ -69,12 +70,18 @@ extern uint32_t AhbClock;
 extern uint32_t Apb1Clock;
 extern uint32_t Apb2Clock;
 
+/**
+ * @brief Core clock(HCLK) cycles counted by DWT, wraps around. Call UTILS_InitCycleCounter first.
+ */
+#define UTILS_GetCycleCount()      (DWT->CYCCNT)
+
 extern uint8_t USART_RX_BUF[UTILS_RECEIEVE_LENTH]; //ջ,USART_REC_LENֽ.ĩֽΪз 
 extern uint16_t USART_RX_STA; //״̬
 
 void UTILS_UpdateClocks(void);
 void UTILS_InitUart(uint32_t baudrate);
 void UTILS_InitDelay(void);
+void UTILS_InitCycleCounter(void);
 void UTILS_InitDateTime(const char* dateTimeString, FunctionalState forceInitialize);
 void UTILS_GetDateTime(UTILS_DateTimeTypeDef* dateTime);
 int32_t UTILS_GetDateTimeString(char* dateTimeString);